@@ -48,6 +48,17 @@ const std::string NFC_EXECUTION_ENVIRONMENT_HOST = "host";
 const std::string NFC_EXECUTION_ENVIRONMENT_ESE = "eSE";
 const std::string NFC_EXECUTION_ENVIRONMENT_UICC = "SIM";
 
+// returned by the agents not supporting static responses, the value of ERR_UNIMPLEMENT of the service
+constexpr int ERR_STATIC_RESPONSE_UNIMPLEMENTED = -4;
+
+// a command the service answers without forwarding it to the application:
+// (command & mask_) == value_ over the first mask_.size() bytes is answered by response_
+struct StaticApduResponse {
+    std::vector<unsigned char> mask_;
+    std::vector<unsigned char> value_;
+    std::vector<unsigned char> response_;
+};
+
 class CardEmulationServiceInfoLite;
 class ICardEmulationAgent : public OHOS::IRemoteBroker {
 public:
@@ -101,6 +112,25 @@ public:
                                   const OHOS::AppExecFwk::ElementName& elementName,
                                   std::vector<std::string> aids,
                                   std::string type) = 0;
+    /**
+     * brief: add aids for service, with the commands answered by the nfc service
+     * parameter:
+     *   userId -- user id
+     *   elementName -- the card emulation service name
+     *   aids -- aids
+     *   type -- service type
+     *   responses -- static responses of the type, replacing the previous ones
+     * return: 0 -- succeeded, not 0 -- error code, ERR_STATIC_RESPONSE_UNIMPLEMENTED by default
+     */
+    virtual int AddAidsForService(int userId,
+                                  const OHOS::AppExecFwk::ElementName& elementName,
+                                  std::vector<std::string> aids,
+                                  std::string type,
+                                  std::vector<StaticApduResponse> responses)
+    {
+        // the agents of older versions do not answer static responses
+        return ERR_STATIC_RESPONSE_UNIMPLEMENTED;
+    }
     /**
      * brief: remove aids for service
      * parameter:
@@ -24,6 +24,8 @@ namespace nfc::sdk::cardemulation {
 enum CardEmulationState { ST_OK, ST_NFC_UNSUPPORTED, ST_NFC_TURNED_OFF };
 using ApduCommandHandler = std::function<std::vector<unsigned char>(const std::vector<unsigned char>&)>;
 using DeactiveEventHandler = std::function<void(int)>;
+// @see icard_emulation_agent.h
+struct StaticApduResponse;
 
 class IHostCardEmulation {
 public:
@@ -36,6 +38,22 @@ public:
      * return: 0 -- succeeded, not 0 -- error code
      */
     virtual bool AddAidsForService(const std::vector<std::string>& aids, std::string cardemulationServiceType) = 0;
+    /**
+     * brief: add aids for the card emulation service, the commands matching the static responses
+     *   are answered by the nfc service without calling the apdu command handler
+     * parameter:
+     *   aids -- aids
+     *   cardemulationServiceType -- service type
+     *   responses -- static responses, limited in count and size
+     * return: 0 -- succeeded, not 0 -- error code
+     * note: implementations without static responses fail, nothing is registered
+     */
+    virtual bool AddAidsForService(const std::vector<std::string>& aids,
+                                   std::string cardemulationServiceType,
+                                   const std::vector<StaticApduResponse>& responses)
+    {
+        return false;
+    }
     /**
      * brief: remove aids for the card emulation service by service type
      * parameter: 
@@ -25,11 +25,20 @@ namespace nfc::sdk::cardemulation {
 enum CardEmulationState { ST_OK, ST_NFC_UNSUPPORTED, ST_NFC_TURNED_OFF };
 using ApduCommandHandler = std::function<std::vector<unsigned char>(const std::vector<unsigned char>&)>;
 using DeactiveEventHandler = std::function<void(int)>;
+// @see icard_emulation_agent.h
+struct StaticApduResponse;
 
 class IHostCardEmulation {
 public:
     virtual ~IHostCardEmulation() = default;
     virtual bool AddAidsForService(const std::vector<std::string>& aids, std::string cardemulationServiceType) = 0;
+    virtual bool AddAidsForService(const std::vector<std::string>& aids,
+                                   std::string cardemulationServiceType,
+                                   const std::vector<StaticApduResponse>& responses)
+    {
+        // implementations without static responses fail, nothing is registered
+        return false;
+    }
     virtual bool RemoveAidsForService(std::string cardemulationServiceType) = 0;
     virtual bool SetApduCommandCallback(ApduCommandHandler handler) = 0;
     virtual bool SetDeactiveEventCallback(DeactiveEventHandler handler) = 0;
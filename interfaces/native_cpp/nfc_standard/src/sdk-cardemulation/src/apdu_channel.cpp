@@ -107,8 +107,10 @@ void ApduChannelProxy::Send(std::unique_ptr<Msg> msg)
     MessageOption option(MessageOption::TF_SYNC);
 
     data.WriteInterfaceToken(IApduChannel::Token);
-    data.WriteParcelable(msg.release());
+    data.WriteParcelable(msg.get());
     int rv = remote->SendRequest(code, data, reply, option);
+    // the message has been marshalled into the parcel
+    MsgPool::Recycle(std::move(msg));
     if (rv == 0 && reply.ReadInt32() == 0) {
         // succeeded
         return;
@@ -188,11 +190,18 @@ int Msg::Arg2() const
     return arg2_;
 }
 
-std::vector<unsigned char> Msg::GetData() const
+const std::vector<unsigned char>& Msg::GetData() const
 {
     return data_;
 }
 
+std::vector<unsigned char> Msg::TakeData()
+{
+    std::vector<unsigned char> data;
+    data.swap(data_);
+    return data;
+}
+
 OHOS::sptr<ApduChannelProxy> Msg::GetSource() const
 {
     DebugLog("Get Source_ pointer: %p\n", source_.GetRefPtr());
@@ -224,9 +233,18 @@ void Msg::SetArg2(int arg)
     arg2_ = arg;
 }
 
-void Msg::SetData(const std::vector<unsigned char>& data)
+void Msg::SetData(std::vector<unsigned char> data)
+{
+    data_ = std::move(data);
+}
+
+void Msg::SetData(const unsigned char* data, size_t len)
 {
-    data_ = data;
+    if (data == nullptr) {
+        data_.clear();
+        return;
+    }
+    data_.assign(data, data + len);
 }
 
 void Msg::SetSource(const OHOS::sptr<OHOS::IRemoteObject>& src)
@@ -257,7 +275,7 @@ bool Msg::ReadFromParcel(OHOS::Parcel& parcel)
 }
 Msg* Msg::Unmarshalling(OHOS::Parcel& parcel) 
 {
-    auto msg = std::make_unique<Msg>(0, 0, 0);
+    auto msg = MsgPool::Obtain(0, 0, 0);
     if (msg && msg->ReadFromParcel(parcel)) {
         return msg.release();
     }
@@ -283,6 +301,50 @@ void Msg::Move(Msg&& msg)
     source_ = std::move(msg.source_);
 }
 
+void Msg::Reset(int id, int arg1, int arg2)
+{
+    id_ = id;
+    arg1_ = arg1;
+    arg2_ = arg2;
+    // keeps the capacity of the buffer
+    data_.clear();
+    source_ = nullptr;
+}
+
+// an extended length apdu keeps its buffer out of the pool
+static constexpr size_t MAX_POOLED_MSG_COUNT = 8;
+static constexpr size_t MAX_POOLED_DATA_CAPACITY = 1024;
+std::mutex MsgPool::mu_;
+std::vector<std::unique_ptr<Msg>> MsgPool::pool_;
+std::unique_ptr<Msg> MsgPool::Obtain(int id, int arg1, int arg2)
+{
+    std::unique_ptr<Msg> msg;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (!pool_.empty()) {
+            msg = std::move(pool_.back());
+            pool_.pop_back();
+        }
+    }
+    if (!msg) {
+        return std::make_unique<Msg>(id, arg1, arg2);
+    }
+    msg->Reset(id, arg1, arg2);
+    return msg;
+}
+void MsgPool::Recycle(std::unique_ptr<Msg> msg)
+{
+    if (!msg || msg->data_.capacity() > MAX_POOLED_DATA_CAPACITY) {
+        return;
+    }
+    // releases the remote object outside the lock
+    msg->Reset(0, 0, 0);
+    std::lock_guard<std::mutex> lk(mu_);
+    if (pool_.size() < MAX_POOLED_MSG_COUNT) {
+        pool_.push_back(std::move(msg));
+    }
+}
+
 ApduChannelStub::~ApduChannelStub()
 {
     Stop();
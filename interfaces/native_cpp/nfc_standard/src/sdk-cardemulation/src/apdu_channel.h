@@ -24,6 +24,7 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "event_handler.h"
 #include "iremote_broker.h"
@@ -66,14 +67,18 @@ public:
     int Id() const;
     int Arg1() const;
     int Arg2() const;
-    std::vector<unsigned char> GetData() const;
+    const std::vector<unsigned char>& GetData() const;
+    // moves the payload out of the message, the message keeps no data
+    std::vector<unsigned char> TakeData();
     OHOS::sptr<ApduChannelProxy> GetSource() const;
     bool EqualsReplyRemoteObject(const OHOS::sptr<OHOS::IRemoteObject>& ro) const;
 
     void SetId(int id);
     void SetArg1(int arg);
     void SetArg2(int arg);
-    void SetData(const std::vector<unsigned char>& data);
+    void SetData(std::vector<unsigned char> data);
+    // copies into the buffer kept by the message, no allocation when it is large enough
+    void SetData(const unsigned char* data, size_t len);
     void SetSource(const OHOS::sptr<OHOS::IRemoteObject>& source);
 
     bool Marshalling(OHOS::Parcel& parcel) const override;
@@ -81,8 +86,10 @@ public:
     static Msg* Unmarshalling(OHOS::Parcel& parcel);
 
 private:
+    friend class MsgPool;
     void Copy(const Msg& msg);
     void Move(Msg&& msg);
+    void Reset(int id, int arg1, int arg2);
 
 private:
     int id_;
@@ -93,6 +100,20 @@ private:
     OHOS::sptr<OHOS::IRemoteObject> source_;
 };
 
+/*
+ * Reuses the messages of the apdu path, so that a command or response apdu
+ * does not allocate a message and its data buffer per transfer.
+ */
+class MsgPool final {
+public:
+    static std::unique_ptr<Msg> Obtain(int id, int arg1, int arg2);
+    static void Recycle(std::unique_ptr<Msg> msg);
+
+private:
+    static std::mutex mu_;
+    static std::vector<std::unique_ptr<Msg>> pool_;
+};
+
 class ApduEventHandler : public OHOS::AppExecFwk::EventHandler {
 public:
     ApduEventHandler(const std::shared_ptr<OHOS::AppExecFwk::EventRunner>& runner,
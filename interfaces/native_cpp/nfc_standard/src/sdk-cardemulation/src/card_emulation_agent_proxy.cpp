@@ -119,6 +119,15 @@ int CardEmulationAgentProxy::AddAidsForService(int userId,
                                                const OHOS::AppExecFwk::ElementName& serviceName,
                                                std::vector<std::string> aids,
                                                std::string type)
+{
+    return AddAidsForService(userId, serviceName, std::move(aids), std::move(type), {});
+}
+
+int CardEmulationAgentProxy::AddAidsForService(int userId,
+                                               const OHOS::AppExecFwk::ElementName& serviceName,
+                                               std::vector<std::string> aids,
+                                               std::string type,
+                                               std::vector<StaticApduResponse> responses)
 {
     auto ro = Remote();
     if (!ro) {
@@ -136,7 +145,13 @@ int CardEmulationAgentProxy::AddAidsForService(int userId,
     data.WriteParcelable(&serviceName);
     data.WriteStringVector(aids);
     data.WriteString(type);
-    DebugLog("write apdu channel");
+    // appended to the body, a service without static responses does not read them
+    data.WriteUint32(static_cast<uint32_t>(responses.size()));
+    for (auto& response : responses) {
+        data.WriteUInt8Vector(response.mask_);
+        data.WriteUInt8Vector(response.value_);
+        data.WriteUInt8Vector(response.response_);
+    }
 
     DebugLog("send request %d", CODE_ADD_AIDS_FOR_SERVICE);
     auto rv = ro->SendRequest(CODE_ADD_AIDS_FOR_SERVICE, data, reply, option);
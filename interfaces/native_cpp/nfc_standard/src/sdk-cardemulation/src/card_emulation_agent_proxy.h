@@ -43,6 +43,11 @@ public:
                           const OHOS::AppExecFwk::ElementName& serviceName,
                           std::vector<std::string> aids,
                           std::string type) override;
+    int AddAidsForService(int userId,
+                          const OHOS::AppExecFwk::ElementName& serviceName,
+                          std::vector<std::string> aids,
+                          std::string type,
+                          std::vector<StaticApduResponse> responses) override;
     int RemoveAidsForService(int userId, const OHOS::AppExecFwk::ElementName& serviceName, std::string type) override;
     int RegisterOffHostService(int userId,
                                const OHOS::AppExecFwk::ElementName& serviceName,
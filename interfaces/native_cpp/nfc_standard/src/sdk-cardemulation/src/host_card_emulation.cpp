@@ -31,6 +31,13 @@ HostCardEmulation::HostCardEmulation(const OHOS::AppExecFwk::ElementName& servic
 HostCardEmulation::~HostCardEmulation() = default;
 
 bool HostCardEmulation::AddAidsForService(const std::vector<std::string>& aids, std::string cardemulationServiceType)
+{
+    return AddAidsForService(aids, std::move(cardemulationServiceType), {});
+}
+
+bool HostCardEmulation::AddAidsForService(const std::vector<std::string>& aids,
+                                          std::string cardemulationServiceType,
+                                          const std::vector<StaticApduResponse>& responses)
 {
     auto ces = ces_.promote();
     if (!ces) {
@@ -41,7 +48,7 @@ bool HostCardEmulation::AddAidsForService(const std::vector<std::string>& aids,
     RegisterRemoteObject(ces, userId);
     DebugLog("userId: %d, ces pointer: %p", userId, ces.GetRefPtr());
 
-    auto rv = ces->AddAidsForService(userId, GetName(), aids, std::move(cardemulationServiceType));
+    auto rv = ces->AddAidsForService(userId, GetName(), aids, std::move(cardemulationServiceType), responses);
     DebugLog("service return: %d", rv);
     return rv == NFC_SUCCESS;
 }
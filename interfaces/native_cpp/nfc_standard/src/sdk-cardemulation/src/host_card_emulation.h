@@ -29,6 +29,9 @@ public:
     HostCardEmulation(const OHOS::AppExecFwk::ElementName& serviceName, const OHOS::wptr<ICardEmulationAgent>& ces);
     ~HostCardEmulation() override;
     bool AddAidsForService(const std::vector<std::string>& aids, std::string cardemulationServiceType) override;
+    bool AddAidsForService(const std::vector<std::string>& aids,
+                           std::string cardemulationServiceType,
+                           const std::vector<StaticApduResponse>& responses) override;
     bool RemoveAidsForService(std::string cardemulationServiceType) override;
     bool SetApduCommandCallback(ApduCommandHandler handler) override;
     bool SetDeactiveEventCallback(DeactiveEventHandler handler) override;
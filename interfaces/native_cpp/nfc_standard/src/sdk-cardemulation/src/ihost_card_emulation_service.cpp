@@ -55,13 +55,14 @@ void IHostCardEmulationService::CreateMessenger()
                         ErrorLog("service channel is nullptr.");
                         return;
                     }
-                    auto resp = std::make_unique<Msg>(RESPONSE_APDU, 0, 0);
+                    auto resp = MsgPool::Obtain(RESPONSE_APDU, 0, 0);
                     resp->SetData(HandleApdu(msg->GetData()));
                     resp->SetSource(RemoteObjectPool::GetRemoteObject(channel_->AsObject()));
                     DebugLog("CMD_APDU service channel: %p, client channel: %p",
                              serviceChannel_.GetRefPtr(),
                              channel_.GetRefPtr());
                     serviceChannel_->Send(std::move(resp));
+                    MsgPool::Recycle(std::move(msg));
                     break;
                 }
                 case RESPONSE_APDU:  // APDU 响应
@@ -104,7 +105,7 @@ void IHostCardEmulationService::CreateMessenger()
 void IHostCardEmulationService::SendApduResponse(std::vector<unsigned char> data)
 {
     // IHostCardEmulationService 主动发送响应
-    auto resp = std::make_unique<Msg>(RESPONSE_APDU, 0, 0);
+    auto resp = MsgPool::Obtain(RESPONSE_APDU, 0, 0);
     resp->SetData(std::move(data));
     if (channel_) {
         resp->SetSource(RemoteObjectPool::GetRemoteObject(channel_->AsObject()));
@@ -114,7 +115,7 @@ void IHostCardEmulationService::SendApduResponse(std::vector<unsigned char> data
 void IHostCardEmulationService::NotifyUnhandled()
 {
     // IHostCardEmulationService 主动发送通知
-    auto resp = std::make_unique<Msg>(UNHANDLED, 0, 0);
+    auto resp = MsgPool::Obtain(UNHANDLED, 0, 0);
     if (channel_) {
         resp->SetSource(RemoteObjectPool::GetRemoteObject(channel_->AsObject()));
         channel_->Send(std::move(resp));
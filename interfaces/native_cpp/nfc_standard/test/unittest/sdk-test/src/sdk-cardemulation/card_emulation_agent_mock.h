@@ -55,6 +55,12 @@ public:
                      const OHOS::AppExecFwk::ElementName& serviceName,
                      std::vector<std::string> aids,
                      std::string type));
+    MOCK_METHOD5(AddAidsForService,
+                 int(int userId,
+                     const OHOS::AppExecFwk::ElementName& serviceName,
+                     std::vector<std::string> aids,
+                     std::string type,
+                     std::vector<StaticApduResponse> responses));
     MOCK_METHOD3(RemoveAidsForService,
                  int(int userId, const OHOS::AppExecFwk::ElementName& serviceName, std::string type));
     MOCK_METHOD3(RegisterOffHostService,
@@ -92,6 +98,12 @@ public:
                      const OHOS::AppExecFwk::ElementName& serviceName,
                      std::vector<std::string> aids,
                      std::string type));
+    MOCK_METHOD5(AddAidsForService,
+                 int(int userId,
+                     const OHOS::AppExecFwk::ElementName& serviceName,
+                     std::vector<std::string> aids,
+                     std::string type,
+                     std::vector<StaticApduResponse> responses));
 
     MOCK_METHOD3(RemoveAidsForService,
                  int(int userId, const OHOS::AppExecFwk::ElementName& serviceName, std::string type));
@@ -55,7 +55,7 @@ TEST(HostCardEmulation, AddAidsForService)
     auto test = [&presetResult](bool result, int serviceRet, const OHOS::AppExecFwk::ElementName& serviceName) {
         auto cea = OHOS::sptr<MockCardEmulationAgentProxy>(new MockCardEmulationAgentProxy(nullptr));
 
-        EXPECT_CALL(*cea, AddAidsForService(_, _, _, _)).WillOnce(Return(serviceRet));
+        EXPECT_CALL(*cea, AddAidsForService(_, _, _, _, _)).WillOnce(Return(serviceRet));
         auto hce = std::make_shared<HostCardEmulation>(serviceName, cea);
 
         EXPECT_EQ(hce->AddAidsForService(presetResult, CARDEMULATION_SERVICE_TYPE_SECURE), result);
@@ -171,4 +171,40 @@ TEST(HostCardEmulation, OnConnect)
     auto hces = std::make_shared<HostCardEmulation>(serviceName, cea);
     EXPECT_TRUE(hces->OnConnect({}));
 }
+// an implementation built before the static responses
+class LegacyHostCardEmulation : public IHostCardEmulation {
+public:
+    bool AddAidsForService(const std::vector<std::string>& aids, std::string cardemulationServiceType) override
+    {
+        ++added_;
+        return true;
+    }
+    bool RemoveAidsForService(std::string cardemulationServiceType) override
+    {
+        return true;
+    }
+    bool SetApduCommandCallback(ApduCommandHandler handler) override
+    {
+        return true;
+    }
+    bool SetDeactiveEventCallback(DeactiveEventHandler handler) override
+    {
+        return true;
+    }
+    int added_{0};
+};
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the static responses are refused by the implementations not supporting them
+*/
+TEST(HostCardEmulation, AddAidsForService_StaticResponsesUnsupported)
+{
+    LegacyHostCardEmulation legacy;
+    IHostCardEmulation& hce = legacy;
+    std::vector<StaticApduResponse> responses = {StaticApduResponse{{0xFF}, {0x80}, {0x90, 0x00}}};
+    EXPECT_FALSE(hce.AddAidsForService({"A0000000031010"}, CARDEMULATION_SERVICE_TYPE_NORMAL, responses));
+    EXPECT_EQ(legacy.added_, 0);
+}
 }
@@ -15,6 +15,7 @@
 #ifndef I_NFC_SERVICE_H
 #define I_NFC_SERVICE_H
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -44,11 +45,10 @@ enum NfcServiceEvent {
     MSG_RF_FIELD_ACTIVATED,
     MSG_RF_FIELD_DEACTIVATED,  // 5
     MSG_RESUME_POLLING,
-    MSG_REGISTER_T3T_IDENTIFIER,
-    MSG_DEREGISTER_T3T_IDENTIFIER,
+    MSG_UPDATE_T3T_IDENTIFIERS,
     MSG_TAG_DEBOUNCE,
-    MSG_APPLY_SCREEN_STATE,  // 10
-    MSG_TRANSACTION_EVENT,
+    MSG_APPLY_SCREEN_STATE,
+    MSG_TRANSACTION_EVENT,  // 10
     MSG_PREFERRED_PAYMENT_CHANGED,
     MSG_EVENT_RESUME_POLLING,
     MSG_TOAST_DEBOUNCE_EVENT
@@ -58,6 +58,7 @@ struct OffHostTransactionData {
     std::string aid_{""};
     std::string data_{""};
     std::string seName_{""};
+    std::chrono::steady_clock::time_point receivedTime_{};
 };
 
 class INfcService {
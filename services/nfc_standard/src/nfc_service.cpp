@@ -15,6 +15,7 @@
 #include "nfc_service.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <sstream>
 #include <thread>
 
@@ -68,6 +69,8 @@ const std::string ACTION_PACKAGE_ADDED = "ohos.intent.action.PACKAGE_ADDED";
 const std::string ACTION_EXTERNAL_APPLICATIONS_AVAILABLE = "ohos.intent.action.EXTERNAL_APPLICATIONS_AVAILABLE";
 const std::string ACTION_EXTERNAL_APPLICATIONS_UNAVAILABLE = "ohos.intent.action.EXTERNAL_APPLICATIONS_UNAVAILABLE";
 const std::string ACTION_SHUTDOWN = "ohos.intent.action.ACTION_SHUTDOWN";
+// the SE service re-read the access rules of an SE
+const std::string ACTION_SE_ACCESS_RULES_CHANGED = "ohos.nfc.action.SE_ACCESS_RULES_CHANGED";
 // Package Common Event Permission
 const std::string ACTION_PACKAGE_PERMISSION = "package";
 
@@ -182,6 +185,8 @@ void NfcService::PackageChangeReceive::OnReceiveEvent(const CommonEventData& dat
         action.compare(ACTION_EXTERNAL_APPLICATIONS_AVAILABLE) == 0 ||
         action.compare(ACTION_EXTERNAL_APPLICATIONS_UNAVAILABLE) == 0) {
         mNfcService_.lock()->UpdatePackageCache();
+    } else if (action.compare(ACTION_SE_ACCESS_RULES_CHANGED) == 0) {
+        mNfcService_.lock()->ClearNfcEventAllowedPackages();
     } else if (action.compare(ACTION_SHUTDOWN) == 0) {
         DebugLog("Device is shutting down.");
         if (mNfcService_.lock()->IsNfcEnabled()) {
@@ -233,11 +238,17 @@ void NfcService::OnHostCardEmulationDataReceived(int tech, std::string& data)
 
 void NfcService::OnOffHostTransactionEvent(std::string& aid, std::string& data, std::string& seName)
 {
-    std::shared_ptr<OffHostTransactionData> dataObj = std::make_shared<OffHostTransactionData>();
-    dataObj->aid_ = aid;
-    dataObj->data_ = data;
-    dataObj->seName_ = seName;
-    mHandler_->SendEvent<OffHostTransactionData>(MSG_TRANSACTION_EVENT, dataObj);
+    OffHostTransactionData transaction;
+    transaction.aid_ = aid;
+    transaction.data_ = data;
+    transaction.seName_ = seName;
+    transaction.receivedTime_ = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mTransactionMtx_);
+    mPendingTransactions_.push_back(std::move(transaction));
+    if (mPendingTransactions_.size() == 1) {
+        // sent at once, the events queued until the handler runs go in the same batch
+        mHandler_->SendEvent(MSG_TRANSACTION_EVENT);
+    }
 }
 
 void NfcService::OnEeUpdate()
@@ -753,6 +764,14 @@ bool NfcService::CommitRouting()
     return mHandler_->SendEvent(MSG_COMMIT_ROUTING);
 }
 
+bool NfcService::PostTask(std::function<void()> task, int64_t delayMs)
+{
+    if (!mHandler_) {
+        return false;
+    }
+    return mHandler_->PostTask(task, delayMs);
+}
+
 int NfcService::GetRemainRoutingTableSize()
 {
     return mDeviceHost_->GetRemainRoutingTableSize();
@@ -772,7 +791,9 @@ void NfcService::RegisterT3tIdentifier(std::string& systemCode, std::string& nfc
     DebugLog("request to register LF_T3T_IDENTIFIER");
 
     std::string t3tIdentifier = GetT3tIdentifierBytes(systemCode, nfcId2, t3tPmm);
-    mHandler_->SendEvent<std::string>(MSG_REGISTER_T3T_IDENTIFIER, std::make_shared<std::string>(t3tIdentifier));
+    std::lock_guard<std::mutex> lock(mT3tMtx_);
+    mT3tIdentifiers_.insert(t3tIdentifier);
+    ScheduleT3tIdentifiersUpdate();
 }
 
 void NfcService::DeregisterT3tIdentifier(std::string& systemCode, std::string& nfcId2, std::string& t3tPmm)
@@ -780,12 +801,43 @@ void NfcService::DeregisterT3tIdentifier(std::string& systemCode, std::string& n
     DebugLog("request to deregister LF_T3T_IDENTIFIER");
 
     std::string t3tIdentifier = GetT3tIdentifierBytes(systemCode, nfcId2, t3tPmm);
-    mHandler_->SendEvent<std::string>(MSG_DEREGISTER_T3T_IDENTIFIER, std::make_shared<std::string>(t3tIdentifier));
+    std::lock_guard<std::mutex> lock(mT3tMtx_);
+    mT3tIdentifiers_.erase(t3tIdentifier);
+    ScheduleT3tIdentifiersUpdate();
+}
+
+void NfcService::UpdateT3tIdentifiers(const std::vector<std::string>& t3tIdentifiers)
+{
+    DebugLog("request to update LF_T3T_IDENTIFIERs, count: %zu", t3tIdentifiers.size());
+
+    std::lock_guard<std::mutex> lock(mT3tMtx_);
+    mT3tIdentifiers_ = std::set<std::string>(t3tIdentifiers.begin(), t3tIdentifiers.end());
+    ScheduleT3tIdentifiersUpdate();
+}
+
+// under mT3tMtx_, the requests queued before the handler runs share one update
+void NfcService::ScheduleT3tIdentifiersUpdate()
+{
+    if (!mT3tUpdatePending_) {
+        mT3tUpdatePending_ = true;
+        mHandler_->SendEvent(MSG_UPDATE_T3T_IDENTIFIERS);
+    }
+}
+
+std::vector<std::string> NfcService::TakeT3tIdentifiers()
+{
+    std::lock_guard<std::mutex> lock(mT3tMtx_);
+    mT3tUpdatePending_ = false;
+    return std::vector<std::string>(mT3tIdentifiers_.begin(), mT3tIdentifiers_.end());
 }
 
 void NfcService::ClearT3tIdentifiersCache()
 {
     DebugLog("clear T3t Identifiers Cache");
+    {
+        std::lock_guard<std::mutex> lock(mT3tMtx_);
+        mT3tIdentifiers_.clear();
+    }
     mDeviceHost_->ClearT3tIdentifiersCache();
 }
 
@@ -805,6 +857,12 @@ bool NfcService::DumpRoutingTable(int fd)
 {
     if (mDeviceHost_) {
         mDeviceHost_->Dump(fd);
+#ifdef _NFC_SERVICE_HCE_
+        if (mCardEmulationManager_) {
+            mCardEmulationManager_->Dump(fd);
+        }
+#endif  // _NFC_SERVICE_HCE_
+        dprintf(fd, "off host transaction latency: %s\n", GetOffHostTransactionLatency().ToString().c_str());
         return true;
     }
     return false;
@@ -828,17 +886,69 @@ void NfcService::SendNfcEeAccessProtectedBroadcast(std::shared_ptr<AAFwk::Want>
 #endif  // _NFC_SERVICE_READER_
 }
 
-void NfcService::SendOffHostTransactionEvent(std::string aid, std::string data, std::string readerByteArray)
+std::vector<std::string> NfcService::GetNfcEventAllowedPackages(const std::string& seName, const std::string& aid)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::pair<std::string, std::string> key(seName, aid);
+    auto it = mNfcEventAllowedPackages_.find(key);
+    if (it != mNfcEventAllowedPackages_.end()) {
+        return it->second;
+    }
+    if (mNfcEventAllowedPackages_.size() >= MAX_NFC_EVENT_ALLOWED_AIDS) {
+        mNfcEventAllowedPackages_.clear();
+    }
+    std::vector<std::string> packages = GetSEAccessAllowedPackages();
+    mNfcEventAllowedPackages_[key] = packages;
+    return packages;
+}
+
+void NfcService::ClearNfcEventAllowedPackages()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    mNfcEventAllowedPackages_.clear();
+}
+
+void NfcService::SendOffHostTransactionEvent(std::string aid, std::string data, std::string seName)
 {
-    InfoLog("Send Off Host Transaction Event. Aid Is (%s). Data Length Is (%u). Reader Byte Array Size Is (%u)",
+    InfoLog("Send Off Host Transaction Event. Aid Is (%s). Data Length Is (%u). SE Is (%s)",
             aid.c_str(),
             data.length(),
-            readerByteArray.length());
-    if (!IsSEServiceAvailable() || mNfcEventInstalledPackages_.empty()) {
+            seName.c_str());
+    std::vector<std::string> packages = GetNfcEventAllowedPackages(seName, aid);
+    if (packages.empty()) {
         return;
     }
 }
 
+void NfcService::SendOffHostTransactionEvents()
+{
+    std::vector<OffHostTransactionData> transactions;
+    {
+        std::lock_guard<std::mutex> lock(mTransactionMtx_);
+        transactions.swap(mPendingTransactions_);
+    }
+    if (transactions.empty()) {
+        return;
+    }
+    InfoLog("Send Off Host Transaction Events. Batch Size Is (%zu)", transactions.size());
+    for (OffHostTransactionData& transaction : transactions) {
+        SendOffHostTransactionEvent(transaction.aid_, transaction.data_, transaction.seName_);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mTransactionMtx_);
+    for (OffHostTransactionData& transaction : transactions) {
+        mTransactionLatency_.Add(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - transaction.receivedTime_).count());
+    }
+}
+
+LatencyHistogram NfcService::GetOffHostTransactionLatency()
+{
+    std::lock_guard<std::mutex> lock(mTransactionMtx_);
+    return mTransactionLatency_;
+}
+
 bool NfcService::IsSEServiceAvailable()
 {
     DebugLog("IsSEServiceAvailable");
@@ -875,6 +985,7 @@ void NfcService::UpdatePackageCache()
     std::lock_guard<std::mutex> lock(mtx_);
     mNfcEventInstalledPackages_.clear();
     mNfcPreferredPaymentChangedInstalledPackages_.clear();
+    mNfcEventAllowedPackages_.clear();
 }
 
 void NfcService::OnPreferredPaymentChanged(int reason)
@@ -983,6 +1094,7 @@ bool NfcService::Initialize()
     pkMatchingSkills.AddEvent(ACTION_EXTERNAL_APPLICATIONS_AVAILABLE);
     pkMatchingSkills.AddEvent(ACTION_EXTERNAL_APPLICATIONS_UNAVAILABLE);
     pkMatchingSkills.AddEvent(ACTION_SHUTDOWN);
+    pkMatchingSkills.AddEvent(ACTION_SE_ACCESS_RULES_CHANGED);
     CommonEventSubscribeInfo pkSubscribeInfo(pkMatchingSkills);
     mPkgReceiver_ = std::make_shared<PackageChangeReceive>(shared_from_this(), pkSubscribeInfo);
     CommonEventManager::SubscribeCommonEvent(mPkgReceiver_);
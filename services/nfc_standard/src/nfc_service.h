@@ -17,15 +17,18 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <future>
 #include <map>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "idevice_host.h"
 #include "infc_service.h"
 #include "refbase.h"
+#include "utils/hce_latency_tracer.h"
 
 #ifdef _NFC_SERVICE_HCE_
 #include "icard_emulation_device_host.h"
@@ -143,12 +146,26 @@ public:
     void RegisterT3tIdentifier(std::string& systemCode, std::string& nfcId2, std::string& t3tPmm);
     void DeregisterT3tIdentifier(std::string& systemCode, std::string& nfcId2, std::string& t3tPmm);
     void ClearT3tIdentifiersCache();
+    // replaces all the registered identifiers, hex of system code + nfcid2 + pmm
+    void UpdateT3tIdentifiers(const std::vector<std::string>& t3tIdentifiers);
     int GetLfT3tMax();
     bool SendData(std::vector<unsigned char> data) override;
     bool DumpRoutingTable(int fd) override;
+    // the card emulation runs its deferred work on the handler, serialized with the routing commits
+    bool PostTask(std::function<void()> task, int64_t delayMs) override;
     std::vector<std::string> GetSEAccessAllowedPackages();
+    /**
+     * @brief The packages allowed to receive the NFC events of the SE application, cached per SE and AID until the
+     * access rules of an SE or the installed packages change.
+     */
+    std::vector<std::string> GetNfcEventAllowedPackages(const std::string& seName, const std::string& aid);
+    void ClearNfcEventAllowedPackages();
     void SendNfcEeAccessProtectedBroadcast(std::shared_ptr<AAFwk::Want> intent);
-    void SendOffHostTransactionEvent(std::string aid, std::string data, std::string readerByteArray);
+    void SendOffHostTransactionEvent(std::string aid, std::string data, std::string seName);
+    // sends the transaction events queued since the previous batch
+    void SendOffHostTransactionEvents();
+    // from the event of the SE to the broadcast
+    LatencyHistogram GetOffHostTransactionLatency();
     bool IsSEServiceAvailable();
     void SendPreferredPaymentChangedEvent(std::shared_ptr<AAFwk::Want> intent);
 
@@ -220,6 +237,9 @@ private:
     bool DeviceSupportsNfcSecure() const;
     bool SetNfcSecure(bool enable);
     bool IsNfcSecureEnabled();
+    // T3T identifiers
+    void ScheduleT3tIdentifiersUpdate();
+    std::vector<std::string> TakeT3tIdentifiers();
 
 private:
     /**
@@ -246,6 +266,8 @@ private:
     static constexpr const int INIT_WATCHDOG_MS = 90000;
     // Time to wait for routing to be applied before watchdog goes off
     static constexpr const int ROUTING_WATCHDOG_MS = 10000;
+    // the allowed packages are cached for the AIDs of this many SE applications at most
+    static constexpr const size_t MAX_NFC_EVENT_ALLOWED_AIDS = 64;
     // Timeout to re-apply routing if a tag was present and we postponed it
     static constexpr const int APPLY_ROUTING_RETRY_TIMEOUT_MS = 5000;
     /**
@@ -298,6 +320,7 @@ private:
     // Metrics
     std::atomic_int mNumTagsDetected_{};
     std::atomic_int mNumHceDetected_{};
+    LatencyHistogram mTransactionLatency_{};
 
     std::unique_ptr<NfcDiscoveryParams> mCurrentDiscoveryParams_;
     std::shared_ptr<ScreenStateHelper> mScreenStateHelper_;
@@ -311,6 +334,15 @@ private:
 
     std::vector<std::string> mNfcEventInstalledPackages_{};
     std::vector<std::string> mNfcPreferredPaymentChangedInstalledPackages_{};
+    // the transaction events waiting for the batch
+    std::mutex mTransactionMtx_{};
+    std::vector<OffHostTransactionData> mPendingTransactions_{};
+    // (SE name, AID) -> the packages allowed to receive the NFC events, under mtx_
+    std::map<std::pair<std::string, std::string>, std::vector<std::string>> mNfcEventAllowedPackages_{};
+    // the T3T identifiers the NFCC should have, applied in one MSG_UPDATE_T3T_IDENTIFIERS
+    std::mutex mT3tMtx_{};
+    std::set<std::string> mT3tIdentifiers_{};
+    bool mT3tUpdatePending_{false};
 
     friend class WatchDog;
     friend class NfcAgentService;
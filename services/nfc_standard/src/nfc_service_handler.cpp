@@ -71,27 +71,11 @@ void NfcServiceHandler::ProcessEvent(const AppExecFwk::InnerEvent::Pointer& even
             deviceHost->RemoveAidRouting(*aid);
             break;
         }
-        case MSG_REGISTER_T3T_IDENTIFIER: {
-            DebugLog("message to register LF_T3T_IDENTIFIER");
+        case MSG_UPDATE_T3T_IDENTIFIERS: {
+            DebugLog("message to update LF_T3T_IDENTIFIERs");
             deviceHost->DisableDiscovery();
 
-            shared_ptr<string> t3tIdentifier = event->GetSharedObject<string>();
-            deviceHost->RegisterT3tIdentifier(*t3tIdentifier);
-
-            auto params = nfcService->GetDiscoveryParameters(nfcService->mScreenState_);
-            bool shouldRestart = nfcService->mCurrentDiscoveryParams_->ShouldEnableDiscovery();
-            deviceHost->EnableDiscovery(params->GetTechMask(),
-                                        params->ShouldEnableReaderMode(),
-                                        params->ShouldEnableHostRouting(),
-                                        shouldRestart);
-            break;
-        }
-        case MSG_DEREGISTER_T3T_IDENTIFIER: {
-            DebugLog("message to deregister LF_T3T_IDENTIFIER");
-            deviceHost->DisableDiscovery();
-
-            shared_ptr<string> t3tIdentifier = event->GetSharedObject<string>();
-            deviceHost->DeregisterT3tIdentifier(*t3tIdentifier);
+            deviceHost->UpdateT3tIdentifiers(nfcService->TakeT3tIdentifiers());
 
             auto params = nfcService->GetDiscoveryParameters(nfcService->mScreenState_);
             bool shouldRestart = nfcService->mCurrentDiscoveryParams_->ShouldEnableDiscovery();
@@ -131,12 +115,12 @@ void NfcServiceHandler::ProcessEvent(const AppExecFwk::InnerEvent::Pointer& even
             break;
         }
         case MSG_TRANSACTION_EVENT: {
-            std::shared_ptr<OffHostTransactionData> data = event->GetSharedObject<OffHostTransactionData>();
+            // one batch of the events coalesced by NfcService::OnOffHostTransactionEvent
             auto cem = mCardEmulationManager_.lock();
             if (cem) {
                 cem->OnOffHostTransaction();
             }
-            nfcService->SendOffHostTransactionEvent(data->aid_, data->data_, data->seName_);
+            nfcService->SendOffHostTransactionEvents();
             break;
         }
         case MSG_PREFERRED_PAYMENT_CHANGED: {
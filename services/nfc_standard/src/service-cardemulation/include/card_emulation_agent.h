@@ -91,6 +91,21 @@ public:
                           const OHOS::AppExecFwk::ElementName& elementName,
                           std::vector<std::string> aids,
                           std::string type) override;
+    /**
+     * brief: add aids for service, with the commands answered by the nfc service
+     * parameter:
+     *   userId -- user id
+     *   elementName -- the card emulation service name
+     *   aids -- aids
+     *   type -- service type
+     *   responses -- static responses of the type
+     * return: 0 -- succeeded, not 0 -- error code
+     */
+    int AddAidsForService(int userId,
+                          const OHOS::AppExecFwk::ElementName& elementName,
+                          std::vector<std::string> aids,
+                          std::string type,
+                          std::vector<StaticApduResponse> responses) override;
     /**
      * brief: remove aids for service
      * parameter:
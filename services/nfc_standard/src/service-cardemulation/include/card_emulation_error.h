@@ -48,6 +48,7 @@ constexpr int ERR_INVALID_EXEUCTION_ENVIRONMENT = ERR_CARD_EMULATION_START + 20;
 constexpr int ERR_INVALID_USERID = ERR_CARD_EMULATION_START + 21;                     // invalid user ID
 constexpr int ERR_INVALID_SERVICE_TYPE = ERR_CARD_EMULATION_START + 22;               // invalid service type
 constexpr int ERR_CONFILICTS_WITH_DEFAULT = ERR_CARD_EMULATION_START + 23;            // confilicts with default(primary service): maybe service type or aid
+constexpr int ERR_INVALID_STATIC_RESPONSE = ERR_CARD_EMULATION_START + 24;            // malformed static responses, or over the size limit
 
 inline bool IS_OK(int err_code)
 {
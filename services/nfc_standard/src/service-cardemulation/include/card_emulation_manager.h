@@ -108,6 +108,13 @@ public:
      * return: void
      */
     void OnSecureNfcToggled();
+    /**
+     * brief: dump the card emulation routing state
+     * parameter:
+     *     fd - file descriptor to write
+     * return: void
+     */
+    void Dump(int fd);
 
 protected:
 private:
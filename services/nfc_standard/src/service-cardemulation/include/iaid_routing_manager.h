@@ -37,6 +37,16 @@ public:
      * return: card emulation service infomations and service types
      */
     virtual std::vector<ServiceInfoTypePair> GetCardEmulationServicesByAid(const std::string& aid) = 0;
+    /**
+     * brief: get the default service of the secure type, notified by the last change
+     * return: card emulation service infomation, nullptr when there is none
+     */
+    virtual std::shared_ptr<CardEmulationServiceInfo> GetPrimaryService() = 0;
+    /**
+     * brief: get the preferred service of the foreground, notified by the last change
+     * return: card emulation service infomation, nullptr when there is none
+     */
+    virtual std::shared_ptr<CardEmulationServiceInfo> GetPreferredService() = 0;
 private:
 };
 }  // namespace OHOS::nfc::cardemulation
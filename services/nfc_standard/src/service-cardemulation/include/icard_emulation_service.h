@@ -32,6 +32,7 @@ class ElementName;
 
 namespace OHOS::nfc::sdk::cardemulation {
 class CardEmulationServiceInfoLite;
+struct StaticApduResponse;
 }
 namespace OHOS::nfc::cardemulation {
 class AidSet;
@@ -116,6 +117,21 @@ public:
                                   const OHOS::AppExecFwk::ElementName& elementName,
                                   const std::string& type,
                                   const std::vector<std::string>& aidSet) = 0;
+    /**
+     * brief: add aids for the card emulation service, with the commands answered without IPC to the service
+     * parameter:
+     *   userId -- user id
+     *   elementName -- card emulation service name
+     *   type -- service type
+     *   aidSet -- aids
+     *   responses -- static responses of the type, replacing the previous ones
+     * return: 0 -- succeeded, not 0 -- error code
+     */
+    virtual int AddAidsForService(int userId,
+                                  const OHOS::AppExecFwk::ElementName& elementName,
+                                  const std::string& type,
+                                  const std::vector<std::string>& aidSet,
+                                  const std::vector<sdk::cardemulation::StaticApduResponse>& responses) = 0;
     /**
      * brief: remove aids for the card emulation service
      * parameter:
@@ -196,6 +212,13 @@ public:
     virtual std::vector<std::unique_ptr<OHOS::nfc::sdk::cardemulation::CardEmulationServiceInfoLite>> GetServicesByType(
         int userId,
         const std::string& type) = 0;
+    /**
+     * brief: dump the aid routing table and the aidsets not routed for lack of capacity
+     * parameter:
+     *   fd -- file descriptor to write
+     * return: void
+     */
+    virtual void Dump(int fd) = 0;
 };
 }  // namespace OHOS::nfc::cardemulation
 
@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ability_connection_pool.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "ability_connection_stub.h"
+#include "apdu_channel.h"
+#include "loghelper.h"
+#ifdef USE_HILOG
+DEFINE_NFC_LOG_LABEL("AbilityConnectionPool");
+#endif
+
+using namespace OHOS::nfc::sdk::cardemulation;
+namespace OHOS::nfc::cardemulation {
+std::string WarmReasonToString(WarmReason reason)
+{
+    switch (reason) {
+        case WarmReason::DEFAULT:
+            return "default";
+        case WarmReason::FOREGROUND:
+            return "foreground";
+        default:
+            return "recent";
+    }
+}
+
+// the device id of the element reported by the ability manager may differ from the requested one
+static std::string ConnectionKey(const OHOS::AppExecFwk::ElementName& name)
+{
+    return name.GetBundleName() + "/" + name.GetAbilityName();
+}
+
+AbilityConnectionPool::AbilityConnectionPool(size_t maxCount, Connector connect, Disconnector disconnect)
+    : maxCount_(maxCount),
+    connect_(std::move(connect)),
+    disconnect_(std::move(disconnect)),
+    onConnected_(),
+    onDisconnected_(),
+    mu_(),
+    entries_(),
+    hits_(0),
+    misses_(0)
+{
+}
+
+AbilityConnectionPool::~AbilityConnectionPool()
+{
+    Clear();
+}
+
+OHOS::sptr<IApduChannel> AbilityConnectionPool::Acquire(const OHOS::AppExecFwk::ElementName& name)
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = Find(ConnectionKey(name));
+    if (it == entries_.end() || !it->channel_) {
+        ++misses_;
+        return OHOS::sptr<IApduChannel>();
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it);
+    return entries_.front().channel_;
+}
+
+bool AbilityConnectionPool::Warm(const OHOS::AppExecFwk::ElementName& name, WarmReason reason)
+{
+    std::string key = ConnectionKey(name);
+    std::vector<OHOS::sptr<AbilityConnectionStub>> evicted;
+    OHOS::sptr<AbilityConnectionStub> connection;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto it = Find(key);
+        if (it != entries_.end()) {
+            it->reason_ = std::max(it->reason_, reason);
+            entries_.splice(entries_.begin(), entries_, it);
+            return true;
+        }
+        connection = CreateConnection();
+        entries_.push_front(Entry{name, key, reason, connection, nullptr, nullptr});
+        Shrink(evicted);
+        // no room left by the pinned services, the service is not connected at all
+        auto self = std::find(evicted.begin(), evicted.end(), connection);
+        if (self != evicted.end()) {
+            evicted.erase(self);
+            connection = nullptr;
+        }
+    }
+    Disconnect(evicted);
+    if (!connection) {
+        return false;
+    }
+    // the connect callback may arrive before returning, no lock is held here
+    if (!connect_ || !connect_(name, connection)) {
+        ErrorLog("fail to warm connection. URI: %s", name.GetURI().c_str());
+        std::lock_guard<std::mutex> lk(mu_);
+        entries_.remove_if([&connection](const Entry& e) { return e.connection_ == connection; });
+        return false;
+    }
+    return true;
+}
+
+void AbilityConnectionPool::SetPinned(const std::vector<OHOS::AppExecFwk::ElementName>& defaults,
+                                      const std::vector<OHOS::AppExecFwk::ElementName>& foreground)
+{
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        for (auto& e : entries_) {
+            e.reason_ = WarmReason::RECENT;
+        }
+    }
+    for (auto& name : foreground) {
+        Warm(name, WarmReason::FOREGROUND);
+    }
+    for (auto& name : defaults) {
+        Warm(name, WarmReason::DEFAULT);
+    }
+}
+
+void AbilityConnectionPool::Clear()
+{
+    std::vector<OHOS::sptr<AbilityConnectionStub>> connections;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        for (auto& e : entries_) {
+            connections.push_back(e.connection_);
+        }
+        entries_.clear();
+    }
+    Disconnect(connections);
+}
+
+void AbilityConnectionPool::SetObserver(ConnectedCallback onConnected, DisconnectedCallback onDisconnected)
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    onConnected_ = std::move(onConnected);
+    onDisconnected_ = std::move(onDisconnected);
+}
+
+void AbilityConnectionPool::OnRemoteDied(const OHOS::wptr<OHOS::IRemoteObject>& object)
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    auto before = entries_.size();
+    entries_.remove_if([&object](const Entry& e) { return e.remote_ && e.remote_ == object; });
+    if (before != entries_.size()) {
+        DebugLog("warm connection died, count: %zu", entries_.size());
+    }
+}
+
+size_t AbilityConnectionPool::GetCount() const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    return entries_.size();
+}
+
+uint64_t AbilityConnectionPool::GetHits() const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    return hits_;
+}
+
+uint64_t AbilityConnectionPool::GetMisses() const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    return misses_;
+}
+
+std::string AbilityConnectionPool::Dump() const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    std::stringstream ss;
+    ss << "warm connection count: " << entries_.size() << "/" << maxCount_;
+    ss << ", first apdu hits: " << hits_ << ", misses: " << misses_ << "\n";
+    for (auto& e : entries_) {
+        ss << "  service: " << e.name_.GetURI() << ", reason: " << WarmReasonToString(e.reason_);
+        ss << ", connected: " << (e.channel_ ? "true" : "false") << "\n";
+    }
+    return ss.str();
+}
+
+void AbilityConnectionPool::OnConnected(const OHOS::AppExecFwk::ElementName& name,
+                                        const OHOS::sptr<OHOS::IRemoteObject>& remote)
+{
+    if (!remote) {
+        OnDisconnected(name);
+        return;
+    }
+    ConnectedCallback onConnected;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto it = Find(ConnectionKey(name));
+        if (it == entries_.end()) {
+            // evicted while connecting
+            return;
+        }
+        it->remote_ = remote;
+        it->channel_ = OHOS::sptr<ApduChannelProxy>(new ApduChannelProxy(remote));
+        onConnected = onConnected_;
+    }
+    RemoteObjectPool::AddRemoteDeathRecipient(remote, shared_from_this());
+    if (onConnected) {
+        onConnected(name, remote);
+    }
+}
+
+void AbilityConnectionPool::OnDisconnected(const OHOS::AppExecFwk::ElementName& name)
+{
+    DisconnectedCallback onDisconnected;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto it = Find(ConnectionKey(name));
+        if (it != entries_.end()) {
+            entries_.erase(it);
+        }
+        onDisconnected = onDisconnected_;
+    }
+    if (onDisconnected) {
+        onDisconnected(name);
+    }
+}
+
+AbilityConnectionPool::entries_t::iterator AbilityConnectionPool::Find(const std::string& key)
+{
+    return std::find_if(entries_.begin(), entries_.end(), [&key](const Entry& e) { return e.key_ == key; });
+}
+
+void AbilityConnectionPool::Shrink(std::vector<OHOS::sptr<AbilityConnectionStub>>& evicted)
+{
+    // recently used services go first, the pinned ones only when they alone exceed the budget
+    for (auto reason : {WarmReason::RECENT, WarmReason::FOREGROUND, WarmReason::DEFAULT}) {
+        auto it = entries_.end();
+        while (OverBudget() && it != entries_.begin()) {
+            --it;
+            if (it->reason_ != reason) {
+                continue;
+            }
+            evicted.push_back(it->connection_);
+            it = entries_.erase(it);
+        }
+    }
+}
+
+bool AbilityConnectionPool::OverBudget() const
+{
+    return entries_.size() > maxCount_;
+}
+
+OHOS::sptr<AbilityConnectionStub> AbilityConnectionPool::CreateConnection()
+{
+    std::weak_ptr<AbilityConnectionPool> self = shared_from_this();
+    return OHOS::sptr<AbilityConnectionStub>(new AbilityConnectionStub(
+        [self](const OHOS::AppExecFwk::ElementName& element, const OHOS::sptr<OHOS::IRemoteObject>& remoteObject) {
+            auto pool = self.lock();
+            if (pool) {
+                pool->OnConnected(element, remoteObject);
+            }
+        },
+        [self](const OHOS::AppExecFwk::ElementName& element) {
+            auto pool = self.lock();
+            if (pool) {
+                pool->OnDisconnected(element);
+            }
+        }));
+}
+
+void AbilityConnectionPool::Disconnect(const std::vector<OHOS::sptr<AbilityConnectionStub>>& connections)
+{
+    if (!disconnect_) {
+        return;
+    }
+    for (auto& connection : connections) {
+        disconnect_(connection);
+    }
+}
+}  // namespace OHOS::nfc::cardemulation
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ABILITY_CONNECTION_POOL_H
+#define ABILITY_CONNECTION_POOL_H
+
+#include <iremote_object.h>
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "element_name.h"
+#include "refbase.h"
+
+namespace OHOS::nfc {
+namespace sdk::cardemulation {
+class IApduChannel;
+}  // namespace sdk::cardemulation
+namespace cardemulation {
+class AbilityConnectionStub;
+
+enum class WarmReason { RECENT = 0, FOREGROUND, DEFAULT };
+std::string WarmReasonToString(WarmReason reason);
+
+/*
+ * Keeps the ability connections of the hce services warm, so that the first
+ * apdu of a transaction is forwarded without waiting for ConnectAbility.
+ * The default service of a type and the foreground service are pinned, the
+ * recently used services are kept within the count budget and evicted in
+ * LRU order.
+ */
+class AbilityConnectionPool final : public std::enable_shared_from_this<AbilityConnectionPool>,
+                                    public OHOS::IRemoteObject::DeathRecipient {
+public:
+    using Connector = std::function<bool(const OHOS::AppExecFwk::ElementName& name,
+                                         const OHOS::sptr<AbilityConnectionStub>& connection)>;
+    using Disconnector = std::function<void(const OHOS::sptr<AbilityConnectionStub>& connection)>;
+    using ConnectedCallback = std::function<void(const OHOS::AppExecFwk::ElementName& name,
+                                                 const OHOS::sptr<OHOS::IRemoteObject>& remote)>;
+    using DisconnectedCallback = std::function<void(const OHOS::AppExecFwk::ElementName& name)>;
+
+    AbilityConnectionPool(size_t maxCount, Connector connect, Disconnector disconnect);
+    ~AbilityConnectionPool();
+    AbilityConnectionPool(const AbilityConnectionPool&) = delete;
+    AbilityConnectionPool& operator=(const AbilityConnectionPool&) = delete;
+
+    /**
+     * brief: get the connected channel of the service
+     * parameter: name -- element name of the service
+     * return: channel, nullptr when the service is not connected
+     */
+    OHOS::sptr<sdk::cardemulation::IApduChannel> Acquire(const OHOS::AppExecFwk::ElementName& name);
+    /**
+     * brief: keep the service connected, evicting the least recently used services over budget
+     * parameter:
+     *   name -- element name of the service
+     *   reason -- why the service is kept
+     * return: true - the service is connected or being connected, false - no connection is made
+     */
+    bool Warm(const OHOS::AppExecFwk::ElementName& name, WarmReason reason);
+    /**
+     * brief: replace the pinned services, the services no longer pinned become recently used ones
+     * parameter:
+     *   defaults -- default services of the types
+     *   foreground -- foreground preferred services
+     */
+    void SetPinned(const std::vector<OHOS::AppExecFwk::ElementName>& defaults,
+                   const std::vector<OHOS::AppExecFwk::ElementName>& foreground);
+    // disconnects all services
+    void Clear();
+    // observes the connections made by the pool, called without the lock held
+    void SetObserver(ConnectedCallback onConnected, DisconnectedCallback onDisconnected);
+
+    void OnRemoteDied(const OHOS::wptr<OHOS::IRemoteObject>& object) override;
+
+    size_t GetCount() const;
+    uint64_t GetHits() const;
+    uint64_t GetMisses() const;
+    std::string Dump() const;
+
+private:
+    struct Entry {
+        OHOS::AppExecFwk::ElementName name_;
+        std::string key_;
+        WarmReason reason_;
+        OHOS::sptr<AbilityConnectionStub> connection_;
+        OHOS::sptr<OHOS::IRemoteObject> remote_;
+        OHOS::sptr<sdk::cardemulation::IApduChannel> channel_;
+    };
+    using entries_t = std::list<Entry>;
+
+    void OnConnected(const OHOS::AppExecFwk::ElementName& name, const OHOS::sptr<OHOS::IRemoteObject>& remote);
+    void OnDisconnected(const OHOS::AppExecFwk::ElementName& name);
+    entries_t::iterator Find(const std::string& key);
+    // moves the connections over budget into evicted, the entries are kept in LRU order
+    void Shrink(std::vector<OHOS::sptr<AbilityConnectionStub>>& evicted);
+    bool OverBudget() const;
+    OHOS::sptr<AbilityConnectionStub> CreateConnection();
+    void Disconnect(const std::vector<OHOS::sptr<AbilityConnectionStub>>& connections);
+
+private:
+    size_t maxCount_;
+    Connector connect_;
+    Disconnector disconnect_;
+    ConnectedCallback onConnected_;
+    DisconnectedCallback onDisconnected_;
+    mutable std::mutex mu_;
+    // most recently used first
+    entries_t entries_;
+    uint64_t hits_;
+    uint64_t misses_;
+};
+}  // namespace cardemulation
+}  // namespace OHOS::nfc
+#endif  // ABILITY_CONNECTION_POOL_H
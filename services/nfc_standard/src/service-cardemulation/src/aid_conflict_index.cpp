@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aid_conflict_index.h"
+
+#include "aid_set.h"
+#include "card_emulation_util.h"
+
+namespace OHOS::nfc::cardemulation {
+// the same rules as AidString::ConflictWith, expressed on the prefix relation of the hex digits
+static bool IsConflicting(AidType candidate, AidType stored, bool candidateIsPrefix, bool storedIsPrefix)
+{
+    switch (candidate) {
+        case AidType::EXACT:
+            if (stored == AidType::EXACT) {
+                return candidateIsPrefix && storedIsPrefix;
+            }
+            return (stored == AidType::PREFIX) ? storedIsPrefix : candidateIsPrefix;
+        case AidType::PREFIX:
+            if (stored == AidType::PREFIX) {
+                return candidateIsPrefix || storedIsPrefix;
+            }
+            return candidateIsPrefix;
+        case AidType::SUBSET:
+            if (stored == AidType::SUBSET) {
+                return candidateIsPrefix || storedIsPrefix;
+            }
+            return storedIsPrefix;
+        default:
+            return false;
+    }
+}
+
+static std::string GetAidDigits(const AidString& aid)
+{
+    return StringTrim(aid.ToString(), TRIM_AID_FLAGS);
+}
+
+AidConflictIndex::AidConflictIndex() : aids_(), aidsets_(), types_()
+{
+}
+
+AidConflictIndex::~AidConflictIndex() = default;
+
+void AidConflictIndex::Add(const std::shared_ptr<AidSet>& aidset, bool fromPrimary)
+{
+    if (!aidset) {
+        return;
+    }
+    aidsets_.insert(aidset.get());
+    types_.insert(aidset->GetType());
+    aidset->Visit([this, fromPrimary](const std::string&, const AidString& aid) {
+        aids_.emplace(GetAidDigits(aid), Entry{aid.GetType(), fromPrimary});
+    });
+}
+
+bool AidConflictIndex::Contains(const AidSet* aidset) const
+{
+    return aidsets_.find(aidset) != aidsets_.end();
+}
+
+bool AidConflictIndex::ConflictWith(const AidSet& aidset, bool primaryOnly) const
+{
+    bool conflicting = false;
+    aidset.Visit([this, primaryOnly, &conflicting](const std::string&, const AidString& aid) {
+        if (!conflicting) {
+            conflicting = ConflictWith(GetAidDigits(aid), aid.GetType(), primaryOnly);
+        }
+    });
+    return conflicting;
+}
+
+bool AidConflictIndex::HasType(const std::string& type) const
+{
+    return types_.find(type) != types_.end();
+}
+
+size_t AidConflictIndex::Size() const
+{
+    return aids_.size();
+}
+
+void AidConflictIndex::Clear()
+{
+    aids_.clear();
+    aidsets_.clear();
+    types_.clear();
+}
+
+bool AidConflictIndex::ConflictWith(const std::string& aid, AidType type, bool primaryOnly) const
+{
+    if (aid.empty() || type == AidType::INVALID) {
+        return false;
+    }
+    // indexed aids starting with the candidate (including the equal ones)
+    for (auto it = aids_.lower_bound(aid); it != aids_.end() && StringStartsWith(it->first, aid); ++it) {
+        if (primaryOnly && !it->second.primary_) {
+            continue;
+        }
+        bool equal = (it->first.size() == aid.size());
+        if (IsConflicting(type, it->second.type_, true, equal)) {
+            return true;
+        }
+    }
+    // indexed aids being a strict prefix of the candidate, one lookup per byte length
+    for (size_t len = 2 * MIN_LEN_AID_BYTES; len < aid.size(); len += 2) {
+        auto range = aids_.equal_range(aid.substr(0, len));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (primaryOnly && !it->second.primary_) {
+                continue;
+            }
+            if (IsConflicting(type, it->second.type_, false, true)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+}  // namespace OHOS::nfc::cardemulation
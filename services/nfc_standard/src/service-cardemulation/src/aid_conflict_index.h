@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AID_CONFLICT_INDEX_H
+#define AID_CONFLICT_INDEX_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "aid_string.h"
+
+namespace OHOS::nfc::cardemulation {
+class AidSet;
+/*
+ * Incremental index over the aidsets accepted by a routing policy.
+ * AIDs are kept ordered by their hex digits (pattern flag stripped), so the
+ * aids having the candidate as prefix form one contiguous range and the
+ * aids being a prefix of the candidate are found with one lookup per length.
+ * A conflict query costs O(log n) instead of a scan over the accepted aidsets.
+ */
+class AidConflictIndex final {
+public:
+    AidConflictIndex();
+    ~AidConflictIndex();
+    AidConflictIndex(const AidConflictIndex&) = delete;
+    AidConflictIndex& operator=(const AidConflictIndex&) = delete;
+
+    /**
+     * brief: index all aids of an accepted aidset
+     * parameter:
+     *   aidset -- accepted aidset
+     *   fromPrimary -- aidset belongs to the primary service
+     * return: void
+     */
+    void Add(const std::shared_ptr<AidSet>& aidset, bool fromPrimary);
+    bool Contains(const AidSet* aidset) const;
+    /**
+     * brief: check whether any aid of aidset conflicts with an indexed aid
+     * parameter:
+     *   aidset -- candidate aidset
+     *   primaryOnly -- only the aids belonging to the primary service are considered
+     * return: true - conflicting, false - not conflicting
+     */
+    bool ConflictWith(const AidSet& aidset, bool primaryOnly) const;
+    bool HasType(const std::string& type) const;
+    size_t Size() const;
+    void Clear();
+
+private:
+    struct Entry {
+        AidType type_;
+        bool primary_;
+    };
+    bool ConflictWith(const std::string& aid, AidType type, bool primaryOnly) const;
+
+private:
+    // key: aid hex string without pattern flag
+    std::multimap<std::string, Entry> aids_;
+    std::unordered_set<const AidSet*> aidsets_;
+    // types of the accepted aidsets
+    std::unordered_set<std::string> types_;
+};
+}  // namespace OHOS::nfc::cardemulation
+#endif  // AID_CONFLICT_INDEX_H
@@ -83,6 +83,14 @@ bool AidRoutingAdapter::ClearRoutingTable()
     }
     return false;
 }
+bool AidRoutingAdapter::IsNfcEnabled()
+{
+    auto nci = nci_.lock();
+    if (nci) {
+        return nci->IsNfcEnabled();
+    }
+    return false;
+}
 int AidRoutingAdapter::AddAidRoutingEntry(const std::vector<unsigned char>& aid, int target, int aidType)
 {
     if ((aid.size() < AID_MIN_LENGTH_IN_BYTES && !aid.empty()) || aid.size() > AID_MAX_LENGTH_IN_BYTES) {
@@ -38,6 +38,7 @@ public:
     int GetRemainRoutingTableSize();
 
     bool ClearRoutingTable();
+    bool IsNfcEnabled();
 
     virtual int AddAidRoutingEntry(const std::vector<unsigned char>& aid, int target, int aidType);
     virtual int RemoveAidRoutingEntry(const std::vector<unsigned char>& aid);
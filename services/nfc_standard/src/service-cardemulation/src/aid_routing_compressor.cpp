@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aid_routing_compressor.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+
+#include "aid_conflict_index.h"
+#include "aid_routing_adapter.h"
+#include "aid_routing_filter.h"
+#include "aid_set.h"
+#include "card_emulation_util.h"
+#include "loghelper.h"
+#ifdef USE_HILOG
+DEFINE_NFC_LOG_LABEL("AidRoutingCompressor");
+#endif
+
+namespace OHOS::nfc::cardemulation {
+// common prefix of two aids in whole bytes
+static size_t CommonPrefixLength(const std::string& a, const std::string& b)
+{
+    auto mismatch = std::mismatch(a.begin(), a.begin() + std::min(a.size(), b.size()), b.begin());
+    size_t len = static_cast<size_t>(mismatch.first - a.begin());
+    return len - len % 2;
+}
+
+AidRoutingCompressor::AidRoutingCompressor(int mode) : mode_(mode)
+{
+}
+
+AidRoutingCompressor::~AidRoutingCompressor() = default;
+
+std::vector<AidRoute> AidRoutingCompressor::Compress(const std::vector<std::shared_ptr<AidSet>>& routed,
+                                                     const std::vector<std::shared_ptr<AidSet>>& plan) const
+{
+    std::vector<AidRoute> routes;
+    // location: aids ordered by digits
+    std::map<std::string, std::vector<digits_aid_t>> candidates;
+    std::unordered_set<const AidSet*> routedSets;
+    for (auto& aidset : routed) {
+        if (!aidset) {
+            continue;
+        }
+        routedSets.insert(aidset.get());
+        auto location = aidset->GetExecutionEnvironment();
+        aidset->Visit([&routes, &candidates, &location](const std::string&, const AidString& aid) {
+            if (aid.IsSubset()) {
+                routes.push_back(AidRoute{location, aid});
+                return;
+            }
+            candidates[location].emplace_back(StringTrim(aid.ToString(), TRIM_AID_FLAGS), aid);
+        });
+    }
+
+    for (auto& candidate : candidates) {
+        auto& location = candidate.first;
+        auto& aids = candidate.second;
+        // the aids routed elsewhere must keep their routes
+        AidConflictIndex others;
+        for (auto& aidset : plan) {
+            if (!aidset) {
+                continue;
+            }
+            if (routedSets.find(aidset.get()) == routedSets.end() ||
+                !StringEqual(aidset->GetExecutionEnvironment(), location)) {
+                others.Add(aidset, false);
+            }
+        }
+        std::sort(aids.begin(), aids.end(), [](const digits_aid_t& a, const digits_aid_t& b) {
+            return a.first < b.first;
+        });
+        Merge(aids, 0, aids.size(), others, location, routes);
+    }
+    DebugLog("routing entries: %zu", routes.size());
+    return routes;
+}
+
+int AidRoutingCompressor::GetRoutingCost(const std::vector<AidRoute>& routes)
+{
+    int cost = 0;
+    for (auto& route : routes) {
+        std::vector<unsigned char> bytes;
+        route.aid_.ToBytes(bytes);
+        cost += static_cast<int>(bytes.size()) + AID_HEAD_LENGTH;
+    }
+    return cost;
+}
+
+// replaces aids[begin, end) by their common prefix, or splits the range at the
+// weakest common prefix of the neighbours when the prefix cannot be used.
+void AidRoutingCompressor::Merge(const std::vector<digits_aid_t>& aids,
+                                 size_t begin,
+                                 size_t end,
+                                 const AidConflictIndex& others,
+                                 const std::string& location,
+                                 std::vector<AidRoute>& routes) const
+{
+    if (begin >= end) {
+        return;
+    }
+    if (end - begin == 1) {
+        routes.push_back(AidRoute{location, aids[begin].second});
+        return;
+    }
+    // aids are ordered, the common prefix of the first and the last one is shared by all
+    std::string prefix = aids[begin].first.substr(0, CommonPrefixLength(aids[begin].first, aids[end - 1].first));
+    if (CanMerge(prefix, others)) {
+        routes.push_back(AidRoute{location, AidString(prefix + STR_PREFIX_AID_FLAG)});
+        return;
+    }
+    size_t split = begin + 1;
+    size_t weakest = aids[begin].first.size();
+    for (size_t i = begin + 1; i < end; ++i) {
+        size_t len = CommonPrefixLength(aids[i - 1].first, aids[i].first);
+        if (len < weakest) {
+            weakest = len;
+            split = i;
+        }
+    }
+    Merge(aids, begin, split, others, location, routes);
+    Merge(aids, split, end, others, location, routes);
+}
+
+bool AidRoutingCompressor::CanMerge(const std::string& prefix, const AidConflictIndex& others) const
+{
+    if (prefix.size() < 2 * MIN_LEN_AID_BYTES) {
+        return false;
+    }
+    auto merged = std::make_shared<AidSet>();
+    if (!merged->AddAidString(AidString(prefix + STR_PREFIX_AID_FLAG))) {
+        return false;
+    }
+    ModeFilter modeFilter(mode_);
+    return modeFilter.Allow(merged) && !others.ConflictWith(*merged, false);
+}
+}  // namespace OHOS::nfc::cardemulation
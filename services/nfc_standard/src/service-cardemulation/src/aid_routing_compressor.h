@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AID_ROUTING_COMPRESSOR_H
+#define AID_ROUTING_COMPRESSOR_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "aid_string.h"
+
+namespace OHOS::nfc::cardemulation {
+class AidSet;
+class AidConflictIndex;
+struct AidRoute {
+    std::string location_;
+    AidString aid_;
+};
+
+/*
+ * Merges the sibling aids routed to the same location into one prefix entry.
+ * A merge is applied only when the routing mode supports prefix matching and
+ * the prefix does not conflict with any aid of the plan routed elsewhere.
+ */
+class AidRoutingCompressor final {
+public:
+    explicit AidRoutingCompressor(int mode);
+    ~AidRoutingCompressor();
+
+    /**
+     * brief: build the routing entries of the routed aidsets
+     * parameter:
+     *   routed -- aidsets programmed into the routing table
+     *   plan -- all aidsets of the routing plan, the ones not in routed are routed elsewhere
+     * return: routing entries
+     */
+    std::vector<AidRoute> Compress(const std::vector<std::shared_ptr<AidSet>>& routed,
+                                   const std::vector<std::shared_ptr<AidSet>>& plan) const;
+    /**
+     * brief: routing table bytes consumed by the entries
+     * parameter: routes -- routing entries
+     * return: bytes
+     */
+    static int GetRoutingCost(const std::vector<AidRoute>& routes);
+
+private:
+    using digits_aid_t = std::pair<std::string, AidString>;
+    void Merge(const std::vector<digits_aid_t>& aids,
+               size_t begin,
+               size_t end,
+               const AidConflictIndex& others,
+               const std::string& location,
+               std::vector<AidRoute>& routes) const;
+    bool CanMerge(const std::string& prefix, const AidConflictIndex& others) const;
+
+private:
+    int mode_;
+};
+}  // namespace OHOS::nfc::cardemulation
+#endif  // AID_ROUTING_COMPRESSOR_H
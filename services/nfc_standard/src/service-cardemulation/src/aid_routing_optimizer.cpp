@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aid_routing_optimizer.h"
+
+#include <cstdint>
+#include <sstream>
+
+#include "aid_routing_adapter.h"
+#include "aid_set.h"
+#include "card_emulation_def.h"
+#include "card_emulation_service_info.h"
+#include "card_emulation_util.h"
+#include "element_name.h"
+#include "loghelper.h"
+#ifdef USE_HILOG
+DEFINE_NFC_LOG_LABEL("AidRoutingOptimizer");
+#endif
+
+namespace OHOS::nfc::cardemulation {
+std::string RoutingPriorityToString(RoutingPriority priority)
+{
+    switch (priority) {
+        case RoutingPriority::PRIMARY:
+            return "primary";
+        case RoutingPriority::PREFERRED:
+            return "preferred";
+        case RoutingPriority::PAYMENT:
+            return "payment";
+        default:
+            return "other";
+    }
+}
+
+AidRoutingOptimizer::AidRoutingOptimizer(int capacity, std::function<bool(const std::string&)> isDefaultRoute)
+    : capacity_(capacity > 0 ? capacity : 0),
+    used_(0),
+    isDefaultRoute_(std::move(isDefaultRoute)),
+    evictions_()
+{
+}
+
+AidRoutingOptimizer::~AidRoutingOptimizer() = default;
+
+std::vector<std::shared_ptr<AidSet>> AidRoutingOptimizer::Optimize(
+    const std::vector<std::shared_ptr<AidSet>>& plan,
+    const std::shared_ptr<CardEmulationServiceInfo>& primary,
+    const std::shared_ptr<CardEmulationServiceInfo>& preferred)
+{
+    used_ = 0;
+    evictions_.clear();
+
+    // aidsets routed to the default route do not occupy the routing table
+    std::vector<int> costs(plan.size(), 0);
+    std::vector<RoutingPriority> priorities(plan.size(), RoutingPriority::OTHER);
+    int total = 0;
+    for (size_t i = 0; i < plan.size(); ++i) {
+        if (!plan[i]) {
+            continue;
+        }
+        priorities[i] = GetPriority(plan[i], primary, preferred);
+        if (isDefaultRoute_ && isDefaultRoute_(plan[i]->GetExecutionEnvironment())) {
+            continue;
+        }
+        costs[i] = GetRoutingCost(*plan[i]);
+        total += costs[i];
+    }
+
+    std::vector<bool> kept(plan.size(), true);
+    if (total > capacity_) {
+        kept = Pack(costs, priorities);
+    }
+
+    std::vector<std::shared_ptr<AidSet>> rv;
+    rv.reserve(plan.size());
+    for (size_t i = 0; i < plan.size(); ++i) {
+        if (!plan[i]) {
+            continue;
+        }
+        if (kept[i]) {
+            used_ += costs[i];
+            rv.push_back(plan[i]);
+        } else {
+            evictions_.push_back(Eviction{plan[i], priorities[i], costs[i]});
+        }
+    }
+    if (!evictions_.empty()) {
+        InfoLog("routing table capacity: %d bytes, required: %d bytes, evicted aidsets: %zu",
+                capacity_,
+                total,
+                evictions_.size());
+    }
+    return rv;
+}
+
+int AidRoutingOptimizer::GetRoutingCost(const AidSet& aidset)
+{
+    int cost = 0;
+    aidset.Visit([&cost](const std::string&, const AidString& aid) {
+        std::vector<unsigned char> bytes;
+        aid.ToBytes(bytes);
+        cost += static_cast<int>(bytes.size()) + AID_HEAD_LENGTH;
+    });
+    return cost;
+}
+
+int AidRoutingOptimizer::GetCapacity() const
+{
+    return capacity_;
+}
+
+int AidRoutingOptimizer::GetUsedCapacity() const
+{
+    return used_;
+}
+
+const std::vector<AidRoutingOptimizer::Eviction>& AidRoutingOptimizer::GetEvictions() const
+{
+    return evictions_;
+}
+
+std::string AidRoutingOptimizer::Dump() const
+{
+    std::stringstream ss;
+    ss << "routing table capacity: " << capacity_ << " bytes, used: " << used_ << " bytes\n";
+    ss << "evicted aidset count: " << evictions_.size() << "\n";
+    for (auto& e : evictions_) {
+        auto owner = e.aidset_->GetOwner().lock();
+        std::shared_ptr<OHOS::AppExecFwk::ElementName> name = owner ? owner->GetName() : nullptr;
+        ss << "  service: " << (name ? name->GetURI() : "unknown");
+        ss << ", type: " << e.aidset_->GetType();
+        ss << ", EE: " << e.aidset_->GetExecutionEnvironment();
+        ss << ", priority: " << RoutingPriorityToString(e.priority_);
+        ss << ", cost: " << e.cost_ << " bytes, aid: [";
+        for (auto& s : e.aidset_->GetAllAidRawString()) {
+            ss << s << ", ";
+        }
+        ss << "]\n";
+    }
+    return ss.str();
+}
+
+RoutingPriority AidRoutingOptimizer::GetPriority(const std::shared_ptr<AidSet>& aidset,
+                                                 const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                                                 const std::shared_ptr<CardEmulationServiceInfo>& preferred)
+{
+    auto owner = aidset->GetOwner().lock();
+    if (owner && owner == primary) {
+        return RoutingPriority::PRIMARY;
+    }
+    if (owner && owner == preferred) {
+        return RoutingPriority::PREFERRED;
+    }
+    if (StringEqual(aidset->GetType(), CARDEMULATION_SERVICE_TYPE_SECURE, true)) {
+        return RoutingPriority::PAYMENT;
+    }
+    return RoutingPriority::OTHER;
+}
+
+// 0/1 knapsack over the capacity in bytes.
+// the value of a class exceeds the sum of all values of the lower classes, because
+// no more than maxItems aidsets fit into the table at the same time.
+std::vector<bool> AidRoutingOptimizer::Pack(const std::vector<int>& costs,
+                                            const std::vector<RoutingPriority>& priorities) const
+{
+    const int64_t maxItems = capacity_ / static_cast<int>(AID_MIN_LENGTH_IN_BYTES + AID_HEAD_LENGTH) + 1;
+    auto valueOf = [maxItems](RoutingPriority priority) {
+        int64_t value = 1;
+        for (int i = 0; i < static_cast<int>(priority); ++i) {
+            value *= (maxItems + 1);
+        }
+        return value;
+    };
+
+    std::vector<bool> kept(costs.size(), false);
+    std::vector<int64_t> best(capacity_ + 1, 0);
+    std::vector<std::vector<bool>> taken(costs.size());
+    for (size_t i = 0; i < costs.size(); ++i) {
+        if (costs[i] == 0) {
+            kept[i] = true;
+            continue;
+        }
+        if (costs[i] > capacity_) {
+            continue;
+        }
+        taken[i].assign(capacity_ + 1, false);
+        int64_t value = valueOf(priorities[i]);
+        // strict comparison keeps the earlier aidset of the plan on a tie
+        for (int c = capacity_; c >= costs[i]; --c) {
+            if (best[c - costs[i]] + value > best[c]) {
+                best[c] = best[c - costs[i]] + value;
+                taken[i][c] = true;
+            }
+        }
+    }
+    int c = capacity_;
+    for (size_t i = costs.size(); i > 0; --i) {
+        auto& t = taken[i - 1];
+        if (!t.empty() && t[c]) {
+            kept[i - 1] = true;
+            c -= costs[i - 1];
+        }
+    }
+    return kept;
+}
+}  // namespace OHOS::nfc::cardemulation
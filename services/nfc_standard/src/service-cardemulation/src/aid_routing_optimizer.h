@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AID_ROUTING_OPTIMIZER_H
+#define AID_ROUTING_OPTIMIZER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OHOS::nfc::cardemulation {
+class AidSet;
+class CardEmulationServiceInfo;
+// a higher value means a higher priority
+enum class RoutingPriority { OTHER = 0, PAYMENT, PREFERRED, PRIMARY };
+std::string RoutingPriorityToString(RoutingPriority priority);
+
+/*
+ * Selects the aidsets of a routing plan that are programmed into the controller.
+ * The remaining routing table size is the knapsack budget, the aidsets routed to the
+ * default route cost nothing. Any aidset of a priority class outweighs all aidsets of
+ * the lower classes, inside a class the number of routed aidsets is maximized.
+ */
+class AidRoutingOptimizer final {
+public:
+    struct Eviction {
+        std::shared_ptr<AidSet> aidset_;
+        RoutingPriority priority_;
+        int cost_;
+    };
+    AidRoutingOptimizer(int capacity, std::function<bool(const std::string&)> isDefaultRoute);
+    ~AidRoutingOptimizer();
+
+    /**
+     * brief: pack the routing plan into the routing table capacity
+     * parameter:
+     *   plan -- aidsets planned by the routing policy, in priority order
+     *   primary -- primary service
+     *   preferred -- preferred service
+     * return: the aidsets to program, in the order of plan
+     */
+    std::vector<std::shared_ptr<AidSet>> Optimize(const std::vector<std::shared_ptr<AidSet>>& plan,
+                                                  const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                                                  const std::shared_ptr<CardEmulationServiceInfo>& preferred);
+    /**
+     * brief: routing table bytes consumed by the aids of aidset
+     * parameter: aidset -- aidset to program
+     * return: bytes
+     */
+    static int GetRoutingCost(const AidSet& aidset);
+    int GetCapacity() const;
+    int GetUsedCapacity() const;
+    const std::vector<Eviction>& GetEvictions() const;
+    std::string Dump() const;
+
+private:
+    static RoutingPriority GetPriority(const std::shared_ptr<AidSet>& aidset,
+                                       const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                                       const std::shared_ptr<CardEmulationServiceInfo>& preferred);
+    std::vector<bool> Pack(const std::vector<int>& costs, const std::vector<RoutingPriority>& priorities) const;
+
+private:
+    int capacity_;
+    int used_;
+    std::function<bool(const std::string&)> isDefaultRoute_;
+    std::vector<Eviction> evictions_;
+};
+}  // namespace OHOS::nfc::cardemulation
+#endif  // AID_ROUTING_OPTIMIZER_H
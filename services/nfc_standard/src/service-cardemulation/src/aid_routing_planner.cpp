@@ -18,10 +18,14 @@
 #include <assert.h>
 
 #include <algorithm>
+#include <atomic>
+#include <map>
 #include <sstream>
 
 #include "aid_routing_adapter.h"
+#include "aid_routing_compressor.h"
 #include "aid_routing_filter.h"
+#include "aid_routing_optimizer.h"
 #include "aid_routing_table.h"
 #include "aid_set.h"
 #include "aid_string.h"
@@ -30,7 +34,9 @@
 #include "card_emulation_service_info.h"
 #include "element_name.h"
 #include "iaid_routing_policy.h"
+#include "installed_ceservice_getter.h"
 #include "loghelper.h"
+#include "routing_plan_store.h"
 #ifdef USE_HILOG
 DEFINE_NFC_LOG_LABEL("AidRoutingPlanner");
 #endif
@@ -39,6 +45,9 @@ DEFINE_NFC_LOG_LABEL("AidRoutingPlanner");
 #endif
 
 namespace OHOS::nfc::cardemulation {
+// the optimizer is run again with the bytes saved by compression at most this often
+constexpr int MAX_COMPRESSION_ROUNDS = 4;
+
 class AidBatchAdder {
 public:
     AidBatchAdder(std::shared_ptr<AidRoutingAdapter> routingController, int reserved)
@@ -46,21 +55,49 @@ public:
         reserved_(reserved){};
     void AddAidRoutingEntry(std::vector<unsigned char>&& aid, const std::string& target, int aidType);
 
-    int AddAidsWhenEnoughSpace();
+    // entries to program, empty when they do not fit
+    std::vector<RoutingEntry> TakeEntriesWhenEnoughSpace();
+    int GetReserved() const
+    {
+        return reserved_;
+    }
 
 private:
     std::shared_ptr<AidRoutingAdapter> routingController_;
-    int reserved_;  
+    int reserved_;
 
     std::vector<RoutingEntry> entries_{};
 };
 
+static int GetEntriesCost(const std::vector<RoutingEntry>& entries)
+{
+    int cost = 0;
+    for (auto& entry : entries) {
+        cost += static_cast<int>(entry.aid_.size()) + AID_HEAD_LENGTH;
+    }
+    return cost;
+}
+
+static bool SameEntries(const std::vector<RoutingEntry>& a, const std::vector<RoutingEntry>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const RoutingEntry& x, const RoutingEntry& y) {
+        return x.aid_ == y.aid_ && x.route_ == y.route_ && x.aidPattern_ == y.aidPattern_;
+    });
+}
+
 AidRoutingPlanner::AidRoutingPlanner(std::unique_ptr<IAidRoutingPolicy> routingStrategy,
                                      const std::shared_ptr<AidRoutingAdapter>& routingController)
     : routingPolicy_(std::move(routingStrategy)),
     routingController_(routingController),
-    aidTable_(),
-    mu_()
+    aidTable_(std::make_shared<const aid_table_t>()),
+    optimizerDump_(),
+    primary_(),
+    preferred_(),
+    mu_(),
+    planMu_(),
+    planStore_(),
+    executor_(),
+    planGeneration_(0)
 {
 }
 int AidRoutingPlanner::Init()
@@ -68,6 +105,13 @@ int AidRoutingPlanner::Init()
     return 0;
 }
 
+void AidRoutingPlanner::SetPlanStore(std::shared_ptr<RoutingPlanStore> store, Executor executor)
+{
+    std::lock_guard<std::mutex> planLock(planMu_);
+    planStore_ = std::move(store);
+    executor_ = std::move(executor);
+}
+
 int AidRoutingPlanner::OnCeServiceChanged(const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos,
                                           const std::shared_ptr<CardEmulationServiceInfo>& primary,
                                           const std::shared_ptr<CardEmulationServiceInfo>& preferred)
@@ -75,66 +119,141 @@ int AidRoutingPlanner::OnCeServiceChanged(const std::vector<std::shared_ptr<Card
     if (!routingPolicy_ || !routingController_) {
         return ERR_NULL_POINTER;
     }
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        primary_ = primary;
+        preferred_ = preferred;
+    }
 
-    auto routingTable = routingPolicy_->PlanRoutingTable(infos, primary, preferred);
+    std::lock_guard<std::mutex> planLock(planMu_);
+    ++planGeneration_;
     // - AID_HEAD_LENGTH for default routing entry
     routingController_->ClearRoutingTable();
     int remain = routingController_->GetRemainRoutingTableSize() - AID_HEAD_LENGTH;
     if (remain < 1) {
         return ERR_ROUTING_TABLE_NOT_ENOUGH_CAPACITY;
     }
+    if (!planStore_) {
+        return Program(Plan(infos, primary, preferred, remain), infos.size());
+    }
 
-    for (auto it = std::begin(routingTable); it != std::end(routingTable); ++it) {
-        auto& aidset = *it;
-        auto location = aidset->GetExecutionEnvironment();
-        if (routingController_->IsDefaultRoute(location)) {
-            DebugLog("env: %s is the same env with default: 0x%02X",
-                     location.c_str(),
-                     routingController_->GetDefaultRoute());
-            continue;
+    uint64_t inputsHash = RoutingPlanStore::HashInputs(infos,
+                                                       primary,
+                                                       preferred,
+                                                       routingController_->GetAidRoutingMode(),
+                                                       routingController_->GetAidRoutingTableCapacity(),
+                                                       routingController_->GetDefaultRoute());
+    auto stored = planStore_->Load();
+    PlanResult restored;
+    if (stored && stored->inputsHash_ == inputsHash && RestorePlan(*stored, infos, remain, restored)) {
+        InfoLog("routing plan is unchanged, entry count: %zu", restored.entries_.size());
+        int rv = Program(std::move(restored), infos.size());
+        DeferPlanning(infos, primary, preferred, remain, inputsHash);
+        return rv;
+    }
+    auto result = Plan(infos, primary, preferred, remain);
+    StorePlan(inputsHash, result);
+    return Program(std::move(result), infos.size());
+}
+
+AidRoutingPlanner::PlanResult AidRoutingPlanner::Plan(const infos_t& infos,
+                                                      const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                                                      const std::shared_ptr<CardEmulationServiceInfo>& preferred,
+                                                      int remain) const
+{
+    auto plan = routingPolicy_->PlanRoutingTable(infos, primary, preferred);
+
+    auto isDefaultRoute = [this](const std::string& location) {
+        return routingController_->IsDefaultRoute(location);
+    };
+    // keep the aidsets of the highest priority fitting into the routing table
+    AidRoutingOptimizer optimizer(remain, isDefaultRoute);
+    auto routingTable = optimizer.Optimize(plan, primary, preferred);
+    // merge sibling aids into prefix entries, the saved bytes are given back to the optimizer
+    AidRoutingCompressor compressor(routingController_->GetAidRoutingMode());
+    auto routes = compressor.Compress(GetProgrammedAidsets(routingTable), plan);
+    int required = optimizer.GetUsedCapacity();
+    for (auto& eviction : optimizer.GetEvictions()) {
+        required += eviction.cost_;
+    }
+    for (int round = 0; round < MAX_COMPRESSION_ROUNDS && !optimizer.GetEvictions().empty(); ++round) {
+        // the whole plan first, then the budget grown by the bytes saved
+        int capacity = (round == 0)
+                           ? required
+                           : optimizer.GetUsedCapacity() + remain - AidRoutingCompressor::GetRoutingCost(routes);
+        if (capacity <= optimizer.GetCapacity()) {
+            break;
         }
-        AidBatchAdder adder(routingController_, remain);
-        aidset->Visit([&adder, location](const std::string&, const AidString& aidstring) {
-            std::vector<unsigned char> bytes;
-            aidstring.ToBytes(bytes);
-            assert(!bytes.empty());
-            assert(aidstring.GetType() != AidType::INVALID);
-            adder.AddAidRoutingEntry(std::move(bytes), location, AidTypeToInt(aidstring.GetType()));
-        });
-        // batch add aids of AidSet.
-        // cannot add in part.
-        remain = adder.AddAidsWhenEnoughSpace();
-        if (remain < AID_HEAD_LENGTH) {
-            // remain is insufficient.
-            // host is default route. so erase all of not in host
-            if (routingController_->IsDefaultRoute(NFC_EE_HOST)) {
-                routingTable.erase(std::remove_if(it, routingTable.end(), [this](decltype(it)::reference r) {
-                    return r->GetExecutionEnvironment() != NFC_EE_HOST;
-                }));
-            } else {
-                routingTable.erase(it, routingTable.end());
+        AidRoutingOptimizer relaxed(capacity, isDefaultRoute);
+        auto relaxedTable = relaxed.Optimize(plan, primary, preferred);
+        auto relaxedRoutes = compressor.Compress(GetProgrammedAidsets(relaxedTable), plan);
+        if (AidRoutingCompressor::GetRoutingCost(relaxedRoutes) > remain) {
+            if (round == 0) {
+                continue;
             }
             break;
         }
+        optimizer = relaxed;
+        routingTable = std::move(relaxedTable);
+        routes = std::move(relaxedRoutes);
+    }
+
+    AidBatchAdder adder(routingController_, remain);
+    for (auto& route : routes) {
+        std::vector<unsigned char> bytes;
+        route.aid_.ToBytes(bytes);
+        assert(!bytes.empty());
+        assert(route.aid_.GetType() != AidType::INVALID);
+        adder.AddAidRoutingEntry(std::move(bytes), route.location_, AidTypeToInt(route.aid_.GetType()));
+    }
+    PlanResult result;
+    result.entries_ = adder.TakeEntriesWhenEnoughSpace();
+    result.remain_ = adder.GetReserved();
+    if (result.remain_ < 0) {
+        // not expected after optimizing, only the default route is left.
+        ErrorLog("routing table is insufficient, required: %d bytes", AidRoutingCompressor::GetRoutingCost(routes));
+        routingTable.erase(std::remove_if(routingTable.begin(),
+                                          routingTable.end(),
+                                          [&isDefaultRoute](decltype(routingTable)::reference r) {
+                                              return !isDefaultRoute(r->GetExecutionEnvironment());
+                                          }),
+                           routingTable.end());
+        routes.clear();
     }
+    result.routingTable_ = std::move(routingTable);
 
-    int addState = AddDefaultRouting(primary, routingTable);
+    std::stringstream dump;
+    dump << optimizer.Dump() << "routing entry count: " << routes.size()
+         << ", bytes: " << AidRoutingCompressor::GetRoutingCost(routes) << "\n";
+    result.dump_ = dump.str();
+    return result;
+}
+
+int AidRoutingPlanner::Program(PlanResult&& result, size_t serviceCount)
+{
+    for (auto& entry : result.entries_) {
+        routingController_->AddAidRoutingEntry(entry.aid_, entry.route_, entry.aidPattern_);
+    }
+    int remain = result.remain_;
+    int addState = AddDefaultRouting();
 
+    auto snapshot = std::make_shared<const aid_table_t>(std::move(result.routingTable_));
+    std::atomic_store(&aidTable_, snapshot);
     {
         std::lock_guard<std::mutex> lk(mu_);
-        aidTable_ = std::move(routingTable);
+        optimizerDump_ = std::move(result.dump_);
 #ifdef USE_HILOG
 
         DebugLog("cardemulation service count : %{public}zu, routing table capacity: %{public}zu bytes",
-                 infos.size(),
+                 serviceCount,
                  remain);
 #else
         // TODO:
         std::stringstream ss;
-        ss << "cardemulation service count:" << infos.size() << ", routing table remain size: " << remain << "\n";
-        ss << "uncommit routing entry size: " << aidTable_.size() + (IS_OK(addState) ? 1u : 0u) << "\n";
+        ss << "cardemulation service count:" << serviceCount << ", routing table remain size: " << remain << "\n";
+        ss << "uncommit routing entry size: " << snapshot->size() + (IS_OK(addState) ? 1u : 0u) << "\n";
 
-        std::for_each(aidTable_.begin(), aidTable_.end(), [&ss](auto r) {
+        std::for_each(snapshot->begin(), snapshot->end(), [&ss](auto r) {
             std::vector<std::string> aids = r->GetAllAidRawString(true);
             ss << "EE: " << r->GetExecutionEnvironment();
             ss << ", aid: [";
@@ -149,12 +268,111 @@ int AidRoutingPlanner::OnCeServiceChanged(const std::vector<std::shared_ptr<Card
         printf("%s", ss.str().c_str());
 #endif
 #ifdef MOCK_FOR_TESTING
-        AidRoutingCommonEvent::PublishAidRoutingTable(aidTable_);
+        AidRoutingCommonEvent::PublishAidRoutingTable(*snapshot);
 #endif
     }
     return routingController_->CommitAidRouting();
 }
 
+bool AidRoutingPlanner::RestorePlan(const RoutingPlan& stored,
+                                    const infos_t& infos,
+                                    int remain,
+                                    PlanResult& result) const
+{
+    if (GetEntriesCost(stored.entries_) > remain) {
+        return false;
+    }
+    std::map<std::string, std::shared_ptr<CardEmulationServiceInfo>> services;
+    for (auto& info : infos) {
+        auto name = info ? info->GetName() : nullptr;
+        if (name) {
+            services[ElementNameToString(*name)] = info;
+        }
+    }
+    aid_table_t routingTable;
+    for (auto& routed : stored.aidsets_) {
+        auto it = services.find(routed.service_);
+        auto aidset = (it == services.end()) ? nullptr : it->second->GetAidsetByType(routed.type_);
+        if (!aidset) {
+            return false;
+        }
+        routingTable.push_back(aidset);
+    }
+    result.routingTable_ = std::move(routingTable);
+    result.entries_ = stored.entries_;
+    result.remain_ = remain - GetEntriesCost(stored.entries_);
+    std::stringstream dump;
+    dump << "routing plan restored, routing entry count: " << stored.entries_.size()
+         << ", bytes: " << GetEntriesCost(stored.entries_) << "\n";
+    result.dump_ = dump.str();
+    return true;
+}
+
+void AidRoutingPlanner::StorePlan(uint64_t inputsHash, const PlanResult& result)
+{
+    RoutingPlan plan;
+    plan.inputsHash_ = inputsHash;
+    plan.entries_ = result.entries_;
+    for (auto& aidset : result.routingTable_) {
+        auto name = aidset->GetOwnerName();
+        plan.aidsets_.push_back(RoutingPlan::RoutedAidset{name ? ElementNameToString(*name) : "", aidset->GetType()});
+    }
+    if (!planStore_->Store(plan)) {
+        ErrorLog("fail to store routing plan");
+    }
+}
+
+void AidRoutingPlanner::DeferPlanning(const infos_t& infos,
+                                      const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                                      const std::shared_ptr<CardEmulationServiceInfo>& preferred,
+                                      int remain,
+                                      uint64_t inputsHash)
+{
+    if (!executor_) {
+        return;
+    }
+    std::weak_ptr<AidRoutingPlanner> self = weak_from_this();
+    uint64_t generation = planGeneration_;
+    executor_([self, generation, infos, primary, preferred, remain, inputsHash]() {
+        auto planner = self.lock();
+        if (planner) {
+            planner->RunDeferredPlanning(generation, infos, primary, preferred, remain, inputsHash);
+        }
+    });
+}
+
+void AidRoutingPlanner::RunDeferredPlanning(uint64_t generation,
+                                            const infos_t& infos,
+                                            const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                                            const std::shared_ptr<CardEmulationServiceInfo>& preferred,
+                                            int remain,
+                                            uint64_t inputsHash)
+{
+    std::lock_guard<std::mutex> planLock(planMu_);
+    if (generation != planGeneration_ || !planStore_) {
+        DebugLog("deferred planning is replaced");
+        return;
+    }
+    if (!routingController_->IsNfcEnabled()) {
+        // the routing is planned again when nfc is turned on
+        DebugLog("deferred planning is dropped, nfc is off");
+        return;
+    }
+    auto result = Plan(infos, primary, preferred, remain);
+    auto stored = planStore_->Load();
+    if (stored && SameEntries(stored->entries_, result.entries_)) {
+        // the programmed entries are kept, the routing table of the planning is published for the dump
+        std::atomic_store(&aidTable_, std::make_shared<const aid_table_t>(std::move(result.routingTable_)));
+        std::lock_guard<std::mutex> lk(mu_);
+        optimizerDump_ = std::move(result.dump_);
+        return;
+    }
+    InfoLog("stored routing plan is stale, programming the planned one");
+    StorePlan(inputsHash, result);
+    routingController_->ClearRoutingTable();
+    Program(std::move(result), infos.size());
+}
+
 std::vector<ServiceInfoTypePair> AidRoutingPlanner::GetCardEmulationServicesByAid(const std::string& aid)
 {
     std::vector<ServiceInfoTypePair> rv;
@@ -166,8 +384,9 @@ std::vector<ServiceInfoTypePair> AidRoutingPlanner::GetCardEmulationServicesByAi
         return rv;
     }
     DebugLog("aid: %s", aidStr.ToString().c_str());
-    std::lock_guard<std::mutex> lk(mu_);
-    std::for_each(aidTable_.cbegin(), aidTable_.cend(), [&rv, &aidStr](decltype(aidTable_)::const_reference r) {
+    // lock free, the snapshot is never modified after publishing
+    auto snapshot = std::atomic_load(&aidTable_);
+    std::for_each(snapshot->cbegin(), snapshot->cend(), [&rv, &aidStr](aid_table_t::const_reference r) {
         if (r) {
             if (r->HasAidString(aidStr)) {
                 //
@@ -179,8 +398,52 @@ std::vector<ServiceInfoTypePair> AidRoutingPlanner::GetCardEmulationServicesByAi
     return rv;
 }
 
-int AidRoutingPlanner::AddDefaultRouting(const std::shared_ptr<CardEmulationServiceInfo>& primary,
-                                         std::vector<std::shared_ptr<nfc::cardemulation::AidSet>>& routingTable)
+std::shared_ptr<CardEmulationServiceInfo> AidRoutingPlanner::GetPrimaryService()
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    return primary_.lock();
+}
+
+std::shared_ptr<CardEmulationServiceInfo> AidRoutingPlanner::GetPreferredService()
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    return preferred_.lock();
+}
+
+std::string AidRoutingPlanner::Dump()
+{
+    std::stringstream ss;
+    auto snapshot = std::atomic_load(&aidTable_);
+    ss << "aid routing table:\n";
+    std::for_each(snapshot->cbegin(), snapshot->cend(), [&ss](aid_table_t::const_reference r) {
+        ss << "  type: " << r->GetType() << ", EE: " << r->GetExecutionEnvironment() << ", aid: [";
+        for (auto& s : r->GetAllAidRawString()) {
+            ss << s << ", ";
+        }
+        ss << "]\n";
+    });
+    std::lock_guard<std::mutex> lk(mu_);
+    ss << optimizerDump_;
+    return ss.str();
+}
+
+AidRoutingPlanner::aid_table_t AidRoutingPlanner::GetProgrammedAidsets(const aid_table_t& routingTable) const
+{
+    aid_table_t rv;
+    for (auto& aidset : routingTable) {
+        auto location = aidset->GetExecutionEnvironment();
+        if (routingController_->IsDefaultRoute(location)) {
+            DebugLog("env: %s is the same env with default: 0x%02X",
+                     location.c_str(),
+                     routingController_->GetDefaultRoute());
+            continue;
+        }
+        rv.push_back(aidset);
+    }
+    return rv;
+}
+
+int AidRoutingPlanner::AddDefaultRouting()
 {
     int route = routingController_->GetDefaultRoute();
     DebugLog("default route: 0x%02X", route);
@@ -197,13 +460,11 @@ void AidBatchAdder::AddAidRoutingEntry(std::vector<unsigned char>&& aid, const s
     reserved_ -= aid.size() + AID_HEAD_LENGTH;
 }
 
-int AidBatchAdder::AddAidsWhenEnoughSpace()
+std::vector<RoutingEntry> AidBatchAdder::TakeEntriesWhenEnoughSpace()
 {
-    if (reserved_ >= 0) {
-        std::for_each(std::begin(entries_), std::end(entries_), [this](decltype(entries_)::reference r) {
-            routingController_->AddAidRoutingEntry(r.aid_, r.route_, r.aidPattern_);
-        });
+    if (reserved_ < 0) {
+        return {};
     }
-    return reserved_;
+    return std::move(entries_);
 }
 }  // namespace OHOS::nfc::cardemulation
@@ -16,10 +16,14 @@
 #ifndef AID_ROUTING_PLANNER_H
 #define AID_ROUTING_PLANNER_H
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
+#include "aid_routing_table.h"
 #include "iaid_routing_manager.h"
 
 namespace OHOS::nfc::cardemulation {
@@ -27,27 +31,82 @@ class AidRoutingAdapter;
 class CardEmulationServiceInfo;
 class AidSet;
 class IAidRoutingPolicy;
-class AidRoutingPlanner final : public IAidRoutingManager {
+class RoutingPlan;
+class RoutingPlanStore;
+class AidRoutingPlanner final : public IAidRoutingManager, public std::enable_shared_from_this<AidRoutingPlanner> {
 public:
+    // runs the deferred planning serialized with the routing commits, never inline
+    using Executor = std::function<void(std::function<void()>)>;
     AidRoutingPlanner(std::unique_ptr<IAidRoutingPolicy> routingStrategy,
                       const std::shared_ptr<AidRoutingAdapter>& routingController);
     int Init();
+    /**
+     * brief: persist the routing plan, while the planning inputs are unchanged the stored plan is
+     *        programmed at once and the planning is deferred to the executor
+     * parameter:
+     *   store -- plan store, nullptr to plan every time
+     *   executor -- runs the deferred planning, nullptr to keep the stored plan without planning
+     */
+    void SetPlanStore(std::shared_ptr<RoutingPlanStore> store, Executor executor = nullptr);
     int OnCeServiceChanged(const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos,
                            const std::shared_ptr<CardEmulationServiceInfo>& primary,
                            const std::shared_ptr<CardEmulationServiceInfo>& preferred) override;
 
     std::vector<ServiceInfoTypePair> GetCardEmulationServicesByAid(const std::string& aid) override;
+    std::shared_ptr<CardEmulationServiceInfo> GetPrimaryService() override;
+    std::shared_ptr<CardEmulationServiceInfo> GetPreferredService() override;
+    // routing table and the aidsets evicted by the last planning
+    std::string Dump();
 
 private:
-    int AddDefaultRouting(const std::shared_ptr<CardEmulationServiceInfo>& primary,
-                          std::vector<std::shared_ptr<nfc::cardemulation::AidSet>>& routingTable);
+    using aid_table_t = std::vector<std::shared_ptr<AidSet>>;
+    using infos_t = std::vector<std::shared_ptr<CardEmulationServiceInfo>>;
+    struct PlanResult {
+        aid_table_t routingTable_;
+        std::vector<RoutingEntry> entries_;
+        std::string dump_;
+        int remain_;
+    };
+    // plans the routing table fitting into remain bytes, the controller is not changed
+    PlanResult Plan(const infos_t& infos,
+                    const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                    const std::shared_ptr<CardEmulationServiceInfo>& preferred,
+                    int remain) const;
+    // programs the cleared controller and publishes the routing table
+    int Program(PlanResult&& result, size_t serviceCount);
+    // rebuilds the stored plan from the services, false when a routed aidset is gone
+    bool RestorePlan(const RoutingPlan& stored, const infos_t& infos, int remain, PlanResult& result) const;
+    void StorePlan(uint64_t inputsHash, const PlanResult& result);
+    void DeferPlanning(const infos_t& infos,
+                       const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                       const std::shared_ptr<CardEmulationServiceInfo>& preferred,
+                       int remain,
+                       uint64_t inputsHash);
+    void RunDeferredPlanning(uint64_t generation,
+                             const infos_t& infos,
+                             const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                             const std::shared_ptr<CardEmulationServiceInfo>& preferred,
+                             int remain,
+                             uint64_t inputsHash);
+    // aidsets not routed to the default route
+    aid_table_t GetProgrammedAidsets(const aid_table_t& routingTable) const;
+    int AddDefaultRouting();
 
 private:
     std::unique_ptr<IAidRoutingPolicy> routingPolicy_;
     std::shared_ptr<AidRoutingAdapter> routingController_;
-    using aid_table_t = std::vector<std::shared_ptr<AidSet>>;
-    aid_table_t aidTable_;
+    // immutable snapshot of the routing table, replaced by std::atomic_store and read without mu_
+    std::shared_ptr<const aid_table_t> aidTable_;
+    std::string optimizerDump_;
+    std::weak_ptr<CardEmulationServiceInfo> primary_;
+    std::weak_ptr<CardEmulationServiceInfo> preferred_;
     std::mutex mu_;
+    // serializes the planning of the callers and the deferred planning
+    std::mutex planMu_;
+    std::shared_ptr<RoutingPlanStore> planStore_;
+    Executor executor_;
+    // increased by every planning, a deferred planning of an older one is dropped
+    uint64_t planGeneration_;
 };
 }  // namespace OHOS::nfc::cardemulation
 #endif  // AID_ROUTING_PLANNER_H
@@ -76,6 +76,17 @@ int CardEmulationAgent::AddAidsForService(int userId,
     }
     return ERR_CARD_EMULATION_SERVICE_NOT_INIT;
 }
+int CardEmulationAgent::AddAidsForService(int userId,
+                                          const OHOS::AppExecFwk::ElementName& elementName,
+                                          std::vector<std::string> aids,
+                                          std::string type,
+                                          std::vector<StaticApduResponse> responses)
+{
+    if (ceService_) {
+        return ceService_->AddAidsForService(userId, elementName, type, aids, responses);
+    }
+    return ERR_CARD_EMULATION_SERVICE_NOT_INIT;
+}
 int CardEmulationAgent::RemoveAidsForService(int userId,
                                              const OHOS::AppExecFwk::ElementName& elementName,
                                              std::string type)
@@ -22,6 +22,7 @@
 #include "card_emulation_util.h"
 #include "element_name.h"
 #include "loghelper.h"
+#include "static_apdu_responder.h"
 
 #ifdef USE_HILOG
 DEFINE_NFC_LOG_LABEL("CardEmulationAgentStub");
@@ -77,6 +78,25 @@ static void ReadServiceName(OHOS::MessageParcel& data, OHOS::AppExecFwk::Element
     }
     return;
 }
+// the responses are appended to the request body, absent when sent by an earlier sdk
+static bool ReadStaticResponses(OHOS::MessageParcel& data, std::vector<StaticApduResponse>& responses)
+{
+    if (data.GetReadableBytes() == 0) {
+        return true;
+    }
+    uint32_t count = data.ReadUint32();
+    if (count > StaticApduResponder::MAX_ENTRY_COUNT) {
+        return false;
+    }
+    responses.resize(count);
+    for (auto& response : responses) {
+        if (!data.ReadUInt8Vector(&response.mask_) || !data.ReadUInt8Vector(&response.value_) ||
+            !data.ReadUInt8Vector(&response.response_)) {
+            return false;
+        }
+    }
+    return true;
+}
 void CardEmulationAgentStub::OnGetServices(OHOS::MessageParcel& data, OHOS::MessageParcel& reply)
 {
     using namespace OHOS::nfc::sdk::cardemulation;
@@ -135,13 +155,17 @@ void CardEmulationAgentStub::OnAddAidsForService(OHOS::MessageParcel& data, OHOS
     std::vector<std::string> aids;
     data.ReadStringVector(&aids);
     std::string type = data.ReadString();
-    OHOS::sptr<OHOS::IRemoteObject> ro(data.ReadParcelable<IRemoteObject>());
+    std::vector<StaticApduResponse> responses;
+    if (!ReadStaticResponses(data, responses)) {
+        WriteHeader(reply, ERR_INVALID_STATIC_RESPONSE);
+        return;
+    }
     DebugLog("AddAidsForService(\n\tuserId: %d, \n\tabilityName: %s, \n\taids: %s, \n\ttype: %s) ",
              userId,
              elementName.GetAbilityName().c_str(),
              StringVectorToString(aids).c_str(),
              type.c_str());
-    auto rv = AddAidsForService(userId, elementName, std::move(aids), std::move(type));
+    auto rv = AddAidsForService(userId, elementName, std::move(aids), std::move(type), std::move(responses));
     DebugLog("AddAidsForService return %d", rv);
     WriteHeader(reply, rv);
 }
@@ -146,4 +146,22 @@ bool CardEmulationDeviceHost::DumpRoutingTable(int fd)
     }
     return s->DumpRoutingTable(fd);
 }
+
+bool CardEmulationDeviceHost::PostTask(std::function<void()> task, int64_t delayMs)
+{
+    auto s = nfcService_.lock();
+    if (!s) {
+        return false;
+    }
+    return s->PostTask(std::move(task), delayMs);
+}
+
+bool CardEmulationDeviceHost::IsNfcEnabled()
+{
+    auto s = nfcService_.lock();
+    if (!s) {
+        return false;
+    }
+    return s->IsNfcEnabled();
+}
 }  // namespace OHOS::nfc::cardemulation
@@ -43,6 +43,8 @@ public:
     bool GetExtendedLengthApdusSupported() override;
     bool SendData(std::vector<unsigned char> data) override;
     bool DumpRoutingTable(int fd) override;
+    bool PostTask(std::function<void()> task, int64_t delayMs) override;
+    bool IsNfcEnabled() override;
 
 private:
     std::weak_ptr<nfc::NfcService> nfcService_;
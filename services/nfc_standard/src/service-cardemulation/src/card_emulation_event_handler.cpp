@@ -15,10 +15,12 @@
 
 #include "card_emulation_event_handler.h"
 
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <sstream>
 
+#include "ability_connection_pool.h"
 #include "ability_connection_stub.h"
 #include "ability_manager_client.h"
 #include "apdu_channel.h"
@@ -31,6 +33,7 @@
 #include "iservice_registry.h"
 #include "loghelper.h"
 #include "string_ex.h"
+#include "utils/hce_latency_tracer.h"
 
 #ifdef USE_HILOG
 DEFINE_NFC_LOG_LABEL("CardEmulationEventHandler");
@@ -53,48 +56,109 @@ enum EN_MSG_HCE {
 
 static const std::vector<unsigned char> UNABLE_TO_HANDLE_AID = {0x6A, 0x82};
 static const std::vector<unsigned char> UNEXPECTED_APDU = {0x6F, 0x00};
+// pinned default and foreground services plus the recently used ones
+static constexpr size_t MAX_WARM_CONNECTION_COUNT = 4;
+
+static std::shared_ptr<AbilityManagerClient> GetAbilityManagerClient()
+{
+    auto amc = AbilityManagerClient::GetInstance();
+    if (amc) {
+        auto err = amc->Connect();
+        if (FAILED(err)) {
+            ErrorLog("fail to connect ability manager!");
+        }
+    }
+    return amc;
+}
+
+// the device id of the element reported by the ability manager may differ from the requested one
+static bool IsSameService(const ElementName& lhs, const ElementName& rhs)
+{
+    return lhs.GetBundleName() == rhs.GetBundleName() && lhs.GetAbilityName() == rhs.GetAbilityName();
+}
+
+static bool ConnectWarmAbility(const ElementName& name, const OHOS::sptr<AbilityConnectionStub>& connection)
+{
+    auto amc = GetAbilityManagerClient();
+    if (!amc) {
+        ErrorLog("AbilityManagerClient::GetInstance() return nullptr!");
+        return false;
+    }
+    Want want;
+    want.SetElement(name);
+    return !FAILED(amc->ConnectAbility(want, connection, OHOS::sptr<OHOS::IRemoteObject>()));
+}
+
+static void DisconnectWarmAbility(const OHOS::sptr<AbilityConnectionStub>& connection)
+{
+    auto amc = GetAbilityManagerClient();
+    if (amc) {
+        amc->DisconnectAbility(connection);
+    }
+}
 
 CardEmulationEventHandler::CardEmulationEventHandler(std::shared_ptr<ICardEmulationDeviceHost> ceDeviceHost,
                                                      std::shared_ptr<IAidRoutingManager> aidRoutingManager)
     : aidRoutingManager_(aidRoutingManager),
     state_(EventHandlerState::IDLE),
-    ceDeviceHost_(ceDeviceHost)
+    ceDeviceHost_(ceDeviceHost),
+    connectionPool_(
+        std::make_shared<AbilityConnectionPool>(MAX_WARM_CONNECTION_COUNT, ConnectWarmAbility, DisconnectWarmAbility))
 {
+    // the normal connections of the services are made by the pool
+    connectionPool_->SetObserver(
+        [this](const ElementName& element, const OHOS::sptr<OHOS::IRemoteObject>& remoteObject) {
+            OnAbilityConnected(element, remoteObject, false);
+        },
+        [this](const ElementName& element) { OnAbilityDisconnected(element, false); });
 }
 
-CardEmulationEventHandler::~CardEmulationEventHandler() = default;
+CardEmulationEventHandler::~CardEmulationEventHandler()
+{
+    // the pool may be kept by the death recipients of its connections
+    connectionPool_->SetObserver(nullptr, nullptr);
+}
 
 void CardEmulationEventHandler::OnHCEActivated(void)
 {
-    std::lock_guard<std::mutex> lock(mu_);
     CloseTapAgainDialog();
     state_ = EventHandlerState::WAIT_FOR_SELECT_AID;
 }
 
 int CardEmulationEventHandler::OnHCEData(const unsigned char* data, size_t len)
 {
+    HceLatencyTracer::GetInstance().Mark(HceStage::DISPATCHED);
     auto aid = FindSelectAid(data, len);
+    EventHandlerState state = state_;
 #ifdef USE_HILOG
 
     DebugLog("FindSelectAid: %{public}s", aid.c_str());
-    InfoLog("OnHCEData:\n\t0x%{public}s\n\t state: %{public}d", BytesToHexStr(data, len).c_str(), StateToInt(state_));
 #else
     DebugLog("FindSelectAid: %s", aid.c_str());
-    InfoLog("OnHCEData:\n\t0x%s\n\t state: %d", BytesToHexStr(data, len).c_str(), StateToInt(state_));
 #endif
+    // the apdu is formatted only when it is logged
+    if (IsInfoLogEnabled()) {
+#ifdef USE_HILOG
+        InfoLog("OnHCEData:\n\t0x%{public}s\n\t state: %{public}d",
+                BytesToHexStr(data, len).c_str(),
+                StateToInt(state));
+#else
+        InfoLog("OnHCEData:\n\t0x%s\n\t state: %d", BytesToHexStr(data, len).c_str(), StateToInt(state));
+#endif
+    }
 
-    std::lock_guard<std::mutex> lock(mu_);
-    if (state_ == EventHandlerState::IDLE) {
+    if (state == EventHandlerState::IDLE) {
         SendDataToReader(UNEXPECTED_APDU);
         return ERR_DROP_HCE_EVENT_DATA;
     }
-    if (state_ == EventHandlerState::WAIT_FOR_DEACTIVE) {
+    if (state == EventHandlerState::WAIT_FOR_DEACTIVE) {
         SendDataToReader(UNEXPECTED_APDU);
         return ERR_DROP_HCE_EVENT_DATA;
     }
     std::string resolvedAidsetType;
     std::shared_ptr<CardEmulationServiceInfo> resolvedServiceInfo;
     if (!aid.empty()) {
+        // resolved from the routing snapshot, no lock is taken
         auto ceServices = aidRoutingManager_->GetCardEmulationServicesByAid(aid);
 #ifdef USE_HILOG
 
@@ -103,8 +167,10 @@ int CardEmulationEventHandler::OnHCEData(const unsigned char* data, size_t len)
         DebugLog("ceServiceNames.size(): %zu", ceServices.size());
 #endif
 
+        HceLatencyTracer::GetInstance().Mark(HceStage::AID_RESOLVED);
         if (ceServices.empty()) {
             // not found service
+            HceLatencyTracer::GetInstance().SetService("");
             SendDataToReader(UNABLE_TO_HANDLE_AID);
             return ERR_DROP_HCE_EVENT_DATA;
         } else {
@@ -113,15 +179,30 @@ int CardEmulationEventHandler::OnHCEData(const unsigned char* data, size_t len)
             resolvedAidsetType = ceServices.front().second;
             DebugLog("resolved service: %p", resolvedServiceInfo.get());
             if (!resolvedServiceInfo) {
+                HceLatencyTracer::GetInstance().SetService("");
                 SendDataToReader(UNABLE_TO_HANDLE_AID);
                 return ERR_DROP_HCE_EVENT_DATA;
             }
+            // the following apdus of the transaction are attributed to the selected service
+            auto name = resolvedServiceInfo->GetName();
+            HceLatencyTracer::GetInstance().SetService(name ? name->GetURI() : "");
+        }
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            lastSelectAid_ = aid;
+        }
+        if (state == EventHandlerState::WAIT_FOR_SELECT_AID || state == EventHandlerState::TRANSFERRING) {
+            SetSelectedService(resolvedServiceInfo, resolvedAidsetType);
         }
-        lastSelectAid_ = aid;
     }
-    switch (state_) {
+    switch (state) {
         case EventHandlerState::WAIT_FOR_SELECT_AID:
             if (aid.empty()) {
+            } else if (RespondStatically(resolvedServiceInfo, data, len)) {
+                // the following apdus are not for the application of a previous transaction
+                SetActiveService(nullptr);
+                state_ = EventHandlerState::TRANSFERRING;
+                return ERR_OK;
             } else {
                 HandleDataInWaitForSelectState(resolvedServiceInfo, resolvedAidsetType, data, len);
                 return ERR_OK;
@@ -131,18 +212,34 @@ int CardEmulationEventHandler::OnHCEData(const unsigned char* data, size_t len)
             // drop data
             DebugLog("dropping apdu. reason: waiting for connect ability .");
             break;
-        case EventHandlerState::TRANSFERRING:
+        case EventHandlerState::TRANSFERRING: {
             if (!aid.empty()) {
+                if (RespondStatically(resolvedServiceInfo, data, len)) {
+                    // the application of the previous select does not see the new one
+                    NotifyActiveCEServiceDeactive(EN_DEACTIVATION_REASON::DESELECTED);
+                    SetActiveService(nullptr);
+                    return ERR_OK;
+                }
                 HandleDataInWaitForSelectState(resolvedServiceInfo, resolvedAidsetType, data, len);
                 return ERR_OK;
+            }
+            std::string selectedType;
+            auto selected = GetSelectedService(selectedType);
+            if (RespondStatically(selected, data, len)) {
+                return ERR_OK;
             } else if (IsActiveServiceValid()) {
                 DebugLog("aid is empty, send data to active service. state: TRANSFERRING");
                 SendDataToCeService(GetActiveService(), data, len);
                 return ERR_OK;
+            } else if (selected) {
+                // the select was answered statically, the application is connected on its first apdu
+                HandleDataInWaitForSelectState(selected, selectedType, data, len);
+                return ERR_OK;
             } else {
                 DebugLog("dropping apdu. reason: service no longer active.");
             }
             break;
+        }
         default:
 
             break;
@@ -154,24 +251,33 @@ int CardEmulationEventHandler::OnHCEData(const unsigned char* data, size_t len)
 
 void CardEmulationEventHandler::OnHCEDeactivated(void)
 {
-    std::lock_guard<std::mutex> lock(mu_);
+    HceLatencyTracer::GetInstance().Deactivate();
     NotifyActiveCEServiceDeactive(EN_DEACTIVATION_REASON::LINK_LOSS);
+    SetActiveService(nullptr);
 
-    state_ = EventHandlerState::IDLE;
+    SetSelectedService(nullptr, std::string());
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        selectApdu_.clear();
+        state_ = EventHandlerState::IDLE;
+    }
+    // connected before the next transaction
+    ScheduleWarmPinnedServices();
 }
 
 void CardEmulationEventHandler::OnOffHostTransaction(void)
 {
-    std::lock_guard<std::mutex> lock(mu_);
     if (state_ == EventHandlerState::TRANSFERRING) {
         NotifyActiveCEServiceDeactive(EN_DEACTIVATION_REASON::DESELECTED);
     }
+    SetActiveService(nullptr);
     state_ = EventHandlerState::WAIT_FOR_SELECT_AID;
+    SetSelectedService(nullptr, std::string());
     CloseTapAgainDialog();
 }
 void CardEmulationEventHandler::OnRemoteDied(const wptr<IRemoteObject>& object)
 {
-    std::lock_guard<std::mutex> lock(mu_);
+    std::lock_guard<std::mutex> lock(connectionMu_);
 
     if (preferredService_ == object) {
         DebugLog("normal service died");
@@ -183,96 +289,121 @@ void CardEmulationEventHandler::OnRemoteDied(const wptr<IRemoteObject>& object)
         primaryServiceName_ = ElementName();
     }
 }
+
+void CardEmulationEventHandler::OnAbilityConnected(const OHOS::AppExecFwk::ElementName& element,
+                                                   const OHOS::sptr<OHOS::IRemoteObject>& remoteObject,
+                                                   bool secure)
+{
+    OHOS::sptr<IApduChannel> service = OHOS::sptr<ApduChannelProxy>(new ApduChannelProxy(remoteObject));
+    if (secure) {
+        std::lock_guard<std::mutex> lock(connectionMu_);
+        if (!(element == expectedPrimaryServiceName_)) {
+            return;
+        }
+        primaryService_ = service;
+        primaryServiceName_ = element;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(connectionMu_);
+        preferredService_ = service;
+        preferredServiceName_ = element;
+        connectionState_ = ConnectionState::Connected;
+    }
+    std::vector<unsigned char> selectApdu;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        // the pool also connects the pinned services, the select waits for its own service
+        if (!selectApdu_.empty() && IsSameService(element, selectServiceName_)) {
+            selectApdu.swap(selectApdu_);
+            state_ = EventHandlerState::TRANSFERRING;
+        }
+    }
+    if (!selectApdu.empty()) {
+        SendDataToCeService(service, &selectApdu[0], selectApdu.size());
+    }
+}
+
+void CardEmulationEventHandler::OnAbilityDisconnected(const OHOS::AppExecFwk::ElementName& element, bool secure)
+{
+    std::lock_guard<std::mutex> lock(connectionMu_);
+    if (secure) {
+        if (element == primaryServiceName_) {
+            DisconnectPrimaryService();
+        }
+    } else if (element == preferredServiceName_) {
+        DisconnectNormalService();
+        connectionState_ = ConnectionState::Disconnected;
+    }
+}
+
 void CardEmulationEventHandler::SendDataToCeService(const OHOS::sptr<sdk::cardemulation::IApduChannel>& service,
                                                     const unsigned char* data,
                                                     size_t len)
 {
-    if (activeHCEService_ != service) {
+    if (GetActiveService() != service) {
         NotifyActiveCEServiceDeactive(EN_DEACTIVATION_REASON::DESELECTED);
-        activeHCEService_ = service;
+        SetActiveService(service);
     }
-    auto msg = std::make_unique<Msg>(EN_MSG_HCE::COMMAND_APDU, 0, 0);
-    msg->SetData(std::vector<unsigned char>(data, data + len));
-    if (!apduChannel_) {
-        apduChannel_ = OHOS::sptr<ApduChannelStub>(new ApduChannelStub());
-        apduChannel_->SetHandler([this](std::unique_ptr<Msg> msg1) { HandleApduResponse(std::move(msg1)); });
-    }
-    msg->SetSource(RemoteObjectPool::GetRemoteObject(apduChannel_->AsObject()));
+    auto msg = MsgPool::Obtain(EN_MSG_HCE::COMMAND_APDU, 0, 0);
+    msg->SetData(data, len);
+    msg->SetSource(RemoteObjectPool::GetRemoteObject(GetApduChannel()->AsObject()));
+    if (IsDebugLogEnabled()) {
 #ifdef USE_HILOG
-
-    DebugLog("SendDataToCeService:\n\tId %{public}d, Arg1: %{public}d, Arg2: %{public}d\n\t=>Apdu: %{public}s",
-             msg->Id(),
-             msg->Arg1(),
-             msg->Arg2(),
-             OHOS::nfc::cardemulation::BytesToHexStr(msg->GetData()).c_str());
+        DebugLog("SendDataToCeService:\n\tId %{public}d, Arg1: %{public}d, Arg2: %{public}d\n\t=>Apdu: %{public}s",
+                 msg->Id(),
+                 msg->Arg1(),
+                 msg->Arg2(),
+                 OHOS::nfc::cardemulation::BytesToHexStr(msg->GetData()).c_str());
 #else
-    DebugLog("SendDataToCeService:\n\tId %d, Arg1: %d, Arg2: %d\n\t=>Apdu: %s",
-             msg->Id(),
-             msg->Arg1(),
-             msg->Arg2(),
-             OHOS::nfc::cardemulation::BytesToHexStr(msg->GetData()).c_str());
+        DebugLog("SendDataToCeService:\n\tId %d, Arg1: %d, Arg2: %d\n\t=>Apdu: %s",
+                 msg->Id(),
+                 msg->Arg1(),
+                 msg->Arg2(),
+                 OHOS::nfc::cardemulation::BytesToHexStr(msg->GetData()).c_str());
 #endif
+    }
     auto activeService = GetActiveService();
     if (activeService) {
+        HceLatencyTracer::GetInstance().Mark(HceStage::SENT_TO_APP);
         activeService->Send(std::move(msg));
         return;
     }
     ErrorLog("active service no longer valid.");
-}
-
-OHOS::sptr<sdk::cardemulation::IApduChannel> CardEmulationEventHandler::ConnectAbility(
-    int userId,
-    const std::shared_ptr<OHOS::AppExecFwk::ElementName>& elementName)
-{
-    auto rv = HandleConnectAbility(userId, elementName);
-    if (rv) {
-        return rv;
-    }
-    return HandleDisconnectAbility(userId, elementName);
+    MsgPool::Recycle(std::move(msg));
 }
 
 OHOS::sptr<sdk::cardemulation::IApduChannel> CardEmulationEventHandler::HandleConnectAbility(
     int userId,
     const std::shared_ptr<OHOS::AppExecFwk::ElementName>& elementName)
 {
-    if (primaryServiceName_ == *elementName) {
-        return primaryService_;
-    }
-    if (preferredServiceName_ == *elementName) {
-        return preferredService_;
-    }
-    return OHOS::sptr<sdk::cardemulation::IApduChannel>();
-}
-
-static std::shared_ptr<AbilityManagerClient> GetAbilityManagerClient()
-{
-    auto amc = AbilityManagerClient::GetInstance();
-    if (amc) {
-        auto err = amc->Connect();
-        if (FAILED(err)) {
-            ErrorLog("fail to connect ability manager!");
+    {
+        std::lock_guard<std::mutex> lock(connectionMu_);
+        if (primaryServiceName_ == *elementName) {
+            return primaryService_;
+        }
+        if (preferredServiceName_ == *elementName) {
+            return preferredService_;
         }
     }
-    return amc;
+    return connectionPool_->Acquire(*elementName);
 }
+
 OHOS::sptr<sdk::cardemulation::IApduChannel> CardEmulationEventHandler::HandleDisconnectAbility(
     int userId,
     const std::shared_ptr<OHOS::AppExecFwk::ElementName>& elementName)
 {
     if (elementName) {
-        auto amc = GetAbilityManagerClient();
-        if (!amc) {
-            ErrorLog("AbilityManagerClient::GetInstance() return nullptr!");
-            return OHOS::sptr<sdk::cardemulation::IApduChannel>();
+        {
+            std::lock_guard<std::mutex> lock(connectionMu_);
+            connectionState_ = ConnectionState::Connecting;
         }
-        CreateNormalServiceConnection();
-        Want want;
-        want.SetElement(*elementName);
-        auto err = amc->ConnectAbility(want, normalConnectionObserver_, OHOS::sptr<OHOS::IRemoteObject>());
-        if (FAILED(err)) {
+        // kept warm as a recently used service, the next transaction does not wait for connecting.
+        // the callbacks of the connection may arrive before returning, no lock is held here
+        if (!connectionPool_->Warm(*elementName, WarmReason::RECENT)) {
             ErrorLog("fail to connect ability. URI: %s ", elementName->GetURI().c_str());
-        } else {
-            connectionState_ = ConnectionState::Connecting;
+            std::lock_guard<std::mutex> lock(connectionMu_);
+            connectionState_ = ConnectionState::Disconnected;
         }
     }
     return OHOS::sptr<sdk::cardemulation::IApduChannel>();
@@ -292,51 +423,18 @@ void CardEmulationEventHandler::DisconnectNormalService()
 
 void CardEmulationEventHandler::CreateSecureServiceConnection()
 {
+    auto amc = GetAbilityManagerClient();
+    if (!amc) {
+        ErrorLog("AbilityManagerClient::GetInstance() return nullptr!");
+        return;
+    }
+    std::lock_guard<std::mutex> lock(connectionMu_);
     if (!secureConnectionObserver_) {
-        auto amc = GetAbilityManagerClient();
-        if (!amc) {
-            ErrorLog("AbilityManagerClient::GetInstance() return nullptr!");
-            return;
-        }
-
         secureConnectionObserver_ = OHOS::sptr<AbilityConnectionStub>(new AbilityConnectionStub(
             [this](const OHOS::AppExecFwk::ElementName& element, const OHOS::sptr<OHOS::IRemoteObject>& remoteObject) {
-                std::lock_guard<std::mutex> lock(mu_);
-
-                if (!(element == expectedPrimaryServiceName_)) {
-                    return;
-                }
-                primaryService_ = OHOS::sptr<ApduChannelProxy>(new ApduChannelProxy(remoteObject));
-                primaryServiceName_ = element;
-            },
-            [this](const AppExecFwk::ElementName& element) {
-                std::lock_guard<std::mutex> lock(mu_);
-                if (element == primaryServiceName_) {
-                    DisconnectPrimaryService();
-                }
-            }));
-    }
-}
-
-void CardEmulationEventHandler::CreateNormalServiceConnection()
-{
-    if (!normalConnectionObserver_) {
-        normalConnectionObserver_ = OHOS::sptr<AbilityConnectionStub>(new AbilityConnectionStub(
-            [this](const OHOS::AppExecFwk::ElementName& element, const OHOS::sptr<OHOS::IRemoteObject>& remoteObject) {
-                std::lock_guard<std::mutex> lock(mu_);
-                preferredService_ = OHOS::sptr<ApduChannelProxy>(new ApduChannelProxy(remoteObject));
-                preferredServiceName_ = element;
-                if (!selectApdu_.empty()) {
-                    state_ = EventHandlerState::TRANSFERRING;
-                    SendDataToCeService(preferredService_, &selectApdu_[0], selectApdu_.size());
-                }
+                OnAbilityConnected(element, remoteObject, true);
             },
-            [this](const AppExecFwk::ElementName& element) {
-                std::lock_guard<std::mutex> lock(mu_);
-                if (element == preferredServiceName_) {
-                    DisconnectNormalService();
-                }
-            }));
+            [this](const AppExecFwk::ElementName& element) { OnAbilityDisconnected(element, true); }));
     }
 }
 
@@ -355,8 +453,7 @@ void CardEmulationEventHandler::NotifyActiveCEServiceDeactive(int reason)
     if (!service) {
         return;
     }
-    auto msg = std::make_unique<Msg>(EN_MSG_HCE::DEACTIVATED, 0, 0);
-    msg->SetArg1(reason);
+    auto msg = MsgPool::Obtain(EN_MSG_HCE::DEACTIVATED, reason, 0);
     service->Send(std::move(msg));
 }
 void CardEmulationEventHandler::LaunchTapAgainDialog()
@@ -392,31 +489,32 @@ void CardEmulationEventHandler::HandleDataInWaitForSelectState(
 #else
         DebugLog("connect ability, type: %s", aidsetType.c_str());
 #endif
-        channel = ConnectAbility(GetCurrentUserId(), serviceInfo->GetName());
+        channel = HandleConnectAbility(GetCurrentUserId(), serviceInfo->GetName());
     }
     if (channel) {
         state_ = EventHandlerState::TRANSFERRING;
 
-        activeHCEService_ = channel;
+        SetActiveService(channel);
         SendDataToCeService(channel, data, len);
+        if (IsDebugLogEnabled()) {
 #ifdef USE_HILOG
-
-        DebugLog("state: %{public}d, send apdu: %{public}s",
-                 static_cast<int>(state_),
-                 BytesToHexStr(std::vector<unsigned char>(data, data + len)).c_str());
-
+            DebugLog("state: %{public}d, send apdu: %{public}s", StateToInt(state_), BytesToHexStr(data, len).c_str());
 #else
-        DebugLog("state: %d, send apdu: %s",
-                 static_cast<int>(state_),
-                 BytesToHexStr(std::vector<unsigned char>(data, data + len)).c_str());
-
+            DebugLog("state: %d, send apdu: %s", StateToInt(state_), BytesToHexStr(data, len).c_str());
 #endif
+        }
     } else {
-        selectApdu_ = std::vector<unsigned char>(data, data + len);
-        state_ = EventHandlerState::WAIT_FOR_CONNECT_ABILITY;
+        // kept before connecting, the connection may be done before ConnectAbility returns
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            selectApdu_ = std::vector<unsigned char>(data, data + len);
+            selectServiceName_ = serviceInfo->GetName() ? *serviceInfo->GetName() : ElementName();
+            state_ = EventHandlerState::WAIT_FOR_CONNECT_ABILITY;
+        }
 
         DebugLog("channel is nullptr. wait for connect ability......");
         SendDataToReader(UNABLE_TO_HANDLE_AID);
+        HandleDisconnectAbility(GetCurrentUserId(), serviceInfo->GetName());
     }
 }
 
@@ -428,38 +526,39 @@ void CardEmulationEventHandler::SendDataToReader(std::vector<unsigned char> data
 {
     auto dh = ceDeviceHost_.lock();
     if (dh) {
+        if (IsDebugLogEnabled()) {
 #ifdef USE_HILOG
-
-        DebugLog("send data to device host,data: \n\t<=Resp: 0x%{public}s", BytesToHexStr(data).c_str());
+            DebugLog("send data to device host,data: \n\t<=Resp: 0x%{public}s", BytesToHexStr(data).c_str());
 #else
-        DebugLog("send data to device host,data: \n\t<=Resp: 0x%s", BytesToHexStr(data).c_str());
+            DebugLog("send data to device host,data: \n\t<=Resp: 0x%s", BytesToHexStr(data).c_str());
 #endif
+        }
 
         dh->SendData(std::move(data));
     }
+    HceLatencyTracer::GetInstance().End();
 }
+// runs on the apdu channel thread, no lock is taken
 void CardEmulationEventHandler::HandleApduResponse(std::unique_ptr<sdk::cardemulation::Msg> msg)
 {
-    {
-        std::lock_guard<std::mutex> lock(mu_);
-        auto service = GetActiveService();
-        if (service) {
-            if (!msg->EqualsReplyRemoteObject(RemoteObjectPool::GetRemoteObject(service->AsObject()))) {
-                DebugLog("drop reponse. reason: msg source service does not equal active service.");
-                SendDataToReader(UNABLE_TO_HANDLE_AID);
+    HceLatencyTracer::GetInstance().Mark(HceStage::APP_RESPONDED);
+    auto service = GetActiveService();
+    if (service) {
+        if (!msg->EqualsReplyRemoteObject(RemoteObjectPool::GetRemoteObject(service->AsObject()))) {
+            DebugLog("drop reponse. reason: msg source service does not equal active service.");
+            MsgPool::Recycle(std::move(msg));
+            SendDataToReader(UNABLE_TO_HANDLE_AID);
 
-                return;
-            }
+            return;
         }
     }
-    switch (msg->Id()) {
+    int id = msg->Id();
+    // the response is moved to the device host, the message goes back to the pool
+    auto data = msg->TakeData();
+    MsgPool::Recycle(std::move(msg));
+    switch (id) {
         case EN_MSG_HCE::RESPONSE_APDU: {
-            auto data = msg->GetData();
-            EventHandlerState state;
-            {
-                std::lock_guard<std::mutex> lock(mu_);
-                state = state_;
-            }
+            EventHandlerState state = state_;
             if (state == EventHandlerState::TRANSFERRING) {
                 SendDataToReader(std::move(data));
                 return;
@@ -484,11 +583,86 @@ void CardEmulationEventHandler::HandleApduResponse(std::unique_ptr<sdk::cardemul
 }
 bool CardEmulationEventHandler::IsActiveServiceValid()
 {
-    auto service = activeHCEService_.promote();
+    auto service = GetActiveService();
     return service.GetRefPtr() != nullptr;
 }
 OHOS::sptr<sdk::cardemulation::IApduChannel> CardEmulationEventHandler::GetActiveService()
 {
-    return activeHCEService_.promote();
+    auto active = std::atomic_load(&activeHCEService_);
+    if (!active) {
+        return OHOS::sptr<sdk::cardemulation::IApduChannel>();
+    }
+    return active->promote();
+}
+void CardEmulationEventHandler::SetActiveService(const OHOS::sptr<sdk::cardemulation::IApduChannel>& service)
+{
+    std::atomic_store(&activeHCEService_,
+                      std::make_shared<const OHOS::wptr<sdk::cardemulation::IApduChannel>>(service));
+}
+std::shared_ptr<CardEmulationServiceInfo> CardEmulationEventHandler::GetSelectedService(std::string& aidsetType)
+{
+    auto selected = std::atomic_load(&selectedService_);
+    if (!selected) {
+        return std::shared_ptr<CardEmulationServiceInfo>();
+    }
+    aidsetType = selected->aidsetType_;
+    return selected->serviceInfo_.lock();
+}
+void CardEmulationEventHandler::SetSelectedService(const std::shared_ptr<CardEmulationServiceInfo>& serviceInfo,
+                                                   const std::string& aidsetType)
+{
+    std::atomic_store(&selectedService_,
+                      serviceInfo ? std::make_shared<const SelectedService>(SelectedService{serviceInfo, aidsetType})
+                                  : std::shared_ptr<const SelectedService>());
+}
+bool CardEmulationEventHandler::RespondStatically(const std::shared_ptr<CardEmulationServiceInfo>& serviceInfo,
+                                                  const unsigned char* data,
+                                                  size_t len)
+{
+    std::vector<unsigned char> response;
+    if (!serviceInfo || !serviceInfo->RespondStatically(data, len, response)) {
+        return false;
+    }
+    DebugLog("answered by the static response of the service");
+    SendDataToReader(std::move(response));
+    return true;
+}
+OHOS::sptr<sdk::cardemulation::ApduChannelStub> CardEmulationEventHandler::GetApduChannel()
+{
+    std::call_once(apduChannelOnce_, [this]() {
+        apduChannel_ = OHOS::sptr<ApduChannelStub>(new ApduChannelStub());
+        apduChannel_->SetHandler([this](std::unique_ptr<Msg> msg) { HandleApduResponse(std::move(msg)); });
+    });
+    return apduChannel_;
+}
+void CardEmulationEventHandler::WarmPinnedServices()
+{
+    auto toNames = [](const std::shared_ptr<CardEmulationServiceInfo>& service) {
+        std::vector<ElementName> names;
+        if (service && service->GetName() && StringEqual(service->GetExecutionEnvironment(), NFC_EE_HOST)) {
+            names.push_back(*service->GetName());
+        }
+        return names;
+    };
+    connectionPool_->SetPinned(toNames(aidRoutingManager_->GetPrimaryService()),
+                               toNames(aidRoutingManager_->GetPreferredService()));
+}
+std::string CardEmulationEventHandler::Dump()
+{
+    return connectionPool_->Dump();
+}
+void CardEmulationEventHandler::ScheduleWarmPinnedServices()
+{
+    auto dh = ceDeviceHost_.lock();
+    std::weak_ptr<CardEmulationEventHandler> self = weak_from_this();
+    auto task = [self]() {
+        auto handler = self.lock();
+        if (handler) {
+            handler->WarmPinnedServices();
+        }
+    };
+    if (!dh || !dh->PostTask(task, 0)) {
+        DebugLog("warming the pinned services is not posted");
+    }
 }
 }  // namespace OHOS::nfc::cardemulation
@@ -18,6 +18,7 @@
 
 #include <iremote_object.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -35,6 +36,7 @@ class ApduChannelStub;
 }  // namespace sdk::cardemulation
 namespace cardemulation {
 class AbilityConnectionStub;
+class AbilityConnectionPool;
 
 class CardEmulationEventHandler : public std::enable_shared_from_this<CardEmulationEventHandler>,
                                   public OHOS::IRemoteObject::DeathRecipient {
@@ -48,6 +50,15 @@ public:
     void OnOffHostTransaction(void);
 
     void OnRemoteDied(const wptr<IRemoteObject>& object) override;
+    // callbacks of the ability connections
+    void OnAbilityConnected(const OHOS::AppExecFwk::ElementName& element,
+                            const OHOS::sptr<OHOS::IRemoteObject>& remoteObject,
+                            bool secure);
+    void OnAbilityDisconnected(const OHOS::AppExecFwk::ElementName& element, bool secure);
+    // warm ability connections
+    std::string Dump();
+    // warms the pinned services on the handler of the nfc service, not on the apdu path
+    void ScheduleWarmPinnedServices();
 
 private:
     enum class EventHandlerState {
@@ -64,10 +75,6 @@ private:
                              const unsigned char* data,
                              size_t len);
 
-    // 连接 ElementName
-    OHOS::sptr<sdk::cardemulation::IApduChannel> ConnectAbility(
-        int userId,
-        const std::shared_ptr<OHOS::AppExecFwk::ElementName>& elementName);
     OHOS::sptr<sdk::cardemulation::IApduChannel> HandleConnectAbility(
         int userId,
         const std::shared_ptr<OHOS::AppExecFwk::ElementName>& elementName);
@@ -77,7 +84,6 @@ private:
     void DisconnectPrimaryService();
     void DisconnectNormalService();
     void CreateSecureServiceConnection();
-    void CreateNormalServiceConnection();
 
     void HandleApduResponse(std::unique_ptr<sdk::cardemulation::Msg> msg);
     void NotifyActiveCEServiceDeactive(int reason);
@@ -92,11 +98,26 @@ private:
     void SendDataToReader(std::vector<unsigned char> data);
     bool IsActiveServiceValid();
     OHOS::sptr<sdk::cardemulation::IApduChannel> GetActiveService();
+    void SetActiveService(const OHOS::sptr<sdk::cardemulation::IApduChannel>& service);
+    // the service of the last select, its static responses answer the following apdus
+    std::shared_ptr<CardEmulationServiceInfo> GetSelectedService(std::string& aidsetType);
+    void SetSelectedService(const std::shared_ptr<CardEmulationServiceInfo>& serviceInfo,
+                            const std::string& aidsetType);
+    // answers the apdu from the static responses of the service, without IPC
+    bool RespondStatically(const std::shared_ptr<CardEmulationServiceInfo>& serviceInfo,
+                           const unsigned char* data,
+                           size_t len);
+    OHOS::sptr<sdk::cardemulation::ApduChannelStub> GetApduChannel();
+    // keeps the default and the foreground hce services connected
+    void WarmPinnedServices();
 
 private:
     std::shared_ptr<IAidRoutingManager> aidRoutingManager_{};
+    // guards the pending select apdu. never held during IPC.
     std::mutex mu_{};
-    EventHandlerState state_;
+    std::atomic<EventHandlerState> state_;
+    // guards the connected services. never held during IPC.
+    std::mutex connectionMu_{};
     OHOS::AppExecFwk::ElementName primaryServiceName_{};
     OHOS::sptr<sdk::cardemulation::IApduChannel> primaryService_{};
     OHOS::AppExecFwk::ElementName expectedPrimaryServiceName_{};
@@ -105,16 +126,26 @@ private:
     OHOS::sptr<sdk::cardemulation::IApduChannel> preferredService_{};
 
     OHOS::AppExecFwk::ElementName activeHCEServiceName_{};
-    OHOS::wptr<sdk::cardemulation::IApduChannel> activeHCEService_{};
+    // replaced by std::atomic_store, the apdu path reads it without locking
+    std::shared_ptr<const OHOS::wptr<sdk::cardemulation::IApduChannel>> activeHCEService_{};
+    struct SelectedService {
+        std::weak_ptr<CardEmulationServiceInfo> serviceInfo_;
+        std::string aidsetType_;
+    };
+    // replaced by std::atomic_store like the active service
+    std::shared_ptr<const SelectedService> selectedService_{};
+    std::once_flag apduChannelOnce_{};
     OHOS::sptr<sdk::cardemulation::ApduChannelStub> apduChannel_{};
     enum ConnectionState { Disconnected, Connecting, Connected };
     ConnectionState connectionState_{Disconnected};
     OHOS::sptr<AbilityConnectionStub> secureConnectionObserver_;
-    OHOS::sptr<AbilityConnectionStub> normalConnectionObserver_;
 
     std::string lastSelectAid_{};
     std::vector<unsigned char> selectApdu_{};
+    // the service the pending select apdu waits for
+    OHOS::AppExecFwk::ElementName selectServiceName_{};
     std::weak_ptr<ICardEmulationDeviceHost> ceDeviceHost_{};
+    std::shared_ptr<AbilityConnectionPool> connectionPool_{};
 };
 }  // namespace cardemulation
 }  // namespace OHOS::nfc
@@ -83,18 +83,20 @@ void CardEmulationManager::OnHostCardEmulationActivated(int technology)
 void CardEmulationManager::OnHostCardEmulationData(int technology, const std::string& data)
 {
     if (technology == TECH_HCE_APDU) {
-        auto bytes = StringToBytes(data);
+        // the apdu is read in place from the reassembly buffer of the device host
+        auto bytes = reinterpret_cast<const unsigned char*>(data.data());
+        if (IsDebugLogEnabled()) {
 #ifdef USE_HILOG
-        DebugLog("OnHostCardEmulationData:\n\t%{public}s\n", BytesToHexStr(bytes).c_str());
-
+            DebugLog("OnHostCardEmulationData:\n\t%{public}s\n", BytesToHexStr(bytes, data.size()).c_str());
 #else
-        DebugLog("OnHostCardEmulationData:\n\t%s\n", BytesToHexStr(bytes).c_str());
+            DebugLog("OnHostCardEmulationData:\n\t%s\n", BytesToHexStr(bytes, data.size()).c_str());
 #endif
+        }
 
-        if (bytes.empty()) {
+        if (data.empty()) {
             return;
         }
-        ceService_->OnHCEData(&bytes[0], bytes.size());
+        ceService_->OnHCEData(bytes, data.size());
     }
 }
 
@@ -123,4 +125,9 @@ void nfc::cardemulation::CardEmulationManager::OnSecureNfcToggled()
 {
     ceService_->OnSecureNfcToggled();
 }
+
+void nfc::cardemulation::CardEmulationManager::Dump(int fd)
+{
+    ceService_->Dump(fd);
+}
 }  // namespace OHOS::nfc::cardemulation
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include <vector>
 
 #include "aid_routing_adapter.h"
@@ -31,6 +32,8 @@
 #include "element_name.h"
 #include "icard_emulation_device_host.h"
 #include "loghelper.h"
+#include "routing_plan_store.h"
+#include "utils/hce_latency_tracer.h"
 #ifdef USE_HILOG
 DEFINE_NFC_LOG_LABEL("CardEmulationService");
 #endif
@@ -62,12 +65,30 @@ int nfc::cardemulation::CardEmulationService::Init()
     auto policy = RoutingPolicyFactory().CreateRoutingPolicy(supportedExecEnv, mode, CARDEMULATION_SERVICE_TYPE_SECURE);
     aidRoutingPlanner_ = std::make_shared<AidRoutingPlanner>(std::move(policy), aidRoutingAdapter_);
 
-    serviceInfoManager_ =
-        std::make_shared<CardEmulationServiceInfoManager>(aidRoutingPlanner_, std::make_shared<CeServiceGetter>());
+    auto serviceGetter = std::make_shared<CeServiceGetter>();
+    std::weak_ptr<ICardEmulationDeviceHost> deviceHost = ceDeviceHost_;
+    aidRoutingPlanner_->SetPlanStore(std::make_shared<RoutingPlanStore>(serviceGetter->GetRoutingPlanPath()),
+                                     [deviceHost](std::function<void()> task) {
+                                         // the planner is locked by the caller, the task is never run inline
+                                         auto host = deviceHost.lock();
+                                         if (!host || !host->PostTask(task, 0)) {
+                                             WarnLog("deferred routing planning is not posted");
+                                         }
+                                     });
+    serviceInfoManager_ = std::make_shared<CardEmulationServiceInfoManager>(aidRoutingPlanner_, serviceGetter);
+    serviceInfoManager_->SetPackageUpdateScheduler(
+        [deviceHost](std::function<void()> task, std::chrono::milliseconds delay) {
+            auto host = deviceHost.lock();
+            if (!host || !host->PostTask(task, delay.count())) {
+                task();
+            }
+        },
+        CardEmulationServiceInfoManager::PACKAGE_UPDATE_WINDOW);
 
     auto rv = serviceInfoManager_->Init();
 
     eventHandler_ = std::make_shared<CardEmulationEventHandler>(ceDeviceHost_, aidRoutingPlanner_);
+    eventHandler_->ScheduleWarmPinnedServices();
     inited_ = true;
     return rv;
 }
@@ -110,6 +131,19 @@ int CardEmulationService::AddAidsForService(int userId,
     return serviceInfoManager_->AddAidSet(userId, elementName, type, aidSet);
 }
 
+int CardEmulationService::AddAidsForService(int userId,
+                                            const OHOS::AppExecFwk::ElementName& elementName,
+                                            const std::string& type,
+                                            const std::vector<std::string>& aidSet,
+                                            const std::vector<sdk::cardemulation::StaticApduResponse>& responses)
+{
+    if (!IsInited()) {
+        return ERR_CARD_EMULATION_SERVICE_NOT_INIT;
+    }
+
+    return serviceInfoManager_->AddAidSet(userId, elementName, type, aidSet, responses);
+}
+
 int CardEmulationService::RemoveAidsForService(int userId,
                                                const OHOS::AppExecFwk::ElementName& elementName,
                                                const std::string& type)
@@ -299,6 +333,15 @@ CardEmulationService::GetServicesByType(int userId, const std::string& type)
     }
     return serviceInfoManager_->GetServicesByType(userId, type);
 }
+
+void CardEmulationService::Dump(int fd)
+{
+    if (!IsInited()) {
+        return;
+    }
+    std::string info = aidRoutingPlanner_->Dump() + eventHandler_->Dump() + HceLatencyTracer::GetInstance().Dump();
+    dprintf(fd, "%s", info.c_str());
+}
 bool nfc::cardemulation::CardEmulationService::IsInited() const
 {
     return inited_;
@@ -50,6 +50,11 @@ public:
                           const OHOS::AppExecFwk::ElementName& elementName,
                           const std::string& type,
                           const std::vector<std::string>& aidSet) override;
+    int AddAidsForService(int userId,
+                          const OHOS::AppExecFwk::ElementName& elementName,
+                          const std::string& type,
+                          const std::vector<std::string>& aidSet,
+                          const std::vector<sdk::cardemulation::StaticApduResponse>& responses) override;
 
     int RemoveAidsForService(int userId,
                              const OHOS::AppExecFwk::ElementName& elementName,
@@ -86,6 +91,7 @@ public:
     std::vector<std::unique_ptr<OHOS::nfc::sdk::cardemulation::CardEmulationServiceInfoLite>> GetServicesByType(
         int userId,
         const std::string& type) override;
+    void Dump(int fd) override;
 
 protected:
     bool IsInited() const;
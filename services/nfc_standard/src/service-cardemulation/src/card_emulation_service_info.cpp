@@ -27,6 +27,7 @@
 #include "card_emulation_service_info_lite.h"
 #include "element_name.h"
 #include "loghelper.h"
+#include "static_apdu_responder.h"
 
 #ifdef USE_HILOG
 DEFINE_NFC_LOG_LABEL("CardEmulationServiceInfo");
@@ -35,6 +36,7 @@ DEFINE_NFC_LOG_LABEL("CardEmulationServiceInfo");
 namespace OHOS::nfc::cardemulation {
 static const std::string INFO_KEY_NAME = "name";
 static const std::string INFO_KEY_ABILITY_NAME = "ability_name";
+static const std::string INFO_KEY_BUNDLE_NAME = "bundle_name";
 static const std::string INFO_KEY_ABILITY_TYPE = "ability_type";
 static const std::string INFO_KEY_MATCHING_SKILLS = "matching_skills";
 static const std::string INFO_KEY_PERMISSION = "permission";
@@ -115,7 +117,9 @@ CardEmulationServiceInfo::CardEmulationServiceInfo(std::string location,
     dynamicAidsets_(),
     mu_(),
     execEnv_(std::move(location)),
-    mustUnlock_(mustUnlock)
+    mustUnlock_(mustUnlock),
+    apduChannel_(),
+    staticResponder_()
 {
     SetName(name);
 }
@@ -147,6 +151,9 @@ bool CardEmulationServiceInfo::AddAidset(std::unique_ptr<AidSet> aidset)
 
 bool CardEmulationServiceInfo::RemoveAidset(const std::string& type)
 {
+    if (std::atomic_load(&staticResponder_)) {
+        SetStaticResponses(type, {});
+    }
     auto pos = dynamicAidsets_.find(type);
     if (pos != std::end(dynamicAidsets_)) {
         if (pos->second) {
@@ -184,6 +191,12 @@ std::string CardEmulationServiceInfo::GetExecutionEnvironment() const
     return rawExecEnv_.empty() ? NFC_EE_HOST : rawExecEnv_;
 }
 
+void CardEmulationServiceInfo::SetRawExecutionEnvironment(std::string location)
+{
+    rawExecEnv_ = location.empty() ? NFC_EE_HOST : std::move(location);
+    execEnv_ = rawExecEnv_;
+}
+
 std::string CardEmulationServiceInfo::GetLabel() const
 {
     return label_;
@@ -242,6 +255,45 @@ OHOS::sptr<OHOS::nfc::sdk::cardemulation::ApduChannelProxy> CardEmulationService
     return apduChannel_;
 }
 
+int CardEmulationServiceInfo::SetStaticResponses(
+    const std::string& type,
+    const std::vector<OHOS::nfc::sdk::cardemulation::StaticApduResponse>& responses)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    auto current = std::atomic_load(&staticResponder_);
+    auto responder =
+        current ? std::make_shared<StaticApduResponder>(*current) : std::make_shared<StaticApduResponder>();
+    int rv = responder->Set(type, responses);
+    if (IS_NOK(rv)) {
+        return rv;
+    }
+    std::atomic_store(&staticResponder_,
+                      responder->Empty() ? std::shared_ptr<const StaticApduResponder>()
+                                         : std::shared_ptr<const StaticApduResponder>(std::move(responder)));
+    return ERR_OK;
+}
+
+void CardEmulationServiceInfo::ClearStaticResponses()
+{
+    std::atomic_store(&staticResponder_, std::shared_ptr<const StaticApduResponder>());
+}
+
+bool CardEmulationServiceInfo::RespondStatically(const unsigned char* data,
+                                                 size_t len,
+                                                 std::vector<unsigned char>& response) const
+{
+    auto responder = std::atomic_load(&staticResponder_);
+    if (!responder) {
+        return false;
+    }
+    auto matched = responder->Match(data, len);
+    if (!matched) {
+        return false;
+    }
+    response = *matched;
+    return true;
+}
+
 std::vector<std::shared_ptr<AidSet>> CardEmulationServiceInfo::SortAidsets(
     std::function<bool(std::shared_ptr<AidSet>, std::shared_ptr<AidSet>)> less)
 {
@@ -274,19 +326,19 @@ void CardEmulationServiceInfo::FromJson(const nlohmann::json& jsonObject)
     OHOS::AppExecFwk::ElementName name;
     try {
         name.SetAbilityName(jsonObject.at(INFO_KEY_ABILITY_NAME).get<std::string>());
+        // the files written before the bundle name was stored have none
+        if (jsonObject.contains(INFO_KEY_BUNDLE_NAME)) {
+            name.SetBundleName(jsonObject.at(INFO_KEY_BUNDLE_NAME).get<std::string>());
+        }
         SetName(name);
         std::string type;
         jsonObject.at(INFO_KEY_ABILITY_TYPE).get_to(type);
         SetLabel(jsonObject.at(INFO_KEY_LABEL).get<std::string>());
         SetIcon(jsonObject.at(INFO_KEY_ICON).get<std::string>());
-        if (jsonObject.contains(INFO_KEY_ENVIRONMENT)) {
-            rawExecEnv_ = (jsonObject.at(INFO_KEY_ENVIRONMENT).get<std::string>());
-        }
-        if (rawExecEnv_.empty()) {
-            rawExecEnv_ = NFC_EE_HOST;
-        }
         // override execEnv_ by constructor
-        execEnv_ = rawExecEnv_;
+        SetRawExecutionEnvironment(jsonObject.contains(INFO_KEY_ENVIRONMENT)
+                                       ? jsonObject.at(INFO_KEY_ENVIRONMENT).get<std::string>()
+                                       : rawExecEnv_);
         if (jsonObject.contains(INFO_KEY_UNLOCK_DEVICE)) {
             SetMustUnlock(jsonObject.at(INFO_KEY_UNLOCK_DEVICE).get<bool>());
         }
@@ -328,6 +380,7 @@ void CardEmulationServiceInfo::ToJson(nlohmann::json& j) const
                   });
 
     j = {{INFO_KEY_ABILITY_NAME, elementName_ ? elementName_->GetAbilityName() : ""},
+         {INFO_KEY_BUNDLE_NAME, elementName_ ? elementName_->GetBundleName() : ""},
          {INFO_KEY_ABILITY_TYPE, HostOrOffhost(execEnv_, rawExecEnv_)},
          {INFO_KEY_ENVIRONMENT, execEnv_},
          {INFO_KEY_LABEL, label_},
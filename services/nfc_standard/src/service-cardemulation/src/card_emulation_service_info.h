@@ -33,9 +33,11 @@ namespace sdk::cardemulation {
 class IApduChannel;
 class ApduChannelProxy;
 class CardEmulationServiceInfoLite;
+struct StaticApduResponse;
 }  // namespace sdk::cardemulation
 namespace cardemulation {
 class AidSet;
+class StaticApduResponder;
 class CardEmulationServiceInfo : public std::enable_shared_from_this<CardEmulationServiceInfo>,
                                  public OHOS::IRemoteObject::DeathRecipient {
 public:
@@ -55,6 +57,8 @@ public:
 
     int SetExecutionEnvironment(std::string location);
     std::string GetExecutionEnvironment() const;
+    // the environment declared by the service, restored by SetExecutionEnvironment("")
+    void SetRawExecutionEnvironment(std::string location);
     std::string GetLabel() const;
     void SetLabel(std::string label);
     std::string GetIcon() const;
@@ -72,6 +76,25 @@ public:
         std::function<bool(std::shared_ptr<AidSet>, std::shared_ptr<AidSet>)> less);
 
     std::shared_ptr<AidSet> GetAidsetByType(const std::string& type);
+    /**
+     * brief: replace the static responses of the type
+     * parameter:
+     *   type -- service type
+     *   responses -- responses, empty to remove the ones of the type
+     * return: ERR_OK -- succeeded, ERR_INVALID_STATIC_RESPONSE -- malformed or over the limits
+     */
+    int SetStaticResponses(const std::string& type,
+                           const std::vector<OHOS::nfc::sdk::cardemulation::StaticApduResponse>& responses);
+    void ClearStaticResponses();
+    /**
+     * brief: answer the command from the static responses, safe on the apdu path without locking
+     * parameter:
+     *   data -- command apdu
+     *   len -- length of the command apdu
+     *   response[out] -- response
+     * return: true -- answered, false -- no static response matches
+     */
+    bool RespondStatically(const unsigned char* data, size_t len, std::vector<unsigned char>& response) const;
     CardEmulationServiceInfo(CardEmulationServiceInfo const&) = delete;
 
     CardEmulationServiceInfo& operator=(CardEmulationServiceInfo const&) = delete;
@@ -105,6 +128,8 @@ private:
 
     bool mustUnlock_;
     OHOS::sptr<OHOS::nfc::sdk::cardemulation::ApduChannelProxy> apduChannel_;
+    // replaced by std::atomic_store, never modified in place
+    std::shared_ptr<const StaticApduResponder> staticResponder_;
 };
 void from_json(const nlohmann::json& jsonObject, CardEmulationServiceInfo& info);
 void to_json(nlohmann::json& j, const CardEmulationServiceInfo& info);
@@ -28,6 +28,7 @@
 #include "card_emulation_util.h"
 #include "element_name_util.h"
 #include "iaid_routing_manager.h"
+#include "icard_emulation_agent.h"
 #include "ipc_skeleton.h"
 #include "langinfo.h"
 #include "loghelper.h"
@@ -70,7 +71,12 @@ CardEmulationServiceInfoManager::CardEmulationServiceInfoManager(
     mu_(),
     routingManager_(ob),
     serviceinfoGetter_(ceserviceinfo_getter),
-    lastUserId_(INVALID_USER_ID)
+    lastUserId_(INVALID_USER_ID),
+    pendingMu_(),
+    pendingPackages_(),
+    flushScheduled_(false),
+    scheduler_(),
+    packageUpdateWindow_(PACKAGE_UPDATE_WINDOW)
 {
 }
 
@@ -85,7 +91,7 @@ int CardEmulationServiceInfoManager::Init()
 #ifdef MOCK_FOR_TESTING
 
     auto stub = std::make_shared<BundleNotificationStub>(
-        [this](bool installing, const std::string& bundleName) { OnServiceUpdated(GetCurrentUserId()); });
+        [this](bool installing, const std::string& bundleName) { OnPackageChanged(GetCurrentUserId(), bundleName); });
     BundleChangedEventSubscriber::Subscribe(stub);
 #endif
     return OnServiceUpdated(GetCurrentUserId());
@@ -153,6 +159,15 @@ int CardEmulationServiceInfoManager::AddAidSet(int userId,
                                                const OHOS::AppExecFwk::ElementName& elementName,
                                                const std::string& type,
                                                const std::vector<std::string>& aidSet)
+{
+    return AddAidSet(userId, elementName, type, aidSet, {});
+}
+
+int CardEmulationServiceInfoManager::AddAidSet(int userId,
+                                               const OHOS::AppExecFwk::ElementName& elementName,
+                                               const std::string& type,
+                                               const std::vector<std::string>& aidSet,
+                                               const std::vector<sdk::cardemulation::StaticApduResponse>& responses)
 {
     DebugLog("AddAidSet, %d , GetCurrentUserId: %d, type: %s\n", userId, GetCurrentUserId(), type.c_str());
     if (userId != GetCurrentUserId()) {
@@ -177,6 +192,10 @@ int CardEmulationServiceInfoManager::AddAidSet(int userId,
     auto serviceInfo = GetOrCreateAppInfo(userId, elementName);
     assert(serviceInfo);
 
+    int rv = serviceInfo->SetStaticResponses(type, responses);
+    if (IS_NOK(rv)) {
+        return rv;
+    }
     aids->SetOwner(serviceInfo);
     aids->SetType(type);
     if (serviceInfo->AddAidset(std::move(aids))) {
@@ -184,6 +203,7 @@ int CardEmulationServiceInfoManager::AddAidSet(int userId,
         NotifyCEServiceUpdated(userId);
         return ERR_OK;
     }
+    serviceInfo->SetStaticResponses(type, {});
     return ERR_AIDSET_IS_EMPTY;
 }
 
@@ -310,6 +330,62 @@ int CardEmulationServiceInfoManager::OnServiceUpdated(int userId)
     return rv;
 }
 
+void CardEmulationServiceInfoManager::OnPackageChanged(int userId, const std::string& bundleName)
+{
+    Scheduler scheduler;
+    std::chrono::milliseconds window;
+    {
+        std::lock_guard<std::mutex> locker(pendingMu_);
+        pendingPackages_[userId].insert(bundleName);
+        // the window starts with the first pending event, a storm delays the routing by one window at most
+        if (flushScheduled_) {
+            return;
+        }
+        flushScheduled_ = true;
+        scheduler = scheduler_;
+        window = packageUpdateWindow_;
+    }
+    std::weak_ptr<CardEmulationServiceInfoManager> weak = weak_from_this();
+    if (!scheduler || weak.expired()) {
+        // without a scheduler, or not owned by a shared_ptr, the changes are applied at once
+        FlushPackageChanges();
+        return;
+    }
+    DebugLog("package changed: %s, apply in %lld ms", bundleName.c_str(), static_cast<long long>(window.count()));
+    scheduler(
+        [weak]() {
+            auto self = weak.lock();
+            if (self) {
+                self->FlushPackageChanges();
+            }
+        },
+        window);
+}
+
+void CardEmulationServiceInfoManager::FlushPackageChanges()
+{
+    std::map<int, std::set<std::string>> pending;
+    {
+        std::lock_guard<std::mutex> locker(pendingMu_);
+        pending.swap(pendingPackages_);
+        flushScheduled_ = false;
+    }
+    std::lock_guard<std::mutex> locker(mu_);
+    for (auto& userPackages : pending) {
+        int rv = ApplyPackageChanges(userPackages.first, userPackages.second);
+        if (IS_OK(rv)) {
+            NotifyCEServiceUpdated(userPackages.first);
+        }
+    }
+}
+
+void CardEmulationServiceInfoManager::SetPackageUpdateScheduler(Scheduler scheduler, std::chrono::milliseconds window)
+{
+    std::lock_guard<std::mutex> locker(pendingMu_);
+    scheduler_ = std::move(scheduler);
+    packageUpdateWindow_ = window;
+}
+
 std::shared_ptr<CardEmulationServiceInfo> CardEmulationServiceInfoManager::GetUserPreferred(int userId)
 {
     if (userId != GetCurrentUserId()) {
@@ -574,7 +650,12 @@ int CardEmulationServiceInfoManager::ParseCEAbilityInfo(int userId)
     if (!serviceinfoGetter_) {
         return ERR_CESERVICE_GETTER_IS_NULL;
     }
-    // clear
+    // clear, the static responses are registered again by the updated services
+    for (auto& info : userCEServices_[userId]) {
+        if (info) {
+            info->ClearStaticResponses();
+        }
+    }
     userCEServices_[userId] = {};
 
     auto infos = serviceinfoGetter_->GetInstalled(userId);
@@ -592,6 +673,69 @@ int CardEmulationServiceInfoManager::ParseCEAbilityInfo(int userId)
     return ERR_OK;
 }
 
+int CardEmulationServiceInfoManager::ApplyPackageChanges(int userId, const std::set<std::string>& bundleNames)
+{
+    if (!serviceinfoGetter_) {
+        return ERR_CESERVICE_GETTER_IS_NULL;
+    }
+    auto it = userCEServices_.find(userId);
+    if (it == userCEServices_.end()) {
+        // never parsed, nothing to apply the changes to
+        return ParseCEAbilityInfo(userId);
+    }
+    auto& services = it->second;
+    // the services read without a bundle name can not be matched to the package, all of them are read again
+    bool bundleUnknown = std::any_of(bundleNames.begin(), bundleNames.end(), [](const std::string& bundleName) {
+        return bundleName.empty();
+    }) || std::any_of(services.begin(), services.end(), [](const std::shared_ptr<CardEmulationServiceInfo>& info) {
+        return info && info->GetName() && info->GetName()->GetBundleName().empty();
+    });
+    if (bundleUnknown) {
+        DebugLog("bundle of the services unknown, read all of them again");
+        return ParseCEAbilityInfo(userId);
+    }
+    // the replaced services are looked up again by name
+    auto preferred = GetUserPreferredWithoutLock(userId);
+    auto preferredName = preferred ? preferred->GetName() : nullptr;
+    auto primary = GetUserDefaultWithoutLock(userId);
+    auto primaryName = primary ? primary->GetName() : nullptr;
+    auto dynamicInfos = serviceinfoGetter_->GetDynamic(userId);
+    for (auto& bundleName : bundleNames) {
+        auto installed = serviceinfoGetter_->GetInstalledByBundle(userId, bundleName);
+        DebugLog("package: %s has %zu infos", bundleName.c_str(), installed.size());
+        for (auto& i : installed) {
+            GetDynamicCEServiceInfo(i, dynamicInfos);
+        }
+        // the updated services take the places of the old ones, the removed ones are dropped
+        for (auto pos = services.begin(); pos != services.end();) {
+            auto& info = *pos;
+            if (!info || !info->GetName() || info->GetName()->GetBundleName() != bundleName) {
+                ++pos;
+                continue;
+            }
+            info->ClearStaticResponses();
+            auto found = FindCEServiceInfoByName(*info->GetName(), installed);
+            if (!found) {
+                pos = services.erase(pos);
+                continue;
+            }
+            installed.erase(std::find(installed.begin(), installed.end(), found));
+            *pos = std::move(found);
+            ++pos;
+        }
+        services.insert(services.end(), installed.begin(), installed.end());
+    }
+    if (preferredName) {
+        userPreferredCEServices_[userId] = FindCEServiceInfoByName(*preferredName, services);
+    }
+    if (primaryName) {
+        userDefaultCEService_[userId] = FindCEServiceInfoByName(*primaryName, services);
+    }
+    DebugLog("user: %d has %zu infos", userId, services.size());
+    ParseDefaultCEServiceForType(userId);
+    return ERR_OK;
+}
+
 std::shared_ptr<CardEmulationServiceInfo> CardEmulationServiceInfoManager::GetUserDefaultWithoutLock(int userId)
 {
     auto posDefault = userDefaultCEService_.find(userId);
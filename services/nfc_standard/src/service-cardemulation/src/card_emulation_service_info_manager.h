@@ -15,9 +15,12 @@
 
 #ifndef CARD_EMULATION_SERVICE_MANAGER_H
 #define CARD_EMULATION_SERVICE_MANAGER_H
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -31,8 +34,13 @@ class ElementName;
 }
 namespace OHOS::nfc::cardemulation {
 class IAidRoutingManager;
-class CardEmulationServiceInfoManager final {
+class CardEmulationServiceInfoManager final : public std::enable_shared_from_this<CardEmulationServiceInfoManager> {
 public:
+    // runs the task after the delay, off the calling thread
+    using Scheduler = std::function<void(std::function<void()> task, std::chrono::milliseconds delay)>;
+    // the package events within the window are applied together and routed once
+    static constexpr std::chrono::milliseconds PACKAGE_UPDATE_WINDOW{300};
+
     CardEmulationServiceInfoManager(std::shared_ptr<IAidRoutingManager> ob,
                                     std::shared_ptr<InstalledCeServiceGetter> ceserviceinfo_getter);
     ~CardEmulationServiceInfoManager();
@@ -50,6 +58,12 @@ public:
                   const OHOS::AppExecFwk::ElementName& elementName,
                   const std::string& type,
                   const std::vector<std::string>& aidSet);
+    // the static responses replace the ones of the type, they are not stored and cleared on service update
+    int AddAidSet(int userId,
+                  const OHOS::AppExecFwk::ElementName& elementName,
+                  const std::string& type,
+                  const std::vector<std::string>& aidSet,
+                  const std::vector<sdk::cardemulation::StaticApduResponse>& responses);
     int RemoveAidSet(int userId, const OHOS::AppExecFwk::ElementName& elementName, const std::string& type);
     int MarkOffHostCEService(int userId,
                              const OHOS::AppExecFwk::ElementName& elementName,
@@ -61,6 +75,18 @@ public:
 
     int OnUserSwitched(int userId);
     int OnServiceUpdated(int userId);
+    /**
+     * brief: a package of the user is installed, updated or removed. only the services of the
+     *        changed packages are read again, once the window of the first pending event ends.
+     * parameter:
+     *   userId -- user of the package
+     *   bundleName -- name of the package
+     */
+    void OnPackageChanged(int userId, const std::string& bundleName);
+    // applies the pending package events now, and notifies the routing once per user
+    void FlushPackageChanges();
+    // the card emulation service posts the flush to the nfc handler, without a scheduler it runs at once
+    void SetPackageUpdateScheduler(Scheduler scheduler, std::chrono::milliseconds window);
 
     std::shared_ptr<CardEmulationServiceInfo> GetUserPreferred(int userId);
     bool IsDefaultCEServiceForAid(int userId, const OHOS::AppExecFwk::ElementName& elementName, const std::string& aid);
@@ -89,6 +115,8 @@ private:
                                      const std::string& type);
 
     int ParseCEAbilityInfo(int userId);
+    // replaces the services of the packages in place, the other services are kept
+    int ApplyPackageChanges(int userId, const std::set<std::string>& bundleNames);
     std::shared_ptr<CardEmulationServiceInfo> GetUserDefaultWithoutLock(int userId);
     std::shared_ptr<CardEmulationServiceInfo> GetUserPreferredWithoutLock(int userId);
 
@@ -115,6 +143,13 @@ private:
     std::shared_ptr<IAidRoutingManager> routingManager_;
     std::shared_ptr<InstalledCeServiceGetter> serviceinfoGetter_;
     int lastUserId_;
+
+    // guards the pending package events, never nested with mu_
+    std::mutex pendingMu_;
+    std::map<int, std::set<std::string>> pendingPackages_;
+    bool flushScheduled_;
+    Scheduler scheduler_;
+    std::chrono::milliseconds packageUpdateWindow_;
 };
 }  // namespace OHOS::nfc::cardemulation
 #endif  // CARD_EMULATION_SERVICE_MANAGER_H
@@ -17,6 +17,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <regex>
@@ -145,15 +147,14 @@ std::string BytesToHexStr(const unsigned char* start, size_t len, bool upper) no
     if (start == nullptr || len == 0) {
         return std::string();
     }
-    std::stringstream ss;
-    if (upper) {
-        ss << std::uppercase;
-    }
+    // called on every select apdu, formats without a stream
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string rv(len * 2, '0');
     for (size_t i = 0; i < len; i++) {
-        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(start[i]);
+        rv[i * 2] = digits[start[i] >> 4];
+        rv[i * 2 + 1] = digits[start[i] & 0x0F];
     }
-
-    return ss.str();
+    return rv;
 }
 std::string BytesToHexStr(std::vector<unsigned char> const& bytes, bool upper) noexcept
 {
@@ -249,4 +250,36 @@ std::vector<unsigned char> StringToBytes(const std::string& str) noexcept
 {
     return std::vector<unsigned char>(str.begin(), str.end());
 }
+
+uint64_t Fnv1aHash(const void* data, size_t len, uint64_t hash) noexcept
+{
+    constexpr uint64_t fnvPrime = 0x100000001B3ULL;
+    auto bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ bytes[i]) * fnvPrime;
+    }
+    return hash;
+}
+
+bool WriteFileAtomically(const std::string& path, const void* data, size_t len)
+{
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f.is_open()) {
+            return false;
+        }
+        f.write(static_cast<const char*>(data), static_cast<std::streamsize>(len));
+        if (!f.good()) {
+            f.close();
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
 }  // namespace OHOS::nfc::cardemulation
@@ -16,6 +16,8 @@
 #ifndef CARD_EMULATION_UTIL_H
 #define CARD_EMULATION_UTIL_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -46,5 +48,11 @@ std::vector<unsigned char> HexStrToBytes(const std::string& src) noexcept;
 std::string FindSelectAid(const std::vector<unsigned char>& data) noexcept;
 std::string FindSelectAid(const unsigned char* data, size_t len) noexcept;
 std::vector<unsigned char> StringToBytes(const std::string& str) noexcept;
+
+constexpr uint64_t FNV1A_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+// FNV-1a, stable across builds unlike std::hash, for the hashes persisted in files
+uint64_t Fnv1aHash(const void* data, size_t len, uint64_t hash = FNV1A_OFFSET_BASIS) noexcept;
+// writes aside and renames, a file cut by power loss is never read
+bool WriteFileAtomically(const std::string& path, const void* data, size_t len);
 }  // namespace OHOS::nfc::cardemulation
 #endif  // CARD_EMULATION_UTIL_H
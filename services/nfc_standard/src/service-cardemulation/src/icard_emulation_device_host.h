@@ -16,6 +16,8 @@
 #ifndef ICARD_EMULATION_DEVICE_HOST_H
 #define ICARD_EMULATION_DEVICE_HOST_H
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -38,6 +40,9 @@ public:
     virtual bool GetExtendedLengthApdusSupported() = 0;
     virtual bool SendData(std::vector<unsigned char> data) = 0;
     virtual bool DumpRoutingTable(int fd) = 0;
+    // runs the task on the handler of the nfc service after the delay, false if it is not posted
+    virtual bool PostTask(std::function<void()> task, int64_t delayMs) = 0;
+    virtual bool IsNfcEnabled() = 0;
 };
 
 }  // namespace OHOS::nfc::cardemulation
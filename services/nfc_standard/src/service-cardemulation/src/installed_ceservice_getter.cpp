@@ -19,6 +19,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <iterator>
 
 #include "bundle_mgr_proxy.h"
 #include "card_emulation_def.h"
@@ -28,6 +29,7 @@
 #include "loghelper.h"
 #include "nlohmann/json.hpp"
 #include "refbase.h"
+#include "service_info_cache.h"
 #include "system_ability_definition.h"
 
 #ifdef USE_HILOG
@@ -45,6 +47,25 @@ namespace OHOS::nfc::cardemulation {
 static const std::string JSON_FILE_TYPE_STATIC = "static";
 static const std::string JSON_FILE_TYPE_DYNAMIC = "dynamic";
 static const std::string JSON_FILE_TYPE_DEFAULT = "default";
+static const std::string ROUTING_PLAN_FILE_NAME = "routing_plan.json";
+
+static std::vector<std::shared_ptr<CardEmulationServiceInfo>> FilterByBundle(
+    const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos,
+    const std::string& bundleName)
+{
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> rv;
+    std::copy_if(infos.begin(), infos.end(), std::back_inserter(rv), [&bundleName](const auto& info) {
+        return info && info->GetName() && info->GetName()->GetBundleName() == bundleName;
+    });
+    return rv;
+}
+
+std::vector<std::shared_ptr<CardEmulationServiceInfo>> InstalledCeServiceGetter::GetInstalledByBundle(
+    int userId,
+    const std::string& bundleName)
+{
+    return FilterByBundle(GetInstalled(userId), bundleName);
+}
 #ifdef MOCK_FOR_TESTING
 static void HandleException(const std::exception& err, bool throwAgain)
 {
@@ -110,6 +131,16 @@ std::vector<std::shared_ptr<CardEmulationServiceInfo>> CeServiceGetter::GetInsta
 
     return rv;
 }
+std::vector<std::shared_ptr<CardEmulationServiceInfo>> CeServiceGetter::GetInstalledByBundle(
+    int userId,
+    const std::string& bundleName)
+{
+    // the static file is read again, it is mapped from its cache while unchanged
+    auto installed = LoadFromFile(BuildUsersJsonPath(userId, JSON_FILE_TYPE_STATIC));
+    auto rv = FilterByBundle(installed, bundleName);
+    infos_[userId] = std::move(installed);
+    return rv;
+}
 std::vector<std::shared_ptr<CardEmulationServiceInfo>> CeServiceGetter::GetDynamic(int userId)
 {
     std::vector<std::shared_ptr<CardEmulationServiceInfo>> rv;
@@ -159,16 +190,26 @@ void CeServiceGetter::StoreDefault(int userId, std::string abilityName)
     nlohmann::json j = {{KEY_DEFAULT_ABILITY_NAME, abilityName}};
     JsonDumpToFile(&j, BuildUsersJsonPath(userId, JSON_FILE_TYPE_DEFAULT));
 }
+std::string CeServiceGetter::GetRoutingPlanPath() const
+{
+    return GetJsonPathFromEnv() + PATH_SEPARATOR + ROUTING_PLAN_FILE_NAME;
+}
 std::vector<std::shared_ptr<CardEmulationServiceInfo>> CeServiceGetter::LoadFromFile(const std::string& path)
 {
     std::vector<std::shared_ptr<CardEmulationServiceInfo>> rv;
+    // the json file is parsed only when the cache is missing or stale
+    ServiceInfoCache cache(path);
+    SourceStamp stamp;
+    if (cache.Load(rv, stamp)) {
+        return rv;
+    }
     try {
         nlohmann::json j = ParseFromFile(path);
         if (!j.is_object()) {
             return rv;
         }
         j.at("abilities").get_to(rv);
-
+        cache.Store(stamp, rv);
     } catch (std::exception& err) {
         HandleException(err, false);
     }
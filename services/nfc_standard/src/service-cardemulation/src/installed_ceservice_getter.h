@@ -29,6 +29,9 @@ class InstalledCeServiceGetter {
 public:
     virtual ~InstalledCeServiceGetter() = default;
     virtual std::vector<std::shared_ptr<CardEmulationServiceInfo>> GetInstalled(int userId) = 0;
+    // the services of one package, read again after the package is installed, updated or removed
+    virtual std::vector<std::shared_ptr<CardEmulationServiceInfo>> GetInstalledByBundle(int userId,
+                                                                                      const std::string& bundleName);
     virtual std::vector<std::shared_ptr<CardEmulationServiceInfo>> GetDynamic(int userId) = 0;
     virtual OHOS::AppExecFwk::ElementName GetDefaultElementName(int userId) = 0;
 
@@ -41,10 +44,14 @@ class CeServiceGetter : public InstalledCeServiceGetter {
 public:
     CeServiceGetter();
     std::vector<std::shared_ptr<CardEmulationServiceInfo>> GetInstalled(int userId) override;
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> GetInstalledByBundle(int userId,
+                                                                              const std::string& bundleName) override;
     std::vector<std::shared_ptr<CardEmulationServiceInfo>> GetDynamic(int userId) override;
     OHOS::AppExecFwk::ElementName GetDefaultElementName(int userId) override;
     void StoreDynamic(int userId, const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos) override;
     void StoreDefault(int userId, std::string abilityName) override;
+    // the routing plan is kept beside the service files, it is shared by the users
+    std::string GetRoutingPlanPath() const;
 
 private:
     std::vector<std::shared_ptr<CardEmulationServiceInfo>> LoadFromFile(const std::string& path);
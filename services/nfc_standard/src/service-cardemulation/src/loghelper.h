@@ -49,6 +49,7 @@
                                        __SRC_FILE_NAME__,                \
                                        __LINE__,                         \
                                        ##__VA_ARGS__)
+#define IsDebugLogEnabled() HiLogIsLoggable(NFC_LOG_LABEL.domain, NFC_LOG_LABEL.tag, LOG_INFO)
 #else
 
 #define DebugLog(format, ...)                                             \
@@ -57,7 +58,9 @@
                                         __SRC_FILE_NAME__,                \
                                         __LINE__,                         \
                                         ##__VA_ARGS__)
+#define IsDebugLogEnabled() HiLogIsLoggable(NFC_LOG_LABEL.domain, NFC_LOG_LABEL.tag, LOG_DEBUG)
 #endif
+#define IsInfoLogEnabled() HiLogIsLoggable(NFC_LOG_LABEL.domain, NFC_LOG_LABEL.tag, LOG_INFO)
 #else
 
 #ifdef DEBUG
@@ -94,11 +97,15 @@
         GET_TIME();                                                                 \
         printf(" " __FILE__ "(%05d) ERROR: " format "\n", __LINE__, ##__VA_ARGS__); \
     }
+#define IsInfoLogEnabled() true
+#define IsDebugLogEnabled() true
 #else
 #define InfoLog(format, ...)
 #define DebugLog(format, ...)
 #define WarnLog(format, ...)
 #define ErrorLog(format, ...)
+#define IsInfoLogEnabled() false
+#define IsDebugLogEnabled() false
 #endif
 
 #endif
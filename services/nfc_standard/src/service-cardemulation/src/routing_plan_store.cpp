@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "routing_plan_store.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "aid_set.h"
+#include "card_emulation_service_info.h"
+#include "card_emulation_util.h"
+#include "element_name.h"
+#include "installed_ceservice_getter.h"
+#include "loghelper.h"
+#include "nlohmann/json.hpp"
+#ifdef USE_HILOG
+DEFINE_NFC_LOG_LABEL("RoutingPlanStore");
+#endif
+
+namespace OHOS::nfc::cardemulation {
+// changed whenever the planning gives another plan for the same inputs
+static constexpr int PLAN_FORMAT_VERSION = 1;
+static const std::string KEY_VERSION = "version";
+static const std::string KEY_INPUTS_HASH = "inputs_hash";
+static const std::string KEY_ENTRIES = "entries";
+static const std::string KEY_AID = "aid";
+static const std::string KEY_ROUTE = "route";
+static const std::string KEY_PATTERN = "pattern";
+static const std::string KEY_AIDSETS = "aidsets";
+static const std::string KEY_SERVICE = "service";
+static const std::string KEY_TYPE = "type";
+
+class InputsHasher {
+public:
+    void Add(const std::string& s)
+    {
+        hash_ = Fnv1aHash(s.data(), s.size(), hash_);
+        // keeps "ab" + "c" apart from "a" + "bc"
+        hash_ = Fnv1aHash(&SEPARATOR, sizeof(SEPARATOR), hash_);
+    }
+    void Add(int value)
+    {
+        Add(std::to_string(value));
+    }
+    uint64_t Get() const
+    {
+        return hash_;
+    }
+
+private:
+    static constexpr unsigned char SEPARATOR = 0xFF;
+    uint64_t hash_{FNV1A_OFFSET_BASIS};
+};
+
+static std::string ServiceName(const std::shared_ptr<CardEmulationServiceInfo>& info)
+{
+    if (!info) {
+        return "";
+    }
+    auto name = info->GetName();
+    return name ? ElementNameToString(*name) : "";
+}
+
+RoutingPlanStore::RoutingPlanStore(std::string path) : path_(std::move(path)), mu_(), loaded_(false), plan_()
+{
+}
+
+RoutingPlanStore::~RoutingPlanStore() = default;
+
+uint64_t RoutingPlanStore::HashInputs(const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos,
+                                      const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                                      const std::shared_ptr<CardEmulationServiceInfo>& preferred,
+                                      int mode,
+                                      int capacity,
+                                      int defaultRoute)
+{
+    InputsHasher hasher;
+    hasher.Add(PLAN_FORMAT_VERSION);
+    hasher.Add(mode);
+    hasher.Add(capacity);
+    hasher.Add(defaultRoute);
+    hasher.Add(ServiceName(primary));
+    hasher.Add(ServiceName(preferred));
+    for (auto& info : infos) {
+        if (!info) {
+            continue;
+        }
+        hasher.Add(ServiceName(info));
+        hasher.Add(info->GetExecutionEnvironment());
+        hasher.Add(info->MustUnlock() ? 1 : 0);
+        info->Visit([&hasher](const std::string& type, std::shared_ptr<AidSet> aidset) {
+            hasher.Add(type);
+            if (!aidset) {
+                return;
+            }
+            for (auto& aid : aidset->GetAllAidRawString()) {
+                hasher.Add(aid);
+            }
+        });
+    }
+    return hasher.Get();
+}
+
+std::shared_ptr<const RoutingPlan> RoutingPlanStore::Load()
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    if (loaded_) {
+        return plan_;
+    }
+    loaded_ = true;
+    std::string content;
+    if (!ReadFile(content)) {
+        return plan_;
+    }
+    try {
+        auto j = nlohmann::json::parse(content);
+        if (j.at(KEY_VERSION).get<int>() != PLAN_FORMAT_VERSION) {
+            InfoLog("routing plan of another version is ignored");
+            return plan_;
+        }
+        auto plan = std::make_shared<RoutingPlan>();
+        plan->inputsHash_ = std::stoull(j.at(KEY_INPUTS_HASH).get<std::string>(), nullptr, 16);
+        for (auto& e : j.at(KEY_ENTRIES)) {
+            RoutingEntry entry;
+            HexStrToBytes(e.at(KEY_AID).get<std::string>(), entry.aid_);
+            entry.route_ = e.at(KEY_ROUTE).get<int>();
+            entry.aidPattern_ = e.at(KEY_PATTERN).get<int>();
+            plan->entries_.push_back(std::move(entry));
+        }
+        for (auto& a : j.at(KEY_AIDSETS)) {
+            RoutingPlan::RoutedAidset aidset;
+            a.at(KEY_SERVICE).get_to(aidset.service_);
+            a.at(KEY_TYPE).get_to(aidset.type_);
+            plan->aidsets_.push_back(std::move(aidset));
+        }
+        plan_ = plan;
+    } catch (std::exception& err) {
+        ErrorLog("fail to parse routing plan: %s. err: %s", path_.c_str(), err.what());
+    }
+    return plan_;
+}
+
+bool RoutingPlanStore::Store(const RoutingPlan& plan)
+{
+    std::stringstream hash;
+    hash << std::hex << plan.inputsHash_;
+    nlohmann::json entries = nlohmann::json::array();
+    for (auto& entry : plan.entries_) {
+        entries.push_back(
+            {{KEY_AID, BytesToHexStr(entry.aid_)}, {KEY_ROUTE, entry.route_}, {KEY_PATTERN, entry.aidPattern_}});
+    }
+    nlohmann::json aidsets = nlohmann::json::array();
+    for (auto& aidset : plan.aidsets_) {
+        aidsets.push_back({{KEY_SERVICE, aidset.service_}, {KEY_TYPE, aidset.type_}});
+    }
+    nlohmann::json j = {{KEY_VERSION, PLAN_FORMAT_VERSION},
+                        {KEY_INPUTS_HASH, hash.str()},
+                        {KEY_ENTRIES, entries},
+                        {KEY_AIDSETS, aidsets}};
+
+    std::lock_guard<std::mutex> lk(mu_);
+    loaded_ = true;
+    plan_ = std::make_shared<const RoutingPlan>(plan);
+    return WriteFile(j.dump());
+}
+
+bool RoutingPlanStore::ReadFile(std::string& content)
+{
+    std::ifstream f(path_);
+    if (!f.is_open()) {
+        return false;
+    }
+    std::stringstream ss;
+    ss << f.rdbuf();
+    content = ss.str();
+    return !content.empty();
+}
+
+bool RoutingPlanStore::WriteFile(const std::string& content)
+{
+    if (!WriteFileAtomically(path_, content.data(), content.size())) {
+        ErrorLog("fail to write: %s", path_.c_str());
+        return false;
+    }
+    return true;
+}
+}  // namespace OHOS::nfc::cardemulation
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROUTING_PLAN_STORE_H
+#define ROUTING_PLAN_STORE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "aid_routing_table.h"
+
+namespace OHOS::nfc::cardemulation {
+class CardEmulationServiceInfo;
+
+// the routing entries programmed for the planning inputs of the hash
+class RoutingPlan final {
+public:
+    class RoutedAidset final {
+    public:
+        std::string service_{};
+        std::string type_{};
+    };
+    uint64_t inputsHash_{0};
+    // without the default routing entry
+    std::vector<RoutingEntry> entries_{};
+    // routing table of the planner, including the aidsets of the default route
+    std::vector<RoutedAidset> aidsets_{};
+};
+
+/*
+ * Persists the last routing plan, so that the plan is programmed again
+ * without planning while its inputs are unchanged.
+ */
+class RoutingPlanStore {
+public:
+    explicit RoutingPlanStore(std::string path);
+    virtual ~RoutingPlanStore();
+    RoutingPlanStore(const RoutingPlanStore&) = delete;
+    RoutingPlanStore& operator=(const RoutingPlanStore&) = delete;
+
+    /**
+     * brief: content hash of the planning inputs
+     * parameter:
+     *   infos -- card emulation services
+     *   primary -- default service
+     *   preferred -- foreground preferred service
+     *   mode -- aid matching mode of the controller
+     *   capacity -- routing table capacity in bytes
+     *   defaultRoute -- default route of the controller
+     * return: hash
+     */
+    static uint64_t HashInputs(const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos,
+                               const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                               const std::shared_ptr<CardEmulationServiceInfo>& preferred,
+                               int mode,
+                               int capacity,
+                               int defaultRoute);
+    /**
+     * brief: get the stored plan, the file is read once
+     * return: plan, nullptr when nothing is stored or the file is malformed
+     */
+    std::shared_ptr<const RoutingPlan> Load();
+    /**
+     * brief: replace the stored plan
+     * parameter: plan -- plan
+     * return: true -- written to the file
+     */
+    bool Store(const RoutingPlan& plan);
+
+protected:
+    virtual bool ReadFile(std::string& content);
+    virtual bool WriteFile(const std::string& content);
+
+private:
+    std::string path_;
+    std::mutex mu_;
+    bool loaded_;
+    std::shared_ptr<const RoutingPlan> plan_;
+};
+}  // namespace OHOS::nfc::cardemulation
+#endif  // ROUTING_PLAN_STORE_H
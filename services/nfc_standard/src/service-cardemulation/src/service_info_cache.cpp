@@ -0,0 +1,445 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "service_info_cache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+#include "aid_set.h"
+#include "aid_string.h"
+#include "card_emulation_service_info.h"
+#include "card_emulation_util.h"
+#include "element_name.h"
+#include "loghelper.h"
+#ifdef USE_HILOG
+DEFINE_NFC_LOG_LABEL("ServiceInfoCache");
+#endif
+
+namespace OHOS::nfc::cardemulation {
+namespace {
+// "CESC"
+constexpr uint32_t CACHE_MAGIC = 0x43534543;
+// changed with the layout below
+constexpr uint32_t CACHE_VERSION = 2;
+constexpr uint32_t FLAG_MUST_UNLOCK = 0x01;
+
+// file layout: header, services, aidsets, aids, string table, aid bytes
+struct StringRef {
+    uint32_t offset_;
+    uint32_t length_;
+};
+struct CacheHeader {
+    uint32_t magic_;
+    uint32_t version_;
+    uint64_t sourceSize_;
+    int64_t sourceMtimeSec_;
+    int64_t sourceMtimeNsec_;
+    uint64_t sourceHash_;
+    uint32_t serviceCount_;
+    uint32_t aidsetCount_;
+    uint32_t aidCount_;
+    uint32_t stringBytes_;
+    uint32_t aidBytes_;
+    uint32_t reserved_;
+};
+struct CachedService {
+    StringRef abilityName_;
+    StringRef bundleName_;
+    StringRef label_;
+    StringRef icon_;
+    StringRef environment_;
+    uint32_t flags_;
+    uint32_t firstAidset_;
+    uint32_t aidsetCount_;
+    uint32_t reserved_;
+};
+struct CachedAidset {
+    StringRef type_;
+    StringRef description_;
+    uint32_t firstAid_;
+    uint32_t aidCount_;
+};
+struct CachedAid {
+    uint32_t offset_;
+    uint8_t length_;
+    uint8_t pattern_;
+    uint16_t reserved_;
+};
+// the records are read in place from the page aligned mapping
+static_assert(sizeof(CacheHeader) % alignof(uint64_t) == 0, "header keeps the records aligned");
+static_assert(sizeof(CachedService) % alignof(uint32_t) == 0, "services keep the records aligned");
+static_assert(sizeof(CachedAidset) % alignof(uint32_t) == 0, "aidsets keep the records aligned");
+
+class MappedFile final {
+public:
+    explicit MappedFile(const std::string& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st {};
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                data_ = static_cast<const unsigned char*>(addr);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        close(fd);
+    }
+    ~MappedFile()
+    {
+        if (data_) {
+            munmap(const_cast<unsigned char*>(data_), size_);
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    const unsigned char* Data() const
+    {
+        return data_;
+    }
+    size_t Size() const
+    {
+        return size_;
+    }
+
+private:
+    const unsigned char* data_{nullptr};
+    size_t size_{0};
+};
+
+// bounds checked view of a mapped cache, a corrupted file is rejected rather than read past
+class CacheView final {
+public:
+    bool Open(const unsigned char* data, size_t size)
+    {
+        if (!data || size < sizeof(CacheHeader)) {
+            return false;
+        }
+        header_ = reinterpret_cast<const CacheHeader*>(data);
+        if (header_->magic_ != CACHE_MAGIC || header_->version_ != CACHE_VERSION) {
+            return false;
+        }
+        uint64_t expected = sizeof(CacheHeader) + uint64_t(header_->serviceCount_) * sizeof(CachedService) +
+                            uint64_t(header_->aidsetCount_) * sizeof(CachedAidset) +
+                            uint64_t(header_->aidCount_) * sizeof(CachedAid) + header_->stringBytes_ +
+                            header_->aidBytes_;
+        if (expected != size) {
+            return false;
+        }
+        services_ = reinterpret_cast<const CachedService*>(data + sizeof(CacheHeader));
+        aidsets_ = reinterpret_cast<const CachedAidset*>(services_ + header_->serviceCount_);
+        aids_ = reinterpret_cast<const CachedAid*>(aidsets_ + header_->aidsetCount_);
+        strings_ = reinterpret_cast<const char*>(aids_ + header_->aidCount_);
+        aidBytes_ = reinterpret_cast<const unsigned char*>(strings_ + header_->stringBytes_);
+        return true;
+    }
+    const CacheHeader& Header() const
+    {
+        return *header_;
+    }
+    const CachedService& Service(uint32_t i) const
+    {
+        return services_[i];
+    }
+    const CachedAidset* Aidset(uint32_t i) const
+    {
+        return (i < header_->aidsetCount_) ? &aidsets_[i] : nullptr;
+    }
+    const CachedAid* Aid(uint32_t i) const
+    {
+        return (i < header_->aidCount_) ? &aids_[i] : nullptr;
+    }
+    bool GetString(const StringRef& ref, std::string& out) const
+    {
+        if (uint64_t(ref.offset_) + ref.length_ > header_->stringBytes_) {
+            return false;
+        }
+        out.assign(strings_ + ref.offset_, ref.length_);
+        return true;
+    }
+    const unsigned char* GetAidBytes(const CachedAid& aid) const
+    {
+        if (uint64_t(aid.offset_) + aid.length_ > header_->aidBytes_) {
+            return nullptr;
+        }
+        return aidBytes_ + aid.offset_;
+    }
+
+private:
+    const CacheHeader* header_{nullptr};
+    const CachedService* services_{nullptr};
+    const CachedAidset* aidsets_{nullptr};
+    const CachedAid* aids_{nullptr};
+    const char* strings_{nullptr};
+    const unsigned char* aidBytes_{nullptr};
+};
+
+class CacheWriter final {
+public:
+    bool Add(const CardEmulationServiceInfo& info)
+    {
+        auto name = info.GetName();
+        CachedService service{};
+        service.abilityName_ = AddString(name ? name->GetAbilityName() : "");
+        service.bundleName_ = AddString(name ? name->GetBundleName() : "");
+        service.label_ = AddString(info.GetLabel());
+        service.icon_ = AddString(info.GetIcon());
+        // the services are cached right after parsing, the environment is still the declared one
+        service.environment_ = AddString(info.GetExecutionEnvironment());
+        service.flags_ = info.MustUnlock() ? FLAG_MUST_UNLOCK : 0;
+        service.firstAidset_ = static_cast<uint32_t>(aidsets_.size());
+        bool cacheable = true;
+        info.Visit([this, &cacheable](const std::string& type, std::shared_ptr<AidSet> aidset) {
+            // an empty aidset cannot be restored by AddAidsetToStatic
+            if (!aidset || aidset->Empty()) {
+                cacheable = false;
+                return;
+            }
+            CachedAidset cached{};
+            cached.type_ = AddString(type);
+            cached.description_ = AddString(aidset->GetDescription());
+            cached.firstAid_ = static_cast<uint32_t>(aids_.size());
+            for (auto& aid : aidset->GetAll()) {
+                std::vector<unsigned char> bytes;
+                aid->ToBytes(bytes);
+                CachedAid c{};
+                c.offset_ = static_cast<uint32_t>(aidBytes_.size());
+                c.length_ = static_cast<uint8_t>(bytes.size());
+                c.pattern_ = static_cast<uint8_t>(AidTypeToInt(aid->GetType()));
+                aidBytes_.insert(aidBytes_.end(), bytes.begin(), bytes.end());
+                aids_.push_back(c);
+            }
+            cached.aidCount_ = static_cast<uint32_t>(aids_.size()) - cached.firstAid_;
+            aidsets_.push_back(cached);
+        });
+        service.aidsetCount_ = static_cast<uint32_t>(aidsets_.size()) - service.firstAidset_;
+        services_.push_back(service);
+        return cacheable;
+    }
+    std::vector<unsigned char> Build(const SourceStamp& stamp) const
+    {
+        CacheHeader header{};
+        header.magic_ = CACHE_MAGIC;
+        header.version_ = CACHE_VERSION;
+        header.sourceSize_ = stamp.size_;
+        header.sourceMtimeSec_ = stamp.mtimeSec_;
+        header.sourceMtimeNsec_ = stamp.mtimeNsec_;
+        header.sourceHash_ = stamp.hash_;
+        header.serviceCount_ = static_cast<uint32_t>(services_.size());
+        header.aidsetCount_ = static_cast<uint32_t>(aidsets_.size());
+        header.aidCount_ = static_cast<uint32_t>(aids_.size());
+        header.stringBytes_ = static_cast<uint32_t>(strings_.size());
+        header.aidBytes_ = static_cast<uint32_t>(aidBytes_.size());
+
+        std::vector<unsigned char> buf;
+        Append(buf, &header, sizeof(header));
+        Append(buf, services_.data(), services_.size() * sizeof(CachedService));
+        Append(buf, aidsets_.data(), aidsets_.size() * sizeof(CachedAidset));
+        Append(buf, aids_.data(), aids_.size() * sizeof(CachedAid));
+        Append(buf, strings_.data(), strings_.size());
+        Append(buf, aidBytes_.data(), aidBytes_.size());
+        return buf;
+    }
+
+private:
+    StringRef AddString(const std::string& s)
+    {
+        auto it = stringRefs_.find(s);
+        if (it != stringRefs_.end()) {
+            return it->second;
+        }
+        StringRef ref{static_cast<uint32_t>(strings_.size()), static_cast<uint32_t>(s.size())};
+        strings_.append(s);
+        stringRefs_.emplace(s, ref);
+        return ref;
+    }
+    static void Append(std::vector<unsigned char>& buf, const void* data, size_t len)
+    {
+        auto bytes = static_cast<const unsigned char*>(data);
+        buf.insert(buf.end(), bytes, bytes + len);
+    }
+
+    std::vector<CachedService> services_;
+    std::vector<CachedAidset> aidsets_;
+    std::vector<CachedAid> aids_;
+    std::string strings_;
+    std::map<std::string, StringRef> stringRefs_;
+    std::vector<unsigned char> aidBytes_;
+};
+
+std::string PatternFlag(int pattern)
+{
+    if (pattern == AidTypeToInt(AidType::PREFIX)) {
+        return STR_PREFIX_AID_FLAG;
+    }
+    if (pattern == AidTypeToInt(AidType::SUBSET)) {
+        return STR_SUBSET_AID_FLAG;
+    }
+    return "";
+}
+
+bool RestoreServices(const CacheView& view, std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos)
+{
+    const CacheHeader& header = view.Header();
+    infos.reserve(header.serviceCount_);
+    std::string abilityName;
+    std::string bundleName;
+    std::string environment;
+    std::string text;
+    for (uint32_t i = 0; i < header.serviceCount_; ++i) {
+        const CachedService& service = view.Service(i);
+        if (!view.GetString(service.abilityName_, abilityName) || !view.GetString(service.bundleName_, bundleName) ||
+            !view.GetString(service.environment_, environment)) {
+            return false;
+        }
+        OHOS::AppExecFwk::ElementName name("", bundleName, abilityName);
+        auto info =
+            std::make_shared<CardEmulationServiceInfo>(environment, name, (service.flags_ & FLAG_MUST_UNLOCK) != 0);
+        info->SetRawExecutionEnvironment(environment);
+        if (!view.GetString(service.label_, text)) {
+            return false;
+        }
+        info->SetLabel(text);
+        if (!view.GetString(service.icon_, text)) {
+            return false;
+        }
+        info->SetIcon(text);
+        for (uint32_t j = 0; j < service.aidsetCount_; ++j) {
+            const CachedAidset* cached = view.Aidset(service.firstAidset_ + j);
+            if (!cached || !view.GetString(cached->type_, text)) {
+                return false;
+            }
+            auto aidset = std::make_unique<AidSet>(text);
+            if (!view.GetString(cached->description_, text)) {
+                return false;
+            }
+            aidset->SetDescription(text);
+            for (uint32_t k = 0; k < cached->aidCount_; ++k) {
+                const CachedAid* aid = view.Aid(cached->firstAid_ + k);
+                const unsigned char* bytes = aid ? view.GetAidBytes(*aid) : nullptr;
+                if (!bytes) {
+                    return false;
+                }
+                aidset->AddAidString(AidString(BytesToHexStr(bytes, aid->length_) + PatternFlag(aid->pattern_)));
+            }
+            if (!info->AddAidsetToStatic(std::move(aidset))) {
+                return false;
+            }
+        }
+        infos.push_back(std::move(info));
+    }
+    return true;
+}
+}  // namespace
+
+ServiceInfoCache::ServiceInfoCache(std::string sourcePath)
+    : sourcePath_(std::move(sourcePath)),
+    cachePath_(sourcePath_ + CACHE_FILE_SUFFIX)
+{
+}
+
+ServiceInfoCache::~ServiceInfoCache() = default;
+
+bool ServiceInfoCache::Load(std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos, SourceStamp& stamp)
+{
+    MappedFile file(cachePath_);
+    CacheView view;
+    bool opened = view.Open(file.Data(), file.Size());
+    SourceStamp cached;
+    if (opened) {
+        cached.size_ = view.Header().sourceSize_;
+        cached.mtimeSec_ = view.Header().sourceMtimeSec_;
+        cached.mtimeNsec_ = view.Header().sourceMtimeNsec_;
+        cached.hash_ = view.Header().sourceHash_;
+    }
+    if (!StampSource(opened ? &cached : nullptr, stamp)) {
+        return false;
+    }
+    if (!opened || stamp.size_ != cached.size_ || stamp.hash_ != cached.hash_) {
+        DebugLog("service info cache is stale: %s", cachePath_.c_str());
+        return false;
+    }
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> restored;
+    if (!RestoreServices(view, restored)) {
+        ErrorLog("service info cache is malformed: %s", cachePath_.c_str());
+        return false;
+    }
+    infos = std::move(restored);
+    if (stamp.mtimeSec_ != cached.mtimeSec_ || stamp.mtimeNsec_ != cached.mtimeNsec_) {
+        // touched without changes, the new mtime saves hashing next time
+        Store(stamp, infos);
+    }
+    return true;
+}
+
+bool ServiceInfoCache::Store(const SourceStamp& stamp,
+                             const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos)
+{
+    CacheWriter writer;
+    for (auto& info : infos) {
+        if (info && !writer.Add(*info)) {
+            DebugLog("services are not cacheable: %s", sourcePath_.c_str());
+            std::remove(cachePath_.c_str());
+            return false;
+        }
+    }
+    auto buf = writer.Build(stamp);
+    if (!WriteFileAtomically(cachePath_, buf.data(), buf.size())) {
+        ErrorLog("fail to write: %s", cachePath_.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string ServiceInfoCache::GetCachePath() const
+{
+    return cachePath_;
+}
+
+bool ServiceInfoCache::StampSource(const SourceStamp* cached, SourceStamp& stamp) const
+{
+    struct stat st {};
+    if (stat(sourcePath_.c_str(), &st) != 0) {
+        return false;
+    }
+    stamp.size_ = static_cast<uint64_t>(st.st_size);
+    stamp.mtimeSec_ = static_cast<int64_t>(st.st_mtim.tv_sec);
+    stamp.mtimeNsec_ = static_cast<int64_t>(st.st_mtim.tv_nsec);
+    if (cached && cached->size_ == stamp.size_ && cached->mtimeSec_ == stamp.mtimeSec_ &&
+        cached->mtimeNsec_ == stamp.mtimeNsec_) {
+        stamp.hash_ = cached->hash_;
+        return true;
+    }
+    std::ifstream f(sourcePath_, std::ios::binary);
+    if (!f.is_open()) {
+        return false;
+    }
+    std::vector<char> buf(static_cast<size_t>(st.st_size));
+    f.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+    stamp.size_ = static_cast<uint64_t>(f.gcount());
+    stamp.hash_ = Fnv1aHash(buf.data(), stamp.size_);
+    return true;
+}
+}  // namespace OHOS::nfc::cardemulation
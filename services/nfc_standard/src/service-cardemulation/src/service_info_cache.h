@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICE_INFO_CACHE_H
+#define SERVICE_INFO_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OHOS::nfc::cardemulation {
+class CardEmulationServiceInfo;
+
+// identifies the content of the json file the cache was built from
+class SourceStamp final {
+public:
+    uint64_t size_{0};
+    int64_t mtimeSec_{0};
+    int64_t mtimeNsec_{0};
+    uint64_t hash_{0};
+};
+
+/*
+ * Binary cache of the services parsed from a json file. The file is mapped
+ * and the service records, the binary aids and the string table are read in
+ * place, no json is parsed. The json file stays the source of truth, the
+ * cache is used while the mtime or, when touched, the content hash of the
+ * json file is unchanged.
+ */
+class ServiceInfoCache final {
+public:
+    static constexpr const char* CACHE_FILE_SUFFIX = ".cache";
+
+    explicit ServiceInfoCache(std::string sourcePath);
+    ~ServiceInfoCache();
+    ServiceInfoCache(const ServiceInfoCache&) = delete;
+    ServiceInfoCache& operator=(const ServiceInfoCache&) = delete;
+
+    /**
+     * brief: get the services from the cache
+     * parameter:
+     *   infos[out] -- services of the json file
+     *   stamp[out] -- stamp of the json file, used to regenerate a stale cache
+     * return: true -- the cache is fresh, false -- missing, stale or malformed
+     */
+    bool Load(std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos, SourceStamp& stamp);
+    /**
+     * brief: regenerate the cache from the services just parsed
+     * parameter:
+     *   stamp -- stamp of the json file taken before parsing
+     *   infos -- services of the json file
+     * return: true -- written
+     */
+    bool Store(const SourceStamp& stamp, const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& infos);
+    std::string GetCachePath() const;
+
+private:
+    // stats and, when the mtime differs from the cached one, hashes the json file
+    bool StampSource(const SourceStamp* cached, SourceStamp& stamp) const;
+
+private:
+    std::string sourcePath_;
+    std::string cachePath_;
+};
+}  // namespace OHOS::nfc::cardemulation
+#endif  // SERVICE_INFO_CACHE_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "static_apdu_responder.h"
+
+#include <algorithm>
+
+#include "card_emulation_error.h"
+#include "loghelper.h"
+#ifdef USE_HILOG
+DEFINE_NFC_LOG_LABEL("StaticApduResponder");
+#endif
+
+using namespace OHOS::nfc::sdk::cardemulation;
+namespace OHOS::nfc::cardemulation {
+StaticApduResponder::StaticApduResponder() : entries_(), bytes_(0)
+{
+}
+
+StaticApduResponder::~StaticApduResponder() = default;
+
+int StaticApduResponder::Set(const std::string& type, const std::vector<StaticApduResponse>& responses)
+{
+    std::vector<Entry> entries;
+    size_t bytes = 0;
+    for (auto& e : entries_) {
+        if (e.type_ != type) {
+            entries.push_back(e);
+            bytes += EntryBytes(e);
+        }
+    }
+    for (auto& response : responses) {
+        if (!IsValid(response)) {
+            ErrorLog("invalid static response, mask length: %zu, value length: %zu, response length: %zu",
+                     response.mask_.size(),
+                     response.value_.size(),
+                     response.response_.size());
+            return ERR_INVALID_STATIC_RESPONSE;
+        }
+        Entry entry{type, response.mask_, response.value_, response.response_};
+        for (size_t i = 0; i < entry.value_.size(); ++i) {
+            entry.value_[i] &= entry.mask_[i];
+        }
+        bytes += EntryBytes(entry);
+        entries.push_back(std::move(entry));
+    }
+    if (entries.size() > MAX_ENTRY_COUNT || bytes > MAX_TABLE_BYTES) {
+        ErrorLog("static responses over the limit, count: %zu, bytes: %zu", entries.size(), bytes);
+        return ERR_INVALID_STATIC_RESPONSE;
+    }
+    entries_ = std::move(entries);
+    bytes_ = bytes;
+    return ERR_OK;
+}
+
+void StaticApduResponder::Remove(const std::string& type)
+{
+    Set(type, {});
+}
+
+const std::vector<unsigned char>* StaticApduResponder::Match(const unsigned char* data, size_t len) const
+{
+    if (!data) {
+        return nullptr;
+    }
+    for (auto& e : entries_) {
+        if (Matches(e, data, len)) {
+            return &e.response_;
+        }
+    }
+    return nullptr;
+}
+
+bool StaticApduResponder::Empty() const
+{
+    return entries_.empty();
+}
+
+size_t StaticApduResponder::GetEntryCount() const
+{
+    return entries_.size();
+}
+
+size_t StaticApduResponder::GetBytes() const
+{
+    return bytes_;
+}
+
+bool StaticApduResponder::IsValid(const StaticApduResponse& response)
+{
+    return !response.mask_.empty() && response.mask_.size() == response.value_.size() &&
+           response.response_.size() >= MIN_RESPONSE_LENGTH;
+}
+
+size_t StaticApduResponder::EntryBytes(const Entry& entry)
+{
+    return entry.mask_.size() + entry.value_.size() + entry.response_.size();
+}
+
+bool StaticApduResponder::Matches(const Entry& entry, const unsigned char* data, size_t len)
+{
+    if (len < entry.mask_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < entry.mask_.size(); ++i) {
+        if ((data[i] & entry.mask_[i]) != entry.value_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace OHOS::nfc::cardemulation
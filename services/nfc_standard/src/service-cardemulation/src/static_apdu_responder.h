@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATIC_APDU_RESPONDER_H
+#define STATIC_APDU_RESPONDER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "icard_emulation_agent.h"
+
+namespace OHOS::nfc::cardemulation {
+/*
+ * The canned responses registered by a card emulation service. The commands
+ * matching an entry are answered by the nfc service without IPC to the
+ * application, e.g. the well-known selects and GET DATA of a payment service.
+ */
+class StaticApduResponder final {
+public:
+    // for all types of a service
+    static constexpr size_t MAX_ENTRY_COUNT = 8;
+    // masks, values and responses of all types of a service
+    static constexpr size_t MAX_TABLE_BYTES = 1024;
+    // at least the status word
+    static constexpr size_t MIN_RESPONSE_LENGTH = 2;
+
+    StaticApduResponder();
+    ~StaticApduResponder();
+
+    /**
+     * brief: replace the responses of the type
+     * parameter:
+     *   type -- service type
+     *   responses -- responses, empty to remove the ones of the type
+     * return: ERR_OK -- succeeded, ERR_INVALID_STATIC_RESPONSE -- malformed, or over the limits. unchanged on error
+     */
+    int Set(const std::string& type, const std::vector<sdk::cardemulation::StaticApduResponse>& responses);
+    void Remove(const std::string& type);
+    /**
+     * brief: find the response of the command, the first registered entry wins
+     * parameter:
+     *   data -- command apdu
+     *   len -- length of the command apdu
+     * return: response, nullptr when no entry matches
+     */
+    const std::vector<unsigned char>* Match(const unsigned char* data, size_t len) const;
+    bool Empty() const;
+    size_t GetEntryCount() const;
+    size_t GetBytes() const;
+
+private:
+    struct Entry {
+        std::string type_;
+        std::vector<unsigned char> mask_;
+        // masked when set
+        std::vector<unsigned char> value_;
+        std::vector<unsigned char> response_;
+    };
+    static bool IsValid(const sdk::cardemulation::StaticApduResponse& response);
+    static size_t EntryBytes(const Entry& entry);
+    static bool Matches(const Entry& entry, const unsigned char* data, size_t len);
+
+private:
+    std::vector<Entry> entries_;
+    size_t bytes_;
+};
+}  // namespace OHOS::nfc::cardemulation
+#endif  // STATIC_APDU_RESPONDER_H
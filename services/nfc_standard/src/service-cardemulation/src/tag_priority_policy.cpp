@@ -19,6 +19,7 @@
 
 #include <algorithm>
 
+#include "aid_conflict_index.h"
 #include "aid_routing_filter.h"
 #include "aid_routing_table.h"
 #include "aid_set.h"
@@ -68,13 +69,10 @@ std::vector<std::shared_ptr<nfc::cardemulation::AidSet>> TagPriorityPolicy::Plan
 #endif  // DEBUG
 
     std::vector<std::shared_ptr<AidSet>> result;
+    AidConflictIndex accepted;
 
-    auto isTagAllowed = [&result, this](const std::string& type) {
-        auto found = std::find_if(result.begin(), result.end(), [this, type](decltype(result)::reference r) {
-            return (StringEqual(r->GetType(), this->GetPriorType()) && StringEqual(type, r->GetType()));
-        });
-
-        return (found == result.end());
+    auto isTagAllowed = [&accepted, this](const std::string& type) {
+        return !(StringEqual(type, this->GetPriorType()) && accepted.HasType(type));
     };
     auto cmp = CardEmulationServiceInfo::ALessB;
 
@@ -88,24 +86,15 @@ std::vector<std::shared_ptr<nfc::cardemulation::AidSet>> TagPriorityPolicy::Plan
         }
         return owner == primary;
     };
-    auto isAidAllowed = [&result, this, &belongsToPrimary](const std::shared_ptr<AidSet>& aidset) {
-        bool allowed = true;
-        for (auto& r : result) {
-            if (r.get() == aidset.get()) {
-                allowed = false;
-                break;
-            }
-            // aid set conflicting
-            if (aidset->ConflictWith(*r, false))
-                // r belongs to primary
-                if (belongsToPrimary(r) || StringEqual(aidset->GetType(), GetPriorType(), true) ||
-                    !(this->ConflictingTolerant(aidset->GetExecutionEnvironment()))) {
-                    allowed = false;
-                    break;
-                }
+    auto isAidAllowed = [&accepted, this](const std::shared_ptr<AidSet>& aidset) {
+        if (accepted.Contains(aidset.get())) {
+            return false;
         }
-
-        return allowed;
+        // prior type and non-tolerant locations must not conflict with any accepted aid,
+        // the others only with the aids of the primary service.
+        bool primaryOnly = !StringEqual(aidset->GetType(), GetPriorType(), true) &&
+                           this->ConflictingTolerant(aidset->GetExecutionEnvironment());
+        return !accepted.ConflictWith(*aidset, primaryOnly);
     };
     LocationFilter lf(supportedLocations_);
     ModeFilter mf(aidRoutingMode_);
@@ -123,7 +112,7 @@ std::vector<std::shared_ptr<nfc::cardemulation::AidSet>> TagPriorityPolicy::Plan
 
 #endif  // DEBUG
 
-    auto handler = [&result, &filters, &cmp](const std::shared_ptr<CardEmulationServiceInfo>& app) {
+    auto handler = [&result, &accepted, &filters, &cmp, &belongsToPrimary](const std::shared_ptr<CardEmulationServiceInfo>& app) {
 #ifdef DEBUG
         std::vector<std::string> filterNames{"env filter", "pattern filter", "type filter", "aid filter"};
 #endif  // DEBUG
@@ -154,6 +143,7 @@ std::vector<std::shared_ptr<nfc::cardemulation::AidSet>> TagPriorityPolicy::Plan
                 }
             }
             if (allowed) {
+                accepted.Add(aidset, belongsToPrimary(aidset));
                 result.push_back(aidset);
             }
         }
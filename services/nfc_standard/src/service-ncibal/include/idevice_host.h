@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace OHOS {
 namespace nfc {
@@ -92,6 +93,12 @@ public:
     virtual int RegisterT3tIdentifier(std::string& lfT3tIdentifier) = 0;
     virtual void DeregisterT3tIdentifier(std::string& lfT3tIdentifier) = 0;
     virtual void ClearT3tIdentifiersCache() = 0;
+    /**
+     * @brief Replace the registered LF_T3T_IDENTIFIERs, rf discovery is restarted once for all the changes
+     * @param lfT3tIdentifiers the identifiers to keep registered, above GetLfT3tMax are ignored
+     * @return count of the registered identifiers
+     */
+    virtual int UpdateT3tIdentifiers(const std::vector<std::string>& lfT3tIdentifiers) = 0;
     virtual int GetLfT3tMax() = 0;
     virtual int GetLastError() = 0;
     virtual void Abort() = 0;
@@ -23,6 +23,7 @@
 #include "nci_bal_manager.h"
 #include "nci_bal_tag.h"
 #include "tag_end_point.h"
+#include "utils/hce_latency_tracer.h"
 
 namespace OHOS {
 namespace nfc {
@@ -111,9 +112,8 @@ int DeviceHost::RegisterT3tIdentifier(std::string& lfT3tIdentifier)
 void DeviceHost::DeregisterT3tIdentifier(std::string& lfT3tIdentifier)
 {
     DebugLog("DeviceHost::DeregisterT3tIdentifier");
-    // get handle from mT3tIdentifiers
     if (!lfT3tIdentifier.empty()) {
-        int handle = -1;
+        int handle = NciBalManager::GetInstance().GetT3tIdentifierHandle(lfT3tIdentifier);
         NciBalManager::GetInstance().DeregisterT3tIdentifier(handle);
     }
 }
@@ -124,6 +124,12 @@ void DeviceHost::ClearT3tIdentifiersCache()
     NciBalManager::GetInstance().ClearT3tIdentifiersCache();
 }
 
+int DeviceHost::UpdateT3tIdentifiers(const std::vector<std::string>& lfT3tIdentifiers)
+{
+    DebugLog("DeviceHost::UpdateT3tIdentifiers");
+    return NciBalManager::GetInstance().UpdateT3tIdentifiers(lfT3tIdentifiers);
+}
+
 int DeviceHost::GetLfT3tMax()
 {
     DebugLog("DeviceHost::GetLfT3tMax");
@@ -336,6 +342,7 @@ void DeviceHost::HostCardEmulationDeactivated(int technology)
 void DeviceHost::HostCardEmulationDataReceived(int technology, std::string& data)
 {
     DebugLog("DeviceHost::HostCardEmulationDataReceived");
+    HceLatencyTracer::GetInstance().Mark(HceStage::DEVICE_HOST);
     if (mDeviceHostListener_.expired()) {
         ErrorLog("Device host listener is null");
         return;
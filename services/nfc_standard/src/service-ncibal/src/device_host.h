@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../../service-ncibal/include/idevice_host.h"
 
@@ -42,6 +43,7 @@ public:
     virtual int RegisterT3tIdentifier(std::string& lfT3tIdentifier) override;
     virtual void DeregisterT3tIdentifier(std::string& lfT3tIdentifier) override;
     virtual void ClearT3tIdentifiersCache() override;
+    virtual int UpdateT3tIdentifiers(const std::vector<std::string>& lfT3tIdentifiers) override;
     virtual int GetLfT3tMax() override;
     virtual int GetLastError() override;
     virtual void Abort() override;
@@ -104,6 +104,12 @@ public:
                                              tNFA_CONN_CBACK* pConnCback) = 0;
     virtual tNFA_STATUS NfcSetPowerSubStateForScreenState(uint8_t screenState) = 0;
     virtual tNFA_STATUS NfcSetConfig(tNFA_PMID paramId, uint8_t length, uint8_t* pData) = 0;
+    virtual tNFA_STATUS NfcGetConfig(uint8_t numIds, tNFA_PMID* pParamIds) = 0;
+    virtual tNFA_STATUS NfcCeRegisterFelicaSystemCodeOnDH(uint16_t systemCode,
+                                                          uint8_t nfcid2[NCI_RF_F_UID_LEN],
+                                                          uint8_t t3tPmm[NCI_T3T_PMM_LEN],
+                                                          tNFA_CONN_CBACK* pConnCback) = 0;
+    virtual tNFA_STATUS NfcCeDeregisterFelicaSystemCodeOnDH(tNFA_HANDLE handle) = 0;
 };
 }  // namespace ncibal
 }  // namespace nfc
@@ -22,6 +22,7 @@
 #include "loghelper.h"
 #include "nfc_config.h"
 #include "nfc_nci_impl.h"
+#include "utils/hce_latency_tracer.h"
 #include "utils/synchronize_event.h"
 
 namespace OHOS {
@@ -37,6 +38,7 @@ OHOS::nfc::SynchronizeEvent NciBalCe::remainSizeEvent_;
 bool NciBalCe::mAidRoutingConfigured_ = false;
 tNFA_EE_DISCOVER_REQ NciBalCe::mEeInfo_{};
 std::string NciBalCe::mHceData_{};
+bool NciBalCe::mHceDataOverflow_ = false;
 std::shared_ptr<INfcNci> NciBalCe::mNfcNciImpl_ = std::make_shared<NfcNciImpl>();
 int NciBalCe::remainTableSize_ = 0;
 
@@ -232,6 +234,8 @@ bool NciBalCe::InitializeCe()
     // Listen on Nfc-A/Nfc-B
     mNfcNciImpl_->NfcCeSetIsoDepListenTech(mHostListenTech_ & (NFA_TECHNOLOGY_MASK_A | NFA_TECHNOLOGY_MASK_B));
 
+    ResetHceData();
+    mHceData_.reserve(HCE_MAX_APDU_LEN);
     status = mNfcNciImpl_->NfcCeRegisterAidOnDH(NULL, 0, NfcCeCallback);
     if (status != NFA_STATUS_OK) {
         ErrorLog("Failed to register wildcard AID for DH");
@@ -529,19 +533,43 @@ void NciBalCe::HandleHostCardEmulationData(uint8_t technology,
                                            uint32_t dataLen,
                                            tNFA_STATUS status)
 {
-    if (status == NFC_STATUS_CONTINUE || status == NFA_STATUS_OK) {
-        if (dataLen > 0) {
-            mHceData_.append(std::string((const char*)data, dataLen));
-        }
-    } else {
+    if (status != NFC_STATUS_CONTINUE && status != NFA_STATUS_OK) {
         ErrorLog("NciBalCe::HandleHostCardEmulationData fail, status=%u", status);
-        mHceData_ = "";
+        ResetHceData();
         return;
     }
-    if (status == NFA_STATUS_OK) {
-        DeviceHost::HostCardEmulationDataReceived(technology, mHceData_);
-        mHceData_ = "";
+    if (!mHceDataOverflow_ && mHceData_.size() + dataLen > HCE_MAX_APDU_LEN) {
+        ErrorLog("NciBalCe::HandleHostCardEmulationData apdu exceeds %u bytes", HCE_MAX_APDU_LEN);
+        mHceDataOverflow_ = true;
+        mHceData_.clear();
     }
+    if (!mHceDataOverflow_ && dataLen > 0) {
+        if (mHceData_.capacity() < HCE_MAX_APDU_LEN) {
+            mHceData_.reserve(HCE_MAX_APDU_LEN);
+        }
+        mHceData_.append(reinterpret_cast<const char*>(data), dataLen);
+    }
+    if (status != NFA_STATUS_OK) {
+        // more fragments follow
+        return;
+    }
+    if (mHceDataOverflow_) {
+        ResetHceData();
+        // the reader waits for a response, the apdu is not forwarded
+        uint8_t wrongLength[] = {0x67, 0x00};
+        mNfcNciImpl_->NfaSendRawFrame(wrongLength, sizeof(wrongLength), 0);
+        return;
+    }
+    HceLatencyTracer::GetInstance().Begin();
+    // the listeners read the apdu in place during the call
+    DeviceHost::HostCardEmulationDataReceived(technology, mHceData_);
+    ResetHceData();
+}
+
+void NciBalCe::ResetHceData()
+{
+    mHceData_.clear();
+    mHceDataOverflow_ = false;
 }
 
 int NciBalCe::GetDefaultRoute() const
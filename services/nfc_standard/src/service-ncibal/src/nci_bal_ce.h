@@ -57,6 +57,8 @@ private:
     static const int AID_ROUTE_PREFIX_ONLY = 0x02;
     static const int AID_ROUTE_EXACT_OR_SUBSET_OR_PREFIX = 0x03;
     static const int AID_ROUTE_QUAL_PREFIX = 0x10;
+    // the longest extended command apdu: header, 3 bytes Lc, 65535 bytes data and 2 bytes Le
+    static const uint32_t HCE_MAX_APDU_LEN = 65544;
 
     NciBalCe();
     ~NciBalCe();
@@ -72,6 +74,7 @@ private:
                                             const uint8_t* data,
                                             uint32_t dataLen,
                                             tNFA_STATUS status);
+    static void ResetHceData();
     static OHOS::nfc::SynchronizeEvent mEeRegisterEvent_;
     static OHOS::nfc::SynchronizeEvent mAidEvent_;
     static OHOS::nfc::SynchronizeEvent mRoutingCfgEvent_;
@@ -80,7 +83,10 @@ private:
     static OHOS::nfc::SynchronizeEvent remainSizeEvent_;
     static bool mAidRoutingConfigured_;
     static tNFA_EE_DISCOVER_REQ mEeInfo_;
+    // reassembles the fragments of a command apdu, the capacity is kept between apdus
     static std::string mHceData_;
+    // the fragments exceed HCE_MAX_APDU_LEN, the rest of the apdu is dropped
+    static bool mHceDataOverflow_;
     static std::shared_ptr<INfcNci> mNfcNciImpl_;
     static int remainTableSize_;
     bool mNfcSecure_;
@@ -14,7 +14,11 @@
  */
 #include "nci_bal_manager.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <mutex>
+#include <set>
 
 #include "device_host.h"
 #include "loghelper.h"
@@ -38,6 +42,8 @@ OHOS::nfc::SynchronizeEvent NciBalManager::mNfcDisableEvent_;  // event for NFA_
 OHOS::nfc::SynchronizeEvent NciBalManager::mPollingEvent_;     // event for polling
 OHOS::nfc::SynchronizeEvent NciBalManager::setScreenStateEvent_;
 OHOS::nfc::SynchronizeEvent NciBalManager::setConfigEvent_;
+OHOS::nfc::SynchronizeEvent NciBalManager::getConfigEvent_;
+OHOS::nfc::SynchronizeEvent NciBalManager::mT3tEvent_;
 
 bool NciBalManager::mIsNfcEnabled_ = false;
 bool NciBalManager::mRfEnabled_ = false;
@@ -49,8 +55,33 @@ unsigned long NciBalManager::mDiscoveryDuration_;
 bool NciBalManager::mIsReconnect_ = false;
 bool NciBalManager::mIsTagActive_ = false;
 unsigned char NciBalManager::curScreenState_ = NFA_SCREEN_STATE_OFF_LOCKED;
+int NciBalManager::mLfT3tMax_ = 0;
+tNFA_HANDLE NciBalManager::mT3tHandle_ = NFA_HANDLE_INVALID;
+std::map<std::string, tNFA_HANDLE> NciBalManager::mT3tIdentifiers_;
 std::shared_ptr<INfcNci> NciBalManager::mNfcNciImpl_ = std::make_shared<NfcNciImpl>();
 
+// system code(2B) + nfcid2(8B) + pmm(8B)
+static const size_t T3T_SYSTEM_CODE_LEN = 2;
+static const size_t T3T_IDENTIFIER_LEN = T3T_SYSTEM_CODE_LEN + NCI_RF_F_UID_LEN + NCI_T3T_PMM_LEN;
+static const size_t HEX_CHARS_PER_BYTE = 2;
+static const int HEX_BASE = 16;
+
+// upper case hex of the identifier, empty when it is malformed
+static std::string NormalizeT3tIdentifier(const std::string& lfT3tIdentifier)
+{
+    if (lfT3tIdentifier.size() != T3T_IDENTIFIER_LEN * HEX_CHARS_PER_BYTE) {
+        return "";
+    }
+    std::string rv(lfT3tIdentifier);
+    for (char& c : rv) {
+        if (!std::isxdigit(static_cast<unsigned char>(c))) {
+            return "";
+        }
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return rv;
+}
+
 NciBalManager::NciBalManager() = default;
 
 NciBalManager::~NciBalManager() = default;
@@ -344,6 +375,21 @@ void NciBalManager::NfcDeviceManagementCallback(uint8_t dmEvent, tNFA_DM_CBACK_D
             break;
         }
 
+        case NFA_DM_GET_CONFIG_EVT: {
+            DebugLog("NfaDeviceManagementCallback: NFA_DM_GET_CONFIG_EVT");
+            SynchronizeGuard guard(getConfigEvent_);
+            const uint8_t* tlv = eventData->get_config.param_tlvs;
+            uint16_t size = (eventData->get_config.status == NFA_STATUS_OK) ? eventData->get_config.tlv_size : 0;
+            // id, length, value
+            for (uint16_t i = 0; i + 2 <= size && i + 2 + tlv[i + 1] <= size; i += 2 + tlv[i + 1]) {
+                if (tlv[i] == NCI_PARAM_ID_LF_T3T_MAX && tlv[i + 1] > 0) {
+                    mLfT3tMax_ = tlv[i + 2];
+                }
+            }
+            getConfigEvent_.NotifyOne();
+            break;
+        }
+
         case NFA_DM_SET_POWER_SUB_STATE_EVT: {
             DebugLog("NfaDeviceManagementCallback: NFA_DM_SET_POWER_SUB_STATE_EVT; status=0x%X",
                      eventData->power_sub_state.status);
@@ -388,6 +434,7 @@ bool NciBalManager::Initialize()
 #ifdef _NFC_SERVICE_HCE_
             NciBalCe::GetInstance().InitializeCe();
             HciManager::GetInstance().Initialize();
+            QueryLfT3tMax();
 #endif
             mDiscoveryDuration_ = DEFAULT_DISCOVERY_DURATION;
             mNfcNciImpl_->NfaSetRfDiscoveryDuration((uint16_t)mDiscoveryDuration_);
@@ -441,6 +488,9 @@ bool NciBalManager::Deinitialize()
     mDiscoveryEnabled_ = false;
     mIsDisabling_ = false;
     mPollingEnabled_ = false;
+    // NFA_Disable drops the registrations
+    mT3tIdentifiers_.clear();
+    mLfT3tMax_ = 0;
     NciBalTag::GetInstance().AbortWait();
     {
         // unblock NFA_EnablePolling() and NFA_DisablePolling()
@@ -612,30 +662,208 @@ int NciBalManager::GetIsoDepMaxTransceiveLength()
     ;
 }
 
-bool NciBalManager::RegisterT3tIdentifier(const std::string& lfT3tIdentifier) const
+bool NciBalManager::RegisterT3tIdentifier(const std::string& lfT3tIdentifier)
 {
     DebugLog("NciBalManager::RegisterT3tIdentifier");
-    if (lfT3tIdentifier.empty()) {
+    std::string key = NormalizeT3tIdentifier(lfT3tIdentifier);
+    if (key.empty()) {
+        ErrorLog("NciBalManager::RegisterT3tIdentifier: invalid identifier");
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mMutex_);
+    if (mT3tIdentifiers_.find(key) != mT3tIdentifiers_.end()) {
+        return true;
+    }
+    if (static_cast<int>(mT3tIdentifiers_.size()) >= mLfT3tMax_) {
+        ErrorLog("NciBalManager::RegisterT3tIdentifier: LF_T3T_MAX %d reached", mLfT3tMax_);
+        return false;
     }
-    return false;
+    tNFA_HANDLE handle = DoRegisterT3tIdentifier(key);
+    if (handle == NFA_HANDLE_INVALID) {
+        return false;
+    }
+    mT3tIdentifiers_[key] = handle;
+    return true;
 }
 
-void NciBalManager::DeregisterT3tIdentifier(int handle) const
+void NciBalManager::DeregisterT3tIdentifier(int handle)
 {
     DebugLog("NciBalManager::DeregisterT3tIdentifier");
     if (handle < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex_);
+    auto it = std::find_if(mT3tIdentifiers_.begin(), mT3tIdentifiers_.end(), [handle](const auto& registered) {
+        return registered.second == static_cast<tNFA_HANDLE>(handle);
+    });
+    if (it == mT3tIdentifiers_.end()) {
+        return;
+    }
+    DoDeregisterT3tIdentifier(it->second);
+    mT3tIdentifiers_.erase(it);
+}
+
+int NciBalManager::GetT3tIdentifierHandle(const std::string& lfT3tIdentifier)
+{
+    std::lock_guard<std::mutex> lock(mMutex_);
+    auto it = mT3tIdentifiers_.find(NormalizeT3tIdentifier(lfT3tIdentifier));
+    return (it != mT3tIdentifiers_.end()) ? it->second : -1;
+}
+
+int NciBalManager::UpdateT3tIdentifiers(const std::vector<std::string>& lfT3tIdentifiers)
+{
+    DebugLog("NciBalManager::UpdateT3tIdentifiers, count: %zu", lfT3tIdentifiers.size());
+    std::set<std::string> wanted;
+    for (auto& identifier : lfT3tIdentifiers) {
+        std::string key = NormalizeT3tIdentifier(identifier);
+        if (key.empty()) {
+            ErrorLog("NciBalManager::UpdateT3tIdentifiers: invalid identifier ignored");
+            continue;
+        }
+        wanted.insert(std::move(key));
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex_);
+    std::vector<std::string> removed;
+    for (auto& registered : mT3tIdentifiers_) {
+        if (wanted.find(registered.first) == wanted.end()) {
+            removed.push_back(registered.first);
+        }
+    }
+    std::vector<std::string> added;
+    for (auto& key : wanted) {
+        if (mT3tIdentifiers_.find(key) == mT3tIdentifiers_.end()) {
+            added.push_back(key);
+        }
+    }
+    // the slots freed by the removed identifiers are given to the added ones
+    size_t room = static_cast<size_t>(std::max(mLfT3tMax_, 0));
+    room = (room > mT3tIdentifiers_.size() - removed.size()) ? room - (mT3tIdentifiers_.size() - removed.size()) : 0;
+    if (added.size() > room) {
+        ErrorLog("NciBalManager::UpdateT3tIdentifiers: LF_T3T_MAX %d, %zu identifiers ignored",
+                 mLfT3tMax_,
+                 added.size() - room);
+        added.resize(room);
+    }
+    if (removed.empty() && added.empty()) {
+        return static_cast<int>(mT3tIdentifiers_.size());
+    }
+
+    // the identifiers are changed with rf discovery stopped, once for the whole batch
+    bool restart = mRfEnabled_;
+    if (restart) {
+        StartRfDiscovery(false);
+    }
+    for (auto& key : removed) {
+        DoDeregisterT3tIdentifier(mT3tIdentifiers_[key]);
+        mT3tIdentifiers_.erase(key);
+    }
+    for (auto& key : added) {
+        tNFA_HANDLE handle = DoRegisterT3tIdentifier(key);
+        if (handle != NFA_HANDLE_INVALID) {
+            mT3tIdentifiers_[key] = handle;
+        }
+    }
+    if (restart) {
+        StartRfDiscovery(true);
+    }
+    InfoLog("NciBalManager::UpdateT3tIdentifiers: removed %zu, added %zu, registered %zu",
+            removed.size(),
+            added.size(),
+            mT3tIdentifiers_.size());
+    return static_cast<int>(mT3tIdentifiers_.size());
+}
+
+tNFA_HANDLE NciBalManager::DoRegisterT3tIdentifier(const std::string& lfT3tIdentifier)
+{
+    uint8_t bytes[T3T_IDENTIFIER_LEN];
+    for (size_t i = 0; i < T3T_IDENTIFIER_LEN; i++) {
+        bytes[i] = static_cast<uint8_t>(
+            std::stoi(lfT3tIdentifier.substr(i * HEX_CHARS_PER_BYTE, HEX_CHARS_PER_BYTE), nullptr, HEX_BASE));
+    }
+    uint16_t systemCode = static_cast<uint16_t>((bytes[0] << 8) | bytes[1]);
+    uint8_t nfcid2[NCI_RF_F_UID_LEN];
+    uint8_t t3tPmm[NCI_T3T_PMM_LEN];
+    memcpy(nfcid2, bytes + T3T_SYSTEM_CODE_LEN, NCI_RF_F_UID_LEN);
+    memcpy(t3tPmm, bytes + T3T_SYSTEM_CODE_LEN + NCI_RF_F_UID_LEN, NCI_T3T_PMM_LEN);
+
+    SynchronizeGuard guard(mT3tEvent_);
+    mT3tHandle_ = NFA_HANDLE_INVALID;
+    tNFA_STATUS status = mNfcNciImpl_->NfcCeRegisterFelicaSystemCodeOnDH(systemCode, nfcid2, t3tPmm, NfcT3tCallback);
+    if (status != NFA_STATUS_OK) {
+        ErrorLog("NciBalManager::DoRegisterT3tIdentifier: fail register; error = 0x%X", status);
+        return NFA_HANDLE_INVALID;
+    }
+    if (!mT3tEvent_.Wait(T3T_EVENT_TIMEOUT_MS)) {
+        ErrorLog("NciBalManager::DoRegisterT3tIdentifier: timeout");
+    }
+    return mT3tHandle_;
+}
+
+void NciBalManager::DoDeregisterT3tIdentifier(tNFA_HANDLE handle)
+{
+    SynchronizeGuard guard(mT3tEvent_);
+    tNFA_STATUS status = mNfcNciImpl_->NfcCeDeregisterFelicaSystemCodeOnDH(handle);
+    if (status != NFA_STATUS_OK) {
+        ErrorLog("NciBalManager::DoDeregisterT3tIdentifier: fail deregister; error = 0x%X", status);
+        return;
+    }
+    if (!mT3tEvent_.Wait(T3T_EVENT_TIMEOUT_MS)) {
+        ErrorLog("NciBalManager::DoDeregisterT3tIdentifier: timeout");
+    }
+}
+
+void NciBalManager::NfcT3tCallback(uint8_t event, tNFA_CONN_EVT_DATA* eventData)
+{
+    switch (event) {
+        case NFA_CE_REGISTERED_EVT: {
+            DebugLog("NfcT3tCallback: NFA_CE_REGISTERED_EVT: status = 0x%X", eventData->ce_registered.status);
+            SynchronizeGuard guard(mT3tEvent_);
+            if (eventData->ce_registered.status == NFA_STATUS_OK) {
+                mT3tHandle_ = eventData->ce_registered.handle;
+            }
+            mT3tEvent_.NotifyOne();
+            break;
+        }
+        case NFA_CE_DEREGISTERED_EVT: {
+            DebugLog("NfcT3tCallback: NFA_CE_DEREGISTERED_EVT");
+            SynchronizeGuard guard(mT3tEvent_);
+            mT3tEvent_.NotifyOne();
+            break;
+        }
+        default: {
+            DebugLog("NfcT3tCallback: unhandled event %u", event);
+            break;
+        }
     }
 }
 
 void NciBalManager::ClearT3tIdentifiersCache()
 {
     DebugLog("NciBalManager::ClearT3tIdentifiersCache");
+    GetInstance().UpdateT3tIdentifiers({});
 }
 
 int NciBalManager::GetLfT3tMax()
 {
     DebugLog("NciBalManager::GetLfT3tMax");
-    return 0;
+    return mLfT3tMax_;
+}
+
+void NciBalManager::QueryLfT3tMax()
+{
+    SynchronizeGuard guard(getConfigEvent_);
+    mLfT3tMax_ = 0;
+    tNFA_PMID paramId = NCI_PARAM_ID_LF_T3T_MAX;
+    tNFA_STATUS status = mNfcNciImpl_->NfcGetConfig(1, &paramId);
+    if (status != NFA_STATUS_OK) {
+        ErrorLog("NciBalManager::QueryLfT3tMax: fail get config; error = 0x%X", status);
+        return;
+    }
+    if (!getConfigEvent_.Wait(T3T_EVENT_TIMEOUT_MS)) {
+        ErrorLog("NciBalManager::QueryLfT3tMax: timeout");
+    }
+    DebugLog("NciBalManager::QueryLfT3tMax: LF_T3T_MAX = %d", mLfT3tMax_);
 }
 
 int NciBalManager::GetLastError()
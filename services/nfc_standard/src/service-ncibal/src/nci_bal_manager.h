@@ -15,8 +15,11 @@
 #ifndef NCI_BAL_MANAGER_H
 #define NCI_BAL_MANAGER_H
 
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include "nfa_api.h"
 
@@ -44,8 +47,17 @@ public:
     bool SendRawFrame(std::string& rawData);
     void SetScreenStatus(unsigned char screenStateMask) const;
     int GetNciVersion() const;
-    bool RegisterT3tIdentifier(const std::string& lfT3tIdentifier) const;
-    void DeregisterT3tIdentifier(int handle) const;
+    bool RegisterT3tIdentifier(const std::string& lfT3tIdentifier);
+    void DeregisterT3tIdentifier(int handle);
+    // handle of the registered identifier, -1 when it is not registered
+    int GetT3tIdentifierHandle(const std::string& lfT3tIdentifier);
+    /**
+     * brief: registers the identifiers not registered yet and deregisters the registered ones not listed,
+     *        rf discovery is stopped once for all the changes and restarted if it was running
+     * parameter: lfT3tIdentifiers -- hex of system code(2B) + nfcid2(8B) + pmm(8B), above GetLfT3tMax are ignored
+     * return: count of the registered identifiers
+     */
+    int UpdateT3tIdentifiers(const std::vector<std::string>& lfT3tIdentifiers);
     bool CheckFirmware();
     void Dump(int fd) const;
     void FactoryReset() const;
@@ -61,18 +73,25 @@ private:
     static const int DEFAULT_DISCOVERY_DURATION = 500;
     static const int DISCOVERY_DURATION = 200;
     static const int NFA_SCREEN_POLLING_TAG_MASK = 0x10;
+    static const int T3T_EVENT_TIMEOUT_MS = 1000;
     NciBalManager();
     ~NciBalManager();
     tNFA_STATUS StartPolling(tNFA_TECHNOLOGY_MASK techMask) const;
     tNFA_STATUS StopPolling() const;
     static void NfcConnectionCallback(uint8_t connEvent, tNFA_CONN_EVT_DATA* eventData);
     static void NfcDeviceManagementCallback(uint8_t dmEvent, tNFA_DM_CBACK_DATA* eventData);
+    static void NfcT3tCallback(uint8_t event, tNFA_CONN_EVT_DATA* eventData);
+    static void QueryLfT3tMax();
+    static tNFA_HANDLE DoRegisterT3tIdentifier(const std::string& lfT3tIdentifier);
+    static void DoDeregisterT3tIdentifier(tNFA_HANDLE handle);
     std::mutex mMutex_{};
     static OHOS::nfc::SynchronizeEvent mNfcEnableEvent_;   // event for NFA_Enable()
     static OHOS::nfc::SynchronizeEvent mNfcDisableEvent_;  // event for NFA_Disable()
     static OHOS::nfc::SynchronizeEvent mPollingEvent_;     // event for polling
     static OHOS::nfc::SynchronizeEvent setScreenStateEvent_;
     static OHOS::nfc::SynchronizeEvent setConfigEvent_;
+    static OHOS::nfc::SynchronizeEvent getConfigEvent_;
+    static OHOS::nfc::SynchronizeEvent mT3tEvent_;  // event for NFA_CeRegister/DeregisterFelicaSystemCodeOnDH()
     static bool mIsNfcEnabled_;
     static bool mRfEnabled_;
     static bool mDiscoveryEnabled_;  // is polling or listening
@@ -83,6 +102,10 @@ private:
     static bool mIsReconnect_;
     static bool mIsTagActive_;
     static unsigned char curScreenState_;
+    static int mLfT3tMax_;
+    static tNFA_HANDLE mT3tHandle_;
+    // registered identifiers, upper case hex to handle
+    static std::map<std::string, tNFA_HANDLE> mT3tIdentifiers_;
     static std::shared_ptr<INfcNci> mNfcNciImpl_;
 };
 }  // namespace ncibal
@@ -299,6 +299,24 @@ tNFA_STATUS NfcNciImpl::NfcSetConfig(tNFA_PMID paramId, uint8_t length, uint8_t*
 {
     return NFA_SetConfig(paramId, length, pData);
 }
+
+tNFA_STATUS NfcNciImpl::NfcGetConfig(uint8_t numIds, tNFA_PMID* pParamIds)
+{
+    return NFA_GetConfig(numIds, pParamIds);
+}
+
+tNFA_STATUS NfcNciImpl::NfcCeRegisterFelicaSystemCodeOnDH(uint16_t systemCode,
+                                                          uint8_t nfcid2[NCI_RF_F_UID_LEN],
+                                                          uint8_t t3tPmm[NCI_T3T_PMM_LEN],
+                                                          tNFA_CONN_CBACK* pConnCback)
+{
+    return NFA_CeRegisterFelicaSystemCodeOnDH(systemCode, nfcid2, t3tPmm, pConnCback);
+}
+
+tNFA_STATUS NfcNciImpl::NfcCeDeregisterFelicaSystemCodeOnDH(tNFA_HANDLE handle)
+{
+    return NFA_CeDeregisterFelicaSystemCodeOnDH(handle);
+}
 }  // namespace ncibal
 }  // namespace nfc
 }  // namespace OHOS
\ No newline at end of file
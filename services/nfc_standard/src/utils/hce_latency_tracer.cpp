@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/hce_latency_tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+namespace OHOS {
+namespace nfc {
+static constexpr int64_t NANOSECOND_PER_MICROSECOND = 1000;
+
+const std::string HceLatencyTracer::UNRESOLVED_SERVICE = "<unresolved>";
+const std::string HceLatencyTracer::OTHER_SERVICES = "<others>";
+
+std::string HceStageToString(HceStage stage)
+{
+    switch (stage) {
+        case HceStage::RF_RECEIVED:
+            return "rf_received";
+        case HceStage::DEVICE_HOST:
+            return "device_host";
+        case HceStage::DISPATCHED:
+            return "dispatched";
+        case HceStage::AID_RESOLVED:
+            return "aid_resolved";
+        case HceStage::SENT_TO_APP:
+            return "sent_to_app";
+        case HceStage::APP_RESPONDED:
+            return "app_responded";
+        case HceStage::SENT_TO_READER:
+            return "sent_to_reader";
+        default:
+            return "unknown";
+    }
+}
+
+static size_t BucketOf(uint64_t us)
+{
+    size_t bucket = 0;
+    while (us > 1 && bucket + 1 < LatencyHistogram::BUCKET_COUNT) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void LatencyHistogram::Add(uint64_t us)
+{
+    ++buckets_[BucketOf(us)];
+    ++count_;
+    sum_ += us;
+    max_ = std::max(max_, us);
+}
+
+uint64_t LatencyHistogram::Percentile(double percent) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    percent = std::min(std::max(percent, 0.0), 100.0);
+    uint64_t rank = static_cast<uint64_t>(percent * count_ / 100);
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i + 1 < BUCKET_COUNT; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::min<uint64_t>(max_, (static_cast<uint64_t>(1) << (i + 1)) - 1);
+        }
+    }
+    return max_;
+}
+
+uint64_t LatencyHistogram::GetCount() const
+{
+    return count_;
+}
+
+uint64_t LatencyHistogram::GetMean() const
+{
+    return count_ ? sum_ / count_ : 0;
+}
+
+uint64_t LatencyHistogram::GetMax() const
+{
+    return max_;
+}
+
+std::string LatencyHistogram::ToString() const
+{
+    std::stringstream ss;
+    ss << "count: " << count_ << ", mean: " << GetMean() << "us, p50: " << Percentile(50)
+       << "us, p90: " << Percentile(90) << "us, p99: " << Percentile(99) << "us, max: " << max_ << "us";
+    return ss.str();
+}
+
+HceLatencyTracer& HceLatencyTracer::GetInstance()
+{
+    static HceLatencyTracer tracer;
+    return tracer;
+}
+
+HceLatencyTracer::HceLatencyTracer(Clock clock)
+    : clock_(std::move(clock)),
+    open_(0),
+    seq_(0),
+    stamps_(),
+    abandoned_(0),
+    mu_(),
+    service_(),
+    services_(),
+    stages_()
+{
+}
+
+int64_t HceLatencyTracer::Now() const
+{
+    if (clock_) {
+        return clock_();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void HceLatencyTracer::Begin()
+{
+    int64_t now = Now();
+    // closed first, a late mark of the previous command is not taken into the new trace
+    if (open_.exchange(0) != 0) {
+        // the reader did not wait for the response
+        abandoned_.fetch_add(1, std::memory_order_relaxed);
+    }
+    for (auto& stamp : stamps_) {
+        stamp.store(0, std::memory_order_relaxed);
+    }
+    stamps_[static_cast<size_t>(HceStage::RF_RECEIVED)].store(now, std::memory_order_relaxed);
+    open_.store(seq_.fetch_add(1) + 1, std::memory_order_release);
+}
+
+void HceLatencyTracer::Mark(HceStage stage)
+{
+    if (stage >= HceStage::COUNT || open_.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+    stamps_[static_cast<size_t>(stage)].store(Now(), std::memory_order_relaxed);
+}
+
+void HceLatencyTracer::SetService(const std::string& service)
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    service_ = service;
+}
+
+void HceLatencyTracer::End()
+{
+    int64_t now = Now();
+    if (open_.exchange(0, std::memory_order_acq_rel) == 0) {
+        return;
+    }
+    Trace trace;
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        trace.stamps_[i] = stamps_[i].load(std::memory_order_relaxed);
+    }
+    trace.stamps_[static_cast<size_t>(HceStage::SENT_TO_READER)] = now;
+    std::lock_guard<std::mutex> lk(mu_);
+    Close(trace);
+}
+
+void HceLatencyTracer::Deactivate()
+{
+    if (open_.exchange(0) != 0) {
+        abandoned_.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lk(mu_);
+    service_.clear();
+}
+
+void HceLatencyTracer::Reset()
+{
+    open_.store(0);
+    abandoned_.store(0);
+    std::lock_guard<std::mutex> lk(mu_);
+    service_.clear();
+    services_.clear();
+    stages_ = {};
+}
+
+// under mu_
+void HceLatencyTracer::Close(const Trace& trace)
+{
+    auto stamp = [&trace](HceStage stage) { return trace.stamps_[static_cast<size_t>(stage)]; };
+    int64_t previous = stamp(HceStage::RF_RECEIVED);
+    for (size_t i = 1; i < STAGE_COUNT; ++i) {
+        if (trace.stamps_[i] == 0) {
+            continue;
+        }
+        stages_[i].Add(static_cast<uint64_t>(std::max<int64_t>(trace.stamps_[i] - previous, 0)) /
+                       NANOSECOND_PER_MICROSECOND);
+        previous = trace.stamps_[i];
+    }
+
+    uint64_t total = static_cast<uint64_t>(std::max<int64_t>(stamp(HceStage::SENT_TO_READER) -
+                                                             stamp(HceStage::RF_RECEIVED), 0)) /
+                     NANOSECOND_PER_MICROSECOND;
+    uint64_t app = 0;
+    bool handledByApp = stamp(HceStage::SENT_TO_APP) != 0 && stamp(HceStage::APP_RESPONDED) != 0;
+    if (handledByApp) {
+        app = static_cast<uint64_t>(std::max<int64_t>(stamp(HceStage::APP_RESPONDED) - stamp(HceStage::SENT_TO_APP),
+                                                      0)) /
+              NANOSECOND_PER_MICROSECOND;
+        app = std::min(app, total);
+    }
+    auto& latency = GetOrCreateService();
+    latency.total_.Add(total);
+    if (handledByApp) {
+        latency.app_.Add(app);
+    }
+    latency.stack_.Add(total - app);
+}
+
+// under mu_
+ServiceLatency& HceLatencyTracer::GetOrCreateService()
+{
+    const std::string& name = service_.empty() ? UNRESOLVED_SERVICE : service_;
+    auto it = services_.find(name);
+    if (it != services_.end()) {
+        return it->second;
+    }
+    if (services_.size() >= MAX_TRACED_SERVICES) {
+        return services_[OTHER_SERVICES];
+    }
+    return services_[name];
+}
+
+bool HceLatencyTracer::GetServiceLatency(const std::string& service, ServiceLatency& latency) const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = services_.find(service);
+    if (it == services_.end()) {
+        return false;
+    }
+    latency = it->second;
+    return true;
+}
+
+std::vector<std::string> HceLatencyTracer::GetTracedServices() const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    std::vector<std::string> rv;
+    for (auto& s : services_) {
+        rv.push_back(s.first);
+    }
+    return rv;
+}
+
+LatencyHistogram HceLatencyTracer::GetStageLatency(HceStage stage) const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    if (stage >= HceStage::COUNT) {
+        return LatencyHistogram();
+    }
+    return stages_[static_cast<size_t>(stage)];
+}
+
+uint64_t HceLatencyTracer::GetAbandonedCount() const
+{
+    return abandoned_.load();
+}
+
+std::string HceLatencyTracer::Dump() const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+    std::stringstream ss;
+    ss << "hce apdu latency, traced: " << seq_.load() << ", abandoned: " << abandoned_.load() << "\n";
+    for (size_t i = 1; i < STAGE_COUNT; ++i) {
+        if (stages_[i].GetCount() == 0) {
+            continue;
+        }
+        ss << "  stage: " << HceStageToString(static_cast<HceStage>(i)) << ", " << stages_[i].ToString() << "\n";
+    }
+    for (auto& s : services_) {
+        ss << "  service: " << s.first << "\n";
+        ss << "    total: " << s.second.total_.ToString() << "\n";
+        ss << "    app: " << s.second.app_.ToString() << "\n";
+        ss << "    stack: " << s.second.stack_.ToString() << "\n";
+    }
+    return ss.str();
+}
+}  // namespace nfc
+}  // namespace OHOS
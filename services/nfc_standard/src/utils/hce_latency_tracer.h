@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HCE_LATENCY_TRACER_H
+#define HCE_LATENCY_TRACER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace nfc {
+// the points a command apdu passes from the rf to the application and back, in order
+enum class HceStage {
+    RF_RECEIVED = 0,       // NciBalCe::HandleHostCardEmulationData, the apdu is complete
+    DEVICE_HOST,           // DeviceHost::HostCardEmulationDataReceived
+    DISPATCHED,            // CardEmulationEventHandler::OnHCEData
+    AID_RESOLVED,          // the service of the select apdu is found
+    SENT_TO_APP,           // ApduChannelProxy::Send
+    APP_RESPONDED,         // CardEmulationEventHandler::HandleApduResponse
+    SENT_TO_READER,        // CardEmulationEventHandler::SendDataToReader
+    COUNT
+};
+std::string HceStageToString(HceStage stage);
+
+// log2 buckets of microseconds, the last bucket keeps everything above
+class LatencyHistogram final {
+public:
+    static constexpr size_t BUCKET_COUNT = 21;
+
+    void Add(uint64_t us);
+    /**
+     * brief: upper bound of the bucket holding the percentile
+     * parameter: percent -- 0 ~ 100
+     * return: microseconds, 0 when empty
+     */
+    uint64_t Percentile(double percent) const;
+    uint64_t GetCount() const;
+    uint64_t GetMean() const;
+    uint64_t GetMax() const;
+    std::string ToString() const;
+
+private:
+    std::array<uint64_t, BUCKET_COUNT> buckets_{};
+    uint64_t count_{0};
+    uint64_t sum_{0};
+    uint64_t max_{0};
+};
+
+class ServiceLatency final {
+public:
+    // from the rf to the response sent to the reader
+    LatencyHistogram total_{};
+    // from ApduChannelProxy::Send to the response of the application
+    LatencyHistogram app_{};
+    // total without app
+    LatencyHistogram stack_{};
+};
+
+/*
+ * Timestamps every command apdu at the stages of the hce path and keeps the
+ * latency histograms per service and per stage. The hce link is half duplex,
+ * the reader waits for the response before sending the next command, so one
+ * trace is open at a time: a command arriving before the response of the
+ * previous one closes the previous trace as abandoned. The stamps are stored
+ * without a lock, the histograms are updated under the lock when the trace is
+ * closed.
+ */
+class HceLatencyTracer final {
+public:
+    // monotonic nanoseconds
+    using Clock = std::function<int64_t()>;
+    // services above are counted together
+    static constexpr size_t MAX_TRACED_SERVICES = 32;
+    static const std::string UNRESOLVED_SERVICE;
+    static const std::string OTHER_SERVICES;
+
+    static HceLatencyTracer& GetInstance();
+    explicit HceLatencyTracer(Clock clock = nullptr);
+    HceLatencyTracer(const HceLatencyTracer&) = delete;
+    HceLatencyTracer& operator=(const HceLatencyTracer&) = delete;
+
+    // a command apdu is received from the rf, opens its trace
+    void Begin();
+    // the open trace passes the stage, ignored without an open trace
+    void Mark(HceStage stage);
+    /**
+     * brief: the service the following apdus are attributed to, kept until the next select or deactivation
+     * parameter: service -- name of the service, empty when no service handles the apdus
+     */
+    void SetService(const std::string& service);
+    // the response is sent to the reader, closes the open trace
+    void End();
+    // the link is deactivated
+    void Deactivate();
+    void Reset();
+
+    /**
+     * brief: latency of the apdus of a service
+     * parameter:
+     *   service -- name of the service, UNRESOLVED_SERVICE or OTHER_SERVICES
+     *   latency[out] -- histograms of the service
+     * return: true -- the service has traced apdus
+     */
+    bool GetServiceLatency(const std::string& service, ServiceLatency& latency) const;
+    std::vector<std::string> GetTracedServices() const;
+    // time from the previous reached stage to the stage
+    LatencyHistogram GetStageLatency(HceStage stage) const;
+    uint64_t GetAbandonedCount() const;
+    std::string Dump() const;
+
+private:
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(HceStage::COUNT);
+    struct Trace {
+        // 0 when the stage is not reached
+        std::array<int64_t, STAGE_COUNT> stamps_;
+    };
+
+    int64_t Now() const;
+    void Close(const Trace& trace);
+    ServiceLatency& GetOrCreateService();
+
+private:
+    Clock clock_;
+    // the sequence number of the open trace, 0 when none is open
+    std::atomic<uint64_t> open_;
+    std::atomic<uint64_t> seq_;
+    std::array<std::atomic<int64_t>, STAGE_COUNT> stamps_;
+    std::atomic<uint64_t> abandoned_;
+    // guards the service and the histograms
+    mutable std::mutex mu_;
+    std::string service_;
+    std::map<std::string, ServiceLatency> services_;
+    std::array<LatencyHistogram, STAGE_COUNT> stages_;
+};
+}  // namespace nfc
+}  // namespace OHOS
+#endif  // !HCE_LATENCY_TRACER_H
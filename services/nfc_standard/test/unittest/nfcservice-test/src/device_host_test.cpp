@@ -17,6 +17,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "device_host.h"
 #include "nci_bal_manager.h"
 #include "nfc_nci_mock.h"
@@ -33,10 +35,17 @@ public:
     virtual void OnRemoteFieldDeactivated(){};
     virtual void OnHostCardEmulationActivated(int technology){};
     virtual void OnHostCardEmulationDeactivated(int technology){};
-    virtual void OnHostCardEmulationDataReceived(int technology, std::string& data){};
+    virtual void OnHostCardEmulationDataReceived(int technology, std::string& data)
+    {
+        ++hceDataCount_;
+        hceData_ = data;
+    };
     virtual void OnTagDiscovered(std::shared_ptr<ITagEndPoint> tagEndPoint){};
     virtual void OnOffHostTransactionEvent(std::string& aid, std::string& data, std::string& seName){};
     virtual void OnEeUpdate(){};
+
+    int hceDataCount_{0};
+    std::string hceData_{};
 };
 
 class DeviceHostTest : public ::testing::Test {
@@ -44,9 +53,8 @@ public:
     virtual void SetUp() override
     {
         std::cout << " SetUpTestCase." << std::endl;
-        std::shared_ptr<DeviceHostTestListenerDemo> listener =
-            std::make_shared<DeviceHostTestListenerDemo>(DeviceHostTestListenerDemo());
-        deviceHost_ = std::make_shared<OHOS::nfc::ncibal::DeviceHost>(listener);
+        listener_ = std::make_shared<DeviceHostTestListenerDemo>();
+        deviceHost_ = std::make_shared<OHOS::nfc::ncibal::DeviceHost>(listener_);
         nfcNciMock_ = std::make_shared<NfcNciMock>();
         deviceHost_->SetNfcNciImpl(nfcNciMock_);
         EXPECT_TRUE(deviceHost_->Initialize());
@@ -60,8 +68,33 @@ public:
 public:
     std::shared_ptr<DeviceHost> deviceHost_{};
     std::shared_ptr<NfcNciMock> nfcNciMock_{};
+    std::shared_ptr<DeviceHostTestListenerDemo> listener_{};
 };
 
+// delivers the apdu to NciBalCe in fragments of the given size
+static void SendCeDataInFragments(std::string& apdu, size_t fragmentLen)
+{
+    tNFA_CONN_EVT_DATA connEventData;
+    for (size_t offset = 0; offset < apdu.size(); offset += fragmentLen) {
+        size_t len = std::min(fragmentLen, apdu.size() - offset);
+        connEventData.ce_data.status = (offset + len < apdu.size()) ? NFC_STATUS_CONTINUE : NFA_STATUS_OK;
+        connEventData.ce_data.p_data = reinterpret_cast<uint8_t*>(&apdu[offset]);
+        connEventData.ce_data.len = static_cast<uint16_t>(len);
+        NfcNciMock::NfcCeCallback(NFA_CE_DATA_EVT, &connEventData);
+    }
+}
+
+// an extended case 4 command apdu
+static std::string CreateExtendedApdu(size_t dataLen)
+{
+    std::string apdu = {0x00, (char)0xD6, 0x00, 0x00, 0x00, (char)(dataLen >> 8), (char)(dataLen & 0xFF)};
+    for (size_t i = 0; i < dataLen; ++i) {
+        apdu.push_back(static_cast<char>(i));
+    }
+    apdu.append({0x00, 0x00});
+    return apdu;
+}
+
 /**
  * @tc.number    : NFC_DEVICE_HOST_API_0001
  * @tc.name      : Initialize_Test
@@ -759,4 +792,99 @@ TEST_F(DeviceHostTest, RfFieldOffEvent_Test)
     dmEventData.rf_field.status = NFA_STATUS_OK;
     dmEventData.rf_field.rf_field_status = NFA_DM_RF_FIELD_OFF;
     NfcNciMock::NfcDeviceManagementCallback(NFA_DM_RF_FIELD_EVT, &dmEventData);
-}
\ No newline at end of file
+}
+/**
+ * @tc.number    : NFC_DEVICE_HOST_API_0064
+ * @tc.name      : HceFragmentedExtendedApdu_Test
+ * @tc.desc      : NciBalCe reassembles 64 KB command apdus delivered in fragments
+ */
+TEST_F(DeviceHostTest, HceFragmentedExtendedApdu_Test)
+{
+    std::string apdu = CreateExtendedApdu(0xFFFF);
+    for (size_t fragmentLen : {255, 1024, 0xFFFF}) {
+        SendCeDataInFragments(apdu, fragmentLen);
+    }
+    EXPECT_EQ(listener_->hceDataCount_, 3);
+    EXPECT_EQ(listener_->hceData_, apdu);
+
+    // a failed fragment drops the apdu
+    tNFA_CONN_EVT_DATA connEventData;
+    connEventData.ce_data.status = NFA_STATUS_FAILED;
+    connEventData.ce_data.p_data = nullptr;
+    connEventData.ce_data.len = 0;
+    std::string head = apdu.substr(0, 255);
+    SendCeDataInFragments(head, 100);
+    NfcNciMock::NfcCeCallback(NFA_CE_DATA_EVT, &connEventData);
+    std::string shortApdu = CreateExtendedApdu(10);
+    SendCeDataInFragments(shortApdu, 4);
+    EXPECT_EQ(listener_->hceDataCount_, 4);
+    EXPECT_EQ(listener_->hceData_, shortApdu);
+}
+
+/**
+ * @tc.number    : NFC_DEVICE_HOST_API_0065
+ * @tc.name      : HceOversizedApdu_Test
+ * @tc.desc      : NciBalCe answers 6700 to a command apdu longer than the longest extended apdu
+ */
+TEST_F(DeviceHostTest, HceOversizedApdu_Test)
+{
+    std::string apdu = CreateExtendedApdu(0xFFFF);
+    apdu.append(1024, 0x00);
+    nfcNciMock_->SetSendRawFrameScene(2);
+    SendCeDataInFragments(apdu, 1024);
+    EXPECT_EQ(listener_->hceDataCount_, 0);
+    EXPECT_EQ(nfcNciMock_->GetLastRawFrame(), std::string({0x67, 0x00}));
+
+    // the next apdu is reassembled again
+    std::string shortApdu = CreateExtendedApdu(10);
+    SendCeDataInFragments(shortApdu, 4);
+    EXPECT_EQ(listener_->hceDataCount_, 1);
+    EXPECT_EQ(listener_->hceData_, shortApdu);
+}
+
+/**
+ * @tc.number    : NFC_DEVICE_HOST_API_0066
+ * @tc.name      : UpdateT3tIdentifiers_Test
+ * @tc.desc      : DeviceHost UpdateT3tIdentifiers registers only the difference, up to LF_T3T_MAX
+ */
+TEST_F(DeviceHostTest, UpdateT3tIdentifiers_Test)
+{
+    // system code + nfcid2 + pmm
+    const std::string pmm = "FFFFFFFFFFFFFFFF";
+    std::string id1 = "40FE02FE000000000001" + pmm;
+    std::string id2 = "40FE02FE000000000002" + pmm;
+    std::string id3 = "40FE02FE000000000003" + pmm;
+    EXPECT_TRUE(deviceHost_->Deinitialize());
+    nfcNciMock_->SetLfT3tMax(2);
+    EXPECT_TRUE(deviceHost_->Initialize());
+    EXPECT_EQ(deviceHost_->GetLfT3tMax(), 2);
+
+    // the identifiers above LF_T3T_MAX and the malformed ones are ignored
+    int starts = nfcNciMock_->GetStartRfDiscoveryCount();
+    EXPECT_EQ(deviceHost_->UpdateT3tIdentifiers({id1, id2, id3, "123"}), 2);
+    EXPECT_EQ(nfcNciMock_->GetT3tRegisterCount(), 2);
+    EXPECT_LE(nfcNciMock_->GetStartRfDiscoveryCount(), starts + 1);
+
+    // only id2 is deregistered and id3 registered, the case of the hex does not matter
+    starts = nfcNciMock_->GetStartRfDiscoveryCount();
+    std::string lowerId1 = id1;
+    std::transform(lowerId1.begin(), lowerId1.end(), lowerId1.begin(), ::tolower);
+    EXPECT_EQ(deviceHost_->UpdateT3tIdentifiers({lowerId1, id3}), 2);
+    EXPECT_EQ(nfcNciMock_->GetT3tRegisterCount(), 3);
+    EXPECT_EQ(nfcNciMock_->GetT3tDeregisterCount(), 1);
+    EXPECT_LE(nfcNciMock_->GetStartRfDiscoveryCount(), starts + 1);
+
+    // nothing changes, nothing is sent
+    EXPECT_EQ(deviceHost_->UpdateT3tIdentifiers({id3, id1}), 2);
+    EXPECT_EQ(nfcNciMock_->GetT3tRegisterCount(), 3);
+    EXPECT_EQ(nfcNciMock_->GetT3tDeregisterCount(), 1);
+
+    deviceHost_->DeregisterT3tIdentifier(id3);
+    EXPECT_EQ(nfcNciMock_->GetT3tDeregisterCount(), 2);
+    deviceHost_->ClearT3tIdentifiersCache();
+    EXPECT_EQ(nfcNciMock_->GetT3tDeregisterCount(), 3);
+
+    EXPECT_TRUE(deviceHost_->Deinitialize());
+    nfcNciMock_->SetLfT3tMax(0);
+    EXPECT_TRUE(deviceHost_->Initialize());
+}
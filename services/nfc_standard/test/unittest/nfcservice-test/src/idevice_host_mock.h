@@ -19,6 +19,7 @@ public:
     MOCK_METHOD1(RegisterT3tIdentifier, int(std::string& lfT3tIdentifier));
     MOCK_METHOD1(DeregisterT3tIdentifier, void(std::string& lfT3tIdentifier));
     MOCK_METHOD0(ClearT3tIdentifiersCache, void());
+    MOCK_METHOD1(UpdateT3tIdentifiers, int(const std::vector<std::string>& lfT3tIdentifiers));
     MOCK_METHOD0(GetLfT3tMax, int());
     MOCK_METHOD0(GetLastError, int());
     MOCK_METHOD0(Abort, void());
@@ -7,12 +7,17 @@ tNFA_CONN_CBACK* NfcNciMock::mNfcConnectionCallback_;
 tNFA_NDEF_CBACK* NfcNciMock::mNdefCallback_;
 tNFA_HCI_CBACK* NfcNciMock::mHciCallback_;
 tNFA_EE_CBACK* NfcNciMock::mEeCallback_;
+tNFA_CONN_CBACK* NfcNciMock::mCeCallback_;
+tNFA_CONN_CBACK* NfcNciMock::mT3tCallback_;
 
 tNFA_CONN_EVT_DATA NfcNciMock::connEventData_;
 tNFA_DM_CBACK_DATA NfcNciMock::dmEventData_;
 tNFA_NDEF_EVT_DATA NfcNciMock::ndefEventData_;
 tNFA_HCI_EVT_DATA NfcNciMock::hciEventData_;
 tNFA_EE_CBACK_DATA NfcNciMock::eeEventData_;
+tNFA_CONN_EVT_DATA NfcNciMock::t3tEventData_;
+// id, length, value of LF_T3T_MAX
+uint8_t NfcNciMock::configTlvs_[3];
 
 NfcNciMock::NfcNciMock() {}
 
@@ -48,6 +53,16 @@ void NfcNciMock::NfcEeCallback(tNFA_EE_EVT event, tNFA_EE_CBACK_DATA* p_data)
     mEeCallback_(event, p_data);
 }
 
+void NfcNciMock::NfcCeCallback(uint8_t event, tNFA_CONN_EVT_DATA* p_data)
+{
+    mCeCallback_(event, p_data);
+}
+
+void NfcNciMock::NfcT3tCallback(uint8_t event, tNFA_CONN_EVT_DATA* p_data)
+{
+    mT3tCallback_(event, p_data);
+}
+
 void NfcNciMock::NfaInit(tHAL_NFC_ENTRY* pHalEntryTbl) {}
 
 tNFA_STATUS NfcNciMock::NfaEnable(tNFA_DM_CBACK* pDmCback, tNFA_CONN_CBACK* pConnCback)
@@ -112,6 +127,7 @@ tNFA_STATUS NfcNciMock::NfaDisableListening(void)
 
 tNFA_STATUS NfcNciMock::NfaStartRfDiscovery(void)
 {
+    ++mStartRfDiscoveryCount_;
     std::thread(&NfcConnectionCallback, NFA_RF_DISCOVERY_STARTED_EVT, &connEventData_).detach();
     return NFA_STATUS_OK;
 }
@@ -168,6 +184,7 @@ void NfcNciMock::SetDeactivateScene(int deactivateScene)
 
 tNFA_STATUS NfcNciMock::NfaSendRawFrame(uint8_t* pRawData, uint16_t dataLen, uint16_t presenceCheckStartDelay)
 {
+    mLastRawFrame_.assign(reinterpret_cast<char*>(pRawData), dataLen);
     if (mSendRawFrameScene_ == 1) {
         mSendRawFrameScene_ = 0;
         return NFA_STATUS_FAILED;
@@ -188,6 +205,11 @@ void NfcNciMock::SetSendRawFrameScene(int sendRawFrameScene)
     mSendRawFrameScene_ = sendRawFrameScene;
 }
 
+std::string NfcNciMock::GetLastRawFrame() const
+{
+    return mLastRawFrame_;
+}
+
 tNFA_STATUS NfcNciMock::NfaRegisterNDefTypeHandler(
     bool handleWholeMessage, tNFA_TNF tnf, uint8_t* pTypeName, uint8_t typeNameLen, tNFA_NDEF_CBACK* pNdefCback)
 {
@@ -565,6 +587,7 @@ tNFA_STATUS NfcNciMock::NfcCeSetIsoDepListenTech(tNFA_TECHNOLOGY_MASK tech_mask)
 
 tNFA_STATUS NfcNciMock::NfcCeRegisterAidOnDH(uint8_t aid[NFC_MAX_AID_LEN], uint8_t aidLen, tNFA_CONN_CBACK* pConnCback)
 {
+    mCeCallback_ = pConnCback;
     return NFA_STATUS_OK;
 }
 
@@ -588,4 +611,57 @@ tNFA_STATUS NfcNciMock::NfcSetConfig(tNFA_PMID paramId, uint8_t length, uint8_t*
 {
     std::thread(&NfcDeviceManagementCallback, NFA_DM_SET_CONFIG_EVT, &dmEventData_).detach();
     return NFA_STATUS_OK;
-}
\ No newline at end of file
+}
+
+tNFA_STATUS NfcNciMock::NfcGetConfig(uint8_t numIds, tNFA_PMID* pParamIds)
+{
+    configTlvs_[0] = NCI_PARAM_ID_LF_T3T_MAX;
+    configTlvs_[1] = 1;
+    configTlvs_[2] = mLfT3tMax_;
+    dmEventData_.get_config.status = NFA_STATUS_OK;
+    dmEventData_.get_config.tlv_size = sizeof(configTlvs_);
+    dmEventData_.get_config.param_tlvs = configTlvs_;
+    std::thread(&NfcDeviceManagementCallback, NFA_DM_GET_CONFIG_EVT, &dmEventData_).detach();
+    return NFA_STATUS_OK;
+}
+
+tNFA_STATUS NfcNciMock::NfcCeRegisterFelicaSystemCodeOnDH(uint16_t systemCode,
+                                                          uint8_t nfcid2[NCI_RF_F_UID_LEN],
+                                                          uint8_t t3tPmm[NCI_T3T_PMM_LEN],
+                                                          tNFA_CONN_CBACK* pConnCback)
+{
+    mT3tCallback_ = pConnCback;
+    ++mT3tRegisterCount_;
+    t3tEventData_.ce_registered.status = NFA_STATUS_OK;
+    t3tEventData_.ce_registered.handle = mT3tNextHandle_++;
+    std::thread(&NfcT3tCallback, NFA_CE_REGISTERED_EVT, &t3tEventData_).detach();
+    return NFA_STATUS_OK;
+}
+
+tNFA_STATUS NfcNciMock::NfcCeDeregisterFelicaSystemCodeOnDH(tNFA_HANDLE handle)
+{
+    ++mT3tDeregisterCount_;
+    t3tEventData_.ce_deregistered.handle = handle;
+    std::thread(&NfcT3tCallback, NFA_CE_DEREGISTERED_EVT, &t3tEventData_).detach();
+    return NFA_STATUS_OK;
+}
+
+void NfcNciMock::SetLfT3tMax(uint8_t lfT3tMax)
+{
+    mLfT3tMax_ = lfT3tMax;
+}
+
+int NfcNciMock::GetT3tRegisterCount() const
+{
+    return mT3tRegisterCount_;
+}
+
+int NfcNciMock::GetT3tDeregisterCount() const
+{
+    return mT3tDeregisterCount_;
+}
+
+int NfcNciMock::GetStartRfDiscoveryCount() const
+{
+    return mStartRfDiscoveryCount_;
+}
@@ -1,6 +1,8 @@
 #ifndef NFC_NCI_MOCK_H
 #define NFC_NCI_MOCK_H
 
+#include <string>
+
 #include "infc_nci.h"
 
 class NfcNciMock : public OHOS::nfc::ncibal::INfcNci {
@@ -83,12 +85,21 @@ public:
                                              tNFA_CONN_CBACK* pConnCback) override;
     virtual tNFA_STATUS NfcSetPowerSubStateForScreenState(uint8_t screenState) override;
     virtual tNFA_STATUS NfcSetConfig(tNFA_PMID paramId, uint8_t length, uint8_t* pData) override;
+    virtual tNFA_STATUS NfcGetConfig(uint8_t numIds, tNFA_PMID* pParamIds) override;
+    virtual tNFA_STATUS NfcCeRegisterFelicaSystemCodeOnDH(uint16_t systemCode,
+                                                          uint8_t nfcid2[NCI_RF_F_UID_LEN],
+                                                          uint8_t t3tPmm[NCI_T3T_PMM_LEN],
+                                                          tNFA_CONN_CBACK* pConnCback) override;
+    virtual tNFA_STATUS NfcCeDeregisterFelicaSystemCodeOnDH(tNFA_HANDLE handle) override;
 
     static void NfcDeviceManagementCallback(uint8_t event, tNFA_DM_CBACK_DATA* p_data);
     static void NfcConnectionCallback(uint8_t event, tNFA_CONN_EVT_DATA* p_data);
     static void NdefCallback(tNFA_NDEF_EVT event, tNFA_NDEF_EVT_DATA* p_data);
     static void NfcHciCallback(tNFA_HCI_EVT event, tNFA_HCI_EVT_DATA* p_data);
     static void NfcEeCallback(tNFA_EE_EVT event, tNFA_EE_CBACK_DATA* p_data);
+    // delivers a card emulation fragment synchronously to the callback registered on DH
+    static void NfcCeCallback(uint8_t event, tNFA_CONN_EVT_DATA* p_data);
+    static void NfcT3tCallback(uint8_t event, tNFA_CONN_EVT_DATA* p_data);
 
     void SetEnableScene(int enableScene);
     void SetDisableScene(int disableScene);
@@ -109,6 +120,12 @@ public:
     void SetSetDefaultTechRoutingScene(int setDefaultTechRoutingScene);
     void SetClearDefaultTechRoutingScene(int clearDefaultTechRoutingScene);
     void SetSetPowerStatusScene(int setPowerStatusScene);
+    std::string GetLastRawFrame() const;
+    // LF_T3T_MAX reported by NfcGetConfig
+    void SetLfT3tMax(uint8_t lfT3tMax);
+    int GetT3tRegisterCount() const;
+    int GetT3tDeregisterCount() const;
+    int GetStartRfDiscoveryCount() const;
 
 private:
     static tNFA_DM_CBACK* mNfcDeviceManagementCallback_;
@@ -116,12 +133,16 @@ private:
     static tNFA_NDEF_CBACK* mNdefCallback_;
     static tNFA_HCI_CBACK* mHciCallback_;
     static tNFA_EE_CBACK* mEeCallback_;
+    static tNFA_CONN_CBACK* mCeCallback_;
+    static tNFA_CONN_CBACK* mT3tCallback_;
 
     static tNFA_CONN_EVT_DATA connEventData_;
     static tNFA_DM_CBACK_DATA dmEventData_;
     static tNFA_NDEF_EVT_DATA ndefEventData_;
     static tNFA_HCI_EVT_DATA hciEventData_;
     static tNFA_EE_CBACK_DATA eeEventData_;
+    static tNFA_CONN_EVT_DATA t3tEventData_;
+    static uint8_t configTlvs_[];
 
     int mEnableScene_{0};
     int mDisableScene_{0};
@@ -142,5 +163,11 @@ private:
     int mSetTechRoutingScene_{0};
     int mClearTechRoutingScene_{0};
     int mSetPowerStatusScene_{0};
+    std::string mLastRawFrame_{};
+    uint8_t mLfT3tMax_{0};
+    tNFA_HANDLE mT3tNextHandle_{0x0300};
+    int mT3tRegisterCount_{0};
+    int mT3tDeregisterCount_{0};
+    int mStartRfDiscoveryCount_{0};
 };
 #endif  // !NFC_NCI_MOCK_H
\ No newline at end of file
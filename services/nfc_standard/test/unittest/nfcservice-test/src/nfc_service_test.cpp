@@ -161,6 +161,24 @@ TEST_F(NfcServiceTest, IDeviceHostListener_Test)
     std::this_thread::sleep_for(std::chrono::milliseconds(500));
 }
 
+/**
+ * @brief The transaction events of a burst are all sent, the latency is measured per event.
+ */
+TEST_F(NfcServiceTest, OffHostTransactionEventBurst_Test)
+{
+    const int burstSize = 200;
+    std::string aid("A000000151000000");
+    std::string tdata("abc");
+    std::string seName("eSE1");
+    for (int i = 0; i < burstSize; i++) {
+        nfcService->OnOffHostTransactionEvent(aid, tdata, seName);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    LatencyHistogram latency = nfcService->GetOffHostTransactionLatency();
+    EXPECT_EQ(latency.GetCount(), (uint64_t)burstSize);
+}
+
 TEST_F(NfcServiceTest, ACTION_SCREEN_ON_Test)
 {
     std::shared_ptr<Context> context = std::make_shared<Context>();
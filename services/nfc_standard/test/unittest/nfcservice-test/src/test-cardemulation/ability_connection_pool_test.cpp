@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ability_connection_pool.h"
+
+#include <gtest/gtest.h>
+
+#include "ability_connection_stub.h"
+#include "apdu_channel.h"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+using namespace OHOS::nfc::sdk::cardemulation;
+namespace OHOS::nfc::cardemulation::test {
+// connects at once, like a service already running
+class FakeAbilityManager {
+public:
+    bool Connect(const OHOS::AppExecFwk::ElementName& name, const OHOS::sptr<AbilityConnectionStub>& connection)
+    {
+        ++connectCount_;
+        if (refused_) {
+            return false;
+        }
+        auto service = OHOS::sptr<ApduChannelStub>(new ApduChannelStub());
+        services_.push_back(service);
+        connection->OnAbilityConnectDone(name, service->AsObject(), 0);
+        return true;
+    }
+    void Disconnect(const OHOS::sptr<AbilityConnectionStub>& connection)
+    {
+        ++disconnectCount_;
+    }
+    std::shared_ptr<AbilityConnectionPool> CreatePool(size_t maxCount)
+    {
+        return std::make_shared<AbilityConnectionPool>(
+            maxCount,
+            [this](const OHOS::AppExecFwk::ElementName& name, const OHOS::sptr<AbilityConnectionStub>& connection) {
+                return Connect(name, connection);
+            },
+            [this](const OHOS::sptr<AbilityConnectionStub>& connection) { Disconnect(connection); });
+    }
+
+    bool refused_{false};
+    int connectCount_{0};
+    int disconnectCount_{0};
+    std::vector<OHOS::sptr<ApduChannelStub>> services_;
+};
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the first apdu of a recently used service finds a connected channel
+*/
+TEST(AbilityConnectionPool, acquire_warm)
+{
+    FakeAbilityManager amc;
+    auto pool = amc.CreatePool(4);
+    auto name = Util::CreateElementName("app1");
+
+    EXPECT_FALSE(pool->Acquire(name));
+    pool->Warm(name, WarmReason::RECENT);
+    EXPECT_TRUE(pool->Acquire(name));
+    // already connected
+    pool->Warm(name, WarmReason::RECENT);
+    EXPECT_EQ(amc.connectCount_, 1);
+    EXPECT_EQ(pool->GetHits(), 1u);
+    EXPECT_EQ(pool->GetMisses(), 1u);
+    EXPECT_NE(pool->Dump().find("first apdu hits: 1, misses: 1"), std::string::npos);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the least recently used service is evicted over the count budget
+*/
+TEST(AbilityConnectionPool, evict_lru)
+{
+    FakeAbilityManager amc;
+    auto pool = amc.CreatePool(2);
+    auto app1 = Util::CreateElementName("app1");
+    auto app2 = Util::CreateElementName("app2");
+    auto app3 = Util::CreateElementName("app3");
+
+    pool->Warm(app1, WarmReason::RECENT);
+    pool->Warm(app2, WarmReason::RECENT);
+    EXPECT_TRUE(pool->Acquire(app1));
+    pool->Warm(app3, WarmReason::RECENT);
+
+    EXPECT_EQ(pool->GetCount(), 2u);
+    EXPECT_EQ(amc.disconnectCount_, 1);
+    EXPECT_TRUE(pool->Acquire(app1));
+    EXPECT_FALSE(pool->Acquire(app2));
+    EXPECT_TRUE(pool->Acquire(app3));
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : pinned services are kept, recently used services fill the rest of the count budget
+*/
+TEST(AbilityConnectionPool, pinned_count_budget)
+{
+    FakeAbilityManager amc;
+    auto pool = amc.CreatePool(2);
+    auto defaultApp = Util::CreateElementName("default");
+    auto foregroundApp = Util::CreateElementName("foreground");
+    auto recent = Util::CreateElementName("recent");
+
+    pool->SetPinned({defaultApp}, {foregroundApp});
+    pool->Warm(recent, WarmReason::RECENT);
+    EXPECT_EQ(pool->GetCount(), 2u);
+    EXPECT_EQ(amc.connectCount_, 2);
+    EXPECT_FALSE(pool->Acquire(recent));
+
+    // no longer in the foreground
+    pool->SetPinned({defaultApp}, {});
+    pool->Warm(recent, WarmReason::RECENT);
+    EXPECT_TRUE(pool->Acquire(defaultApp));
+    EXPECT_TRUE(pool->Acquire(recent));
+    EXPECT_FALSE(pool->Acquire(foregroundApp));
+    EXPECT_NE(pool->Dump().find("reason: default"), std::string::npos);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : a died service is removed from the pool
+*/
+TEST(AbilityConnectionPool, remote_died)
+{
+    FakeAbilityManager amc;
+    auto pool = amc.CreatePool(4);
+    auto name = Util::CreateElementName("app1");
+
+    pool->Warm(name, WarmReason::RECENT);
+    ASSERT_EQ(amc.services_.size(), 1u);
+    pool->OnRemoteDied(amc.services_[0]->AsObject());
+    EXPECT_EQ(pool->GetCount(), 0u);
+    EXPECT_FALSE(pool->Acquire(name));
+}
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the connections made by the pool are reported to the observer, a refused one is not kept
+*/
+TEST(AbilityConnectionPool, observer)
+{
+    FakeAbilityManager amc;
+    auto pool = amc.CreatePool(4);
+    auto app1 = Util::CreateElementName("app1");
+    auto app2 = Util::CreateElementName("app2");
+    std::vector<std::string> connected;
+    pool->SetObserver(
+        [&connected](const OHOS::AppExecFwk::ElementName& name, const OHOS::sptr<OHOS::IRemoteObject>& remote) {
+            EXPECT_TRUE(remote);
+            connected.push_back(name.GetAbilityName());
+        },
+        nullptr);
+
+    EXPECT_TRUE(pool->Warm(app1, WarmReason::RECENT));
+    // already connected, not reported again
+    EXPECT_TRUE(pool->Warm(app1, WarmReason::RECENT));
+    amc.refused_ = true;
+    EXPECT_FALSE(pool->Warm(app2, WarmReason::RECENT));
+    ASSERT_EQ(connected.size(), 1u);
+    EXPECT_EQ(connected[0], app1.GetAbilityName());
+    EXPECT_EQ(pool->GetCount(), 1u);
+}
+}  // namespace OHOS::nfc::cardemulation::test
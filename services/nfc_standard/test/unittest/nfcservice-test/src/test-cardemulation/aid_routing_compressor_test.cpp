@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "aid_routing_compressor.h"
+
+#include <gtest/gtest.h>
+
+#include "aid_routing_adapter.h"
+#include "aid_set.h"
+#include "card_emulation_def.h"
+#include "card_emulation_service_info.h"
+#include "card_emulation_util.h"
+#include "routing_dump_decoder.hpp"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+namespace OHOS::nfc::cardemulation::test {
+using DecodedEntry = OHOS::nfc::test::RoutingEntry;
+static const std::string kNormalType = CARDEMULATION_SERVICE_TYPE_NORMAL;
+static const int kHostRoute = 0x00;
+static const int kEseRoute = 0x82;
+
+static std::shared_ptr<CardEmulationServiceInfo> CreateApp(const std::string& name,
+                                                           const std::string& location,
+                                                           const std::vector<std::string>& aids)
+{
+    auto app = std::make_shared<CardEmulationServiceInfo>(location);
+    app->SetName(Util::CreateElementName(name));
+    auto as = AidSet::FromRawString(aids);
+    as->SetType(kNormalType);
+    app->AddAidset(std::move(as));
+    return app;
+}
+
+static int LocationToRoute(const std::string& location)
+{
+    return StringEqual(location, NFC_EE_HOST) ? kHostRoute : kEseRoute;
+}
+
+// encodes the routes as NCI aid routing entries and decodes them by the routing dump decoder
+static std::vector<DecodedEntry> EncodeAndDecode(const std::vector<AidRoute>& routes)
+{
+    constexpr uint8_t qualifierTypeAid = 0x02;
+    std::vector<DecodedEntry> entries;
+    for (auto& route : routes) {
+        std::vector<unsigned char> aid;
+        route.aid_.ToBytes(aid);
+        std::vector<uint8_t> buf;
+        buf.push_back(static_cast<uint8_t>(qualifierTypeAid | AidTypeToInt(route.aid_.GetType())));
+        buf.push_back(static_cast<uint8_t>(aid.size() + 2));
+        buf.push_back(static_cast<uint8_t>(LocationToRoute(route.location_)));
+        buf.push_back(OHOS::nfc::test::POWER_STATE);
+        buf.insert(buf.end(), aid.begin(), aid.end());
+        auto entry = DecodedEntry::Create(buf);
+        EXPECT_TRUE(entry != nullptr);
+        if (entry) {
+            entries.push_back(*entry);
+        }
+    }
+    return entries;
+}
+
+// longest match of the controller, the default route is host
+static int ResolveRoute(const std::vector<DecodedEntry>& entries, const std::string& selectAid)
+{
+    std::vector<unsigned char> aid;
+    HexStrToBytes(selectAid, aid);
+    int route = kHostRoute;
+    size_t matched = 0;
+    for (auto& entry : entries) {
+        bool isPrefix = DecodedEntry::IsPrefixPattern(entry.head_);
+        bool match = isPrefix ? (aid.size() >= entry.aid_.size() &&
+                                 std::equal(entry.aid_.begin(), entry.aid_.end(), aid.begin()))
+                              : (aid.size() == entry.aid_.size() &&
+                                 std::equal(entry.aid_.begin(), entry.aid_.end(), aid.begin()));
+        if (match && entry.aid_.size() + (isPrefix ? 0 : 1) > matched) {
+            matched = entry.aid_.size() + (isPrefix ? 0 : 1);
+            route = entry.env_;
+        }
+    }
+    return route;
+}
+
+// every aid of the plan is still routed to its execution environment
+static void ExpectRoutesKept(const std::vector<std::shared_ptr<AidSet>>& plan, const std::vector<DecodedEntry>& entries)
+{
+    for (auto& aidset : plan) {
+        int expected = LocationToRoute(aidset->GetExecutionEnvironment());
+        aidset->Visit([&entries, expected](const std::string&, const AidString& aid) {
+            std::string digits = StringTrim(aid.ToString(), TRIM_AID_FLAGS);
+            EXPECT_EQ(ResolveRoute(entries, digits), expected) << digits;
+        });
+    }
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : sibling aids with the same route are merged into one prefix entry
+*/
+TEST(AidRoutingCompressor, compress_siblings)
+{
+    auto ese = CreateApp("app1", "eSE1", {"A0000000010101", "A0000000010102", "A0000000010103"});
+    auto host = CreateApp("app2", "host", {"B0000000010101"});
+    std::vector<std::shared_ptr<AidSet>> plan = {ese->GetAidsetByType(kNormalType), host->GetAidsetByType(kNormalType)};
+
+    AidRoutingCompressor compressor(AID_ROUTING_MODE_MASK_PREFIX);
+    auto routes = compressor.Compress({ese->GetAidsetByType(kNormalType)}, plan);
+    ASSERT_EQ(routes.size(), 1u);
+    EXPECT_EQ(routes[0].aid_.ToString(), "A00000000101*");
+    EXPECT_EQ(AidRoutingCompressor::GetRoutingCost(routes), 6 + AID_HEAD_LENGTH);
+
+    auto entries = EncodeAndDecode(routes);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_TRUE(DecodedEntry::IsPrefixPattern(entries[0].head_));
+    ExpectRoutesKept(plan, entries);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : a prefix covering an aid routed elsewhere is not used
+*/
+TEST(AidRoutingCompressor, compress_conflict)
+{
+    auto ese = CreateApp("app1",
+                         "eSE1",
+                         {"A0000000010101", "A0000000010102", "A0000000020101", "A0000000020102"});
+    auto host = CreateApp("app2", "host", {"A0000000010199"});
+    std::vector<std::shared_ptr<AidSet>> plan = {ese->GetAidsetByType(kNormalType), host->GetAidsetByType(kNormalType)};
+
+    AidRoutingCompressor compressor(AID_ROUTING_MODE_MASK_PREFIX);
+    auto routes = compressor.Compress({ese->GetAidsetByType(kNormalType)}, plan);
+    ASSERT_EQ(routes.size(), 3u);
+    EXPECT_EQ(routes[0].aid_.ToString(), "A0000000010101");
+    EXPECT_EQ(routes[1].aid_.ToString(), "A0000000010102");
+    EXPECT_EQ(routes[2].aid_.ToString(), "A00000000201*");
+
+    auto entries = EncodeAndDecode(routes);
+    ExpectRoutesKept(plan, entries);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : nothing is merged without prefix matching support
+*/
+TEST(AidRoutingCompressor, compress_mode_unsupported)
+{
+    auto ese = CreateApp("app1", "eSE1", {"A0000000010101", "A0000000010102"});
+    std::vector<std::shared_ptr<AidSet>> plan = {ese->GetAidsetByType(kNormalType)};
+
+    AidRoutingCompressor compressor(0);
+    auto routes = compressor.Compress(plan, plan);
+    ASSERT_EQ(routes.size(), 2u);
+    EXPECT_TRUE(routes[0].aid_.IsExact());
+    EXPECT_TRUE(routes[1].aid_.IsExact());
+    ExpectRoutesKept(plan, EncodeAndDecode(routes));
+}
+}  // namespace OHOS::nfc::cardemulation::test
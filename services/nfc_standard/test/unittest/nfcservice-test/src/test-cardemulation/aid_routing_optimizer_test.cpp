@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "aid_routing_optimizer.h"
+
+#include <gtest/gtest.h>
+
+#include "aid_set.h"
+#include "card_emulation_def.h"
+#include "card_emulation_service_info.h"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+namespace OHOS::nfc::cardemulation::test {
+static const std::string kSecureType = CARDEMULATION_SERVICE_TYPE_SECURE;
+static const std::string kNormalType = CARDEMULATION_SERVICE_TYPE_NORMAL;
+// 7 bytes aid + 4 bytes routing entry head
+static const int kAidCost = 11;
+
+static std::shared_ptr<CardEmulationServiceInfo> CreateApp(const std::string& name,
+                                                           const std::string& location,
+                                                           const std::string& type,
+                                                           const std::vector<std::string>& aids)
+{
+    auto app = std::make_shared<CardEmulationServiceInfo>(location);
+    app->SetName(Util::CreateElementName(name));
+    auto as = AidSet::FromRawString(aids);
+    as->SetType(type);
+    app->AddAidset(std::move(as));
+    return app;
+}
+
+static bool IsHost(const std::string& location)
+{
+    return location == NFC_EE_HOST;
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : all aidsets fit into the routing table
+*/
+TEST(AidRoutingOptimizer, optimize_enough_capacity)
+{
+    auto app1 = CreateApp("app1", "eSE1", kNormalType, {"F0010203040501", "F0010203040502"});
+    auto app2 = CreateApp("app2", "eSE1", kSecureType, {"F0010203040601"});
+    std::vector<std::shared_ptr<AidSet>> plan = {app1->GetAidsetByType(kNormalType),
+                                                 app2->GetAidsetByType(kSecureType)};
+
+    AidRoutingOptimizer optimizer(kAidCost * 3, IsHost);
+    auto kept = optimizer.Optimize(plan, nullptr, nullptr);
+    EXPECT_EQ(kept, plan);
+    EXPECT_TRUE(optimizer.GetEvictions().empty());
+    EXPECT_EQ(optimizer.GetUsedCapacity(), kAidCost * 3);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : primary > preferred > payment > other
+*/
+TEST(AidRoutingOptimizer, optimize_by_priority)
+{
+    auto other = CreateApp("other", "eSE1", kNormalType, {"F0010203040501"});
+    auto payment = CreateApp("payment", "eSE1", kSecureType, {"F0010203040601"});
+    auto preferred = CreateApp("preferred", "eSE1", kNormalType, {"F0010203040701"});
+    auto primary = CreateApp("primary", "eSE1", kSecureType, {"F0010203040801", "F0010203040802"});
+    std::vector<std::shared_ptr<AidSet>> plan = {other->GetAidsetByType(kNormalType),
+                                                 payment->GetAidsetByType(kSecureType),
+                                                 preferred->GetAidsetByType(kNormalType),
+                                                 primary->GetAidsetByType(kSecureType)};
+
+    AidRoutingOptimizer optimizer(kAidCost * 3, IsHost);
+    auto kept = optimizer.Optimize(plan, primary, preferred);
+    ASSERT_EQ(kept.size(), 2u);
+    EXPECT_EQ(kept[0]->GetOwner().lock(), preferred);
+    EXPECT_EQ(kept[1]->GetOwner().lock(), primary);
+
+    auto& evictions = optimizer.GetEvictions();
+    ASSERT_EQ(evictions.size(), 2u);
+    EXPECT_EQ(evictions[0].priority_, RoutingPriority::OTHER);
+    EXPECT_EQ(evictions[1].priority_, RoutingPriority::PAYMENT);
+    EXPECT_EQ(evictions[1].cost_, kAidCost);
+
+    std::string dump = optimizer.Dump();
+    EXPECT_NE(dump.find("evicted aidset count: 2"), std::string::npos);
+    EXPECT_NE(dump.find("priority: payment"), std::string::npos);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : inside a priority class the number of routed aidsets is maximized
+*/
+TEST(AidRoutingOptimizer, optimize_maximize_count)
+{
+    auto app1 = CreateApp("app1", "eSE1", kNormalType, {"F0010203040501", "F0010203040502"});
+    auto app2 = CreateApp("app2", "eSE1", kNormalType, {"F0010203040601"});
+    auto app3 = CreateApp("app3", "eSE1", kNormalType, {"F0010203040701"});
+    std::vector<std::shared_ptr<AidSet>> plan = {app1->GetAidsetByType(kNormalType),
+                                                 app2->GetAidsetByType(kNormalType),
+                                                 app3->GetAidsetByType(kNormalType)};
+
+    AidRoutingOptimizer optimizer(kAidCost * 2, IsHost);
+    auto kept = optimizer.Optimize(plan, nullptr, nullptr);
+    ASSERT_EQ(kept.size(), 2u);
+    EXPECT_EQ(kept[0]->GetOwner().lock(), app2);
+    EXPECT_EQ(kept[1]->GetOwner().lock(), app3);
+    ASSERT_EQ(optimizer.GetEvictions().size(), 1u);
+    EXPECT_EQ(optimizer.GetEvictions()[0].aidset_->GetOwner().lock(), app1);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : aidsets on the default route do not consume capacity
+*/
+TEST(AidRoutingOptimizer, optimize_default_route)
+{
+    auto app1 = CreateApp("app1", "host", kNormalType, {"F0010203040501", "F0010203040502"});
+    auto app2 = CreateApp("app2", "eSE1", kNormalType, {"F0010203040601"});
+    std::vector<std::shared_ptr<AidSet>> plan = {app1->GetAidsetByType(kNormalType),
+                                                 app2->GetAidsetByType(kNormalType)};
+
+    AidRoutingOptimizer optimizer(0, IsHost);
+    auto kept = optimizer.Optimize(plan, nullptr, nullptr);
+    ASSERT_EQ(kept.size(), 1u);
+    EXPECT_EQ(kept[0]->GetOwner().lock(), app1);
+    ASSERT_EQ(optimizer.GetEvictions().size(), 1u);
+    EXPECT_EQ(optimizer.GetUsedCapacity(), 0);
+}
+}  // namespace OHOS::nfc::cardemulation::test
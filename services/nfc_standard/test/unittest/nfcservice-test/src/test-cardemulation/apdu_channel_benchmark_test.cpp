@@ -0,0 +1,69 @@
+/*
+  * Copyright (C) 2021 Huawei Device Co., Ltd.
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include "apdu_channel.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+
+using namespace OHOS::nfc::sdk::cardemulation;
+
+namespace OHOS::nfc::sdk::cardemulation::test {
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : per apdu message overhead of the service, without IPC
+*/
+TEST(MsgPool, Benchmark)
+{
+    constexpr int iterations = 100000;
+    const std::vector<unsigned char> apdu = {0x80, 0xCA, 0x9F, 0x7F, 0x2D, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+                                             0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12};
+    size_t bytes = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        // command and response messages allocated and copied per apdu
+        auto cmd = std::make_unique<Msg>(0, 0, 0);
+        cmd->SetData(std::vector<unsigned char>(apdu.begin(), apdu.end()));
+        auto resp = std::make_unique<Msg>(1, 0, 0);
+        resp->SetData(cmd->GetData());
+        std::vector<unsigned char> out = resp->GetData();
+        bytes += out.size();
+    }
+    auto copied = std::chrono::steady_clock::now() - begin;
+
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto cmd = MsgPool::Obtain(0, 0, 0);
+        cmd->SetData(&apdu[0], apdu.size());
+        auto resp = MsgPool::Obtain(1, 0, 0);
+        resp->SetData(cmd->TakeData());
+        MsgPool::Recycle(std::move(cmd));
+        std::vector<unsigned char> out = resp->TakeData();
+        MsgPool::Recycle(std::move(resp));
+        bytes += out.size();
+    }
+    auto pooled = std::chrono::steady_clock::now() - begin;
+    EXPECT_EQ(bytes, apdu.size() * iterations * 2);
+
+    auto copiedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(copied).count() / iterations;
+    auto pooledNs = std::chrono::duration_cast<std::chrono::nanoseconds>(pooled).count() / iterations;
+    printf("per apdu message overhead: copied %lld ns, pooled %lld ns\n",
+           static_cast<long long>(copiedNs),
+           static_cast<long long>(pooledNs));
+}
+}  // namespace OHOS::nfc::sdk::cardemulation::test
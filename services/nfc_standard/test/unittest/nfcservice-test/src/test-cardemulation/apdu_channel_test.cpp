@@ -205,4 +205,34 @@ TEST(Msg, Marshalling)
     EXPECT_EQ(memcmp(&d[0], &data[0], d.size()), 0);
     EXPECT_TRUE(msg1.GetSource());
 }
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : a recycled message is reset and keeps its data buffer
+*/
+TEST(MsgPool, Reuse)
+{
+    const unsigned char apdu[] = {0x00, 0xA4, 0x04, 0x00, 0x07, 0xF0, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+    auto stub = OHOS::sptr<ApduChannelStub>(new ApduChannelStub());
+    auto msg = MsgPool::Obtain(1, 2, 3);
+    msg->SetData(apdu, sizeof(apdu));
+    msg->SetSource(RemoteObjectPool::GetRemoteObject(stub->AsObject()));
+    const unsigned char* buffer = msg->GetData().data();
+    Msg* recycled = msg.get();
+    MsgPool::Recycle(std::move(msg));
+
+    msg = MsgPool::Obtain(4, 5, 6);
+    ASSERT_EQ(msg.get(), recycled);
+    EXPECT_EQ(msg->Id(), 4);
+    EXPECT_EQ(msg->Arg1(), 5);
+    EXPECT_EQ(msg->Arg2(), 6);
+    EXPECT_TRUE(msg->GetData().empty());
+    EXPECT_FALSE(msg->GetSource());
+    msg->SetData(apdu, sizeof(apdu));
+    EXPECT_EQ(msg->GetData().data(), buffer);
+
+    auto data = msg->TakeData();
+    EXPECT_EQ(data.data(), buffer);
+    EXPECT_TRUE(msg->GetData().empty());
+}
 }  // namespace OHOS::nfc::sdk::test
\ No newline at end of file
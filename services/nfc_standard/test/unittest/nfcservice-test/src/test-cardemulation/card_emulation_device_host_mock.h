@@ -37,5 +37,7 @@ public:
     MOCK_METHOD0(GetExtendedLengthApdusSupported, bool());
     MOCK_METHOD1(SendData, bool(std::vector<unsigned char> data));
     MOCK_METHOD1(DumpRoutingTable, bool(int));
+    MOCK_METHOD2(PostTask, bool(std::function<void()>, int64_t));
+    MOCK_METHOD0(IsNfcEnabled, bool());
 };
 }  // namespace OHOS::nfc::cardemulation
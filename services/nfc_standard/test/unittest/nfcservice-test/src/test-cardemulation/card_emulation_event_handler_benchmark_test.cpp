@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "card_emulation_event_handler.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+
+#include "card_emulation_device_host_mock.h"
+#include "card_emulation_error.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+using ::testing::_;
+using ::testing::Return;
+namespace OHOS::nfc::cardemulation::test {
+// no aid is routed, every select is answered by the handler
+class NoRouteAidRoutingManager : public IAidRoutingManager {
+public:
+    int OnCeServiceChanged(std::vector<std::shared_ptr<CardEmulationServiceInfo>> const& infos,
+                           const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                           const std::shared_ptr<CardEmulationServiceInfo>& preferred) override
+    {
+        return ERR_OK;
+    }
+    std::vector<ServiceInfoTypePair> GetCardEmulationServicesByAid(const std::string& aid) override
+    {
+        return {};
+    }
+    std::shared_ptr<CardEmulationServiceInfo> GetPrimaryService() override
+    {
+        return nullptr;
+    }
+    std::shared_ptr<CardEmulationServiceInfo> GetPreferredService() override
+    {
+        return nullptr;
+    }
+};
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : per apdu overhead of the handler, from the device host to the reader response, without IPC
+*/
+TEST(CardEmulationEventHandler, OnHCEData_Benchmark)
+{
+    constexpr int iterations = 10000;
+    const std::vector<unsigned char> select = {0x00, 0xA4, 0x04, 0x00, 0x07, 0xF0, 0x01, 0x02,
+                                               0x03, 0x04, 0x05, 0x06, 0x00};
+    auto dh = std::make_shared<DeviceHostCEMock>();
+    EXPECT_CALL(*dh, SendData(_)).Times(iterations).WillRepeatedly(Return(true));
+    auto handler = std::make_shared<CardEmulationEventHandler>(dh, std::make_shared<NoRouteAidRoutingManager>());
+    handler->OnHCEActivated();
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        handler->OnHCEData(&select[0], select.size());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    printf("OnHCEData overhead: %lld ns per apdu\n",
+           static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations));
+}
+}  // namespace OHOS::nfc::cardemulation::test
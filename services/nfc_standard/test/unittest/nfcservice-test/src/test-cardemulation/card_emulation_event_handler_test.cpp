@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "card_emulation_event_handler.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "apdu_channel.h"
+#include "aid_set.h"
+#include "card_emulation_def.h"
+#include "card_emulation_device_host_mock.h"
+#include "card_emulation_error.h"
+#include "card_emulation_service_info.h"
+#include "card_emulation_util.h"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+using namespace OHOS::nfc::sdk::cardemulation;
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Return;
+namespace OHOS::nfc::cardemulation::test {
+class EmptyAidRoutingManager : public IAidRoutingManager {
+public:
+    int OnCeServiceChanged(std::vector<std::shared_ptr<CardEmulationServiceInfo>> const& infos,
+                           const std::shared_ptr<CardEmulationServiceInfo>& primary,
+                           const std::shared_ptr<CardEmulationServiceInfo>& preferred) override
+    {
+        return ERR_OK;
+    }
+    std::vector<ServiceInfoTypePair> GetCardEmulationServicesByAid(const std::string& aid) override
+    {
+        return {};
+    }
+    std::shared_ptr<CardEmulationServiceInfo> GetPrimaryService() override
+    {
+        return nullptr;
+    }
+    std::shared_ptr<CardEmulationServiceInfo> GetPreferredService() override
+    {
+        return nullptr;
+    }
+};
+
+// resolves every aid to one service
+class SingleServiceRoutingManager : public EmptyAidRoutingManager {
+public:
+    explicit SingleServiceRoutingManager(std::shared_ptr<CardEmulationServiceInfo> service)
+        : service_(std::move(service))
+    {
+    }
+    std::vector<ServiceInfoTypePair> GetCardEmulationServicesByAid(const std::string& aid) override
+    {
+        return {ServiceInfoTypePair(service_, CARDEMULATION_SERVICE_TYPE_NORMAL)};
+    }
+
+    void SetService(std::shared_ptr<CardEmulationServiceInfo> service)
+    {
+        service_ = std::move(service);
+    }
+
+private:
+    std::shared_ptr<CardEmulationServiceInfo> service_;
+};
+
+// the in-process end of the apdu channel of a service, counts the commands it receives
+class ApduRecorder {
+public:
+    ApduRecorder() : stub_(new ApduChannelStub())
+    {
+        stub_->SetHandler([this](std::unique_ptr<Msg> msg) {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (msg && msg->Id() == EN_MSG_HCE::COMMAND_APDU) {
+                ++commands_;
+                cv_.notify_all();
+            }
+        });
+    }
+    ~ApduRecorder()
+    {
+        stub_->Stop();
+    }
+    OHOS::sptr<OHOS::IRemoteObject> AsObject()
+    {
+        return stub_->AsObject();
+    }
+    // the commands are delivered on the thread of the channel
+    size_t WaitForCommands(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait_for(lock, std::chrono::seconds(1), [this, count]() { return commands_ >= count; });
+        return commands_;
+    }
+
+private:
+    OHOS::sptr<ApduChannelStub> stub_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    size_t commands_{0};
+};
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the selects reach the connected service while other services connect and disconnect
+*/
+TEST(CardEmulationEventHandler, OnHCEData_ConnectionChurn)
+{
+    constexpr size_t iterations = 200;
+    const std::vector<unsigned char> select = HexStrToBytes("00A4040007F001020304050600");
+    ApduRecorder recorder;
+    auto name = Util::CreateElementName("app1");
+    auto service = std::make_shared<CardEmulationServiceInfo>(NFC_EE_HOST);
+    service->SetName(name);
+
+    auto dh = std::make_shared<DeviceHostCEMock>();
+    // a select without a connected service is answered with 6A82
+    EXPECT_CALL(*dh, SendData(_)).Times(0);
+    auto handler =
+        std::make_shared<CardEmulationEventHandler>(dh, std::make_shared<SingleServiceRoutingManager>(service));
+    // the connection of the service, the channel is the recorder
+    handler->OnAbilityConnected(name, recorder.AsObject(), false);
+    handler->OnHCEActivated();
+
+    std::atomic<bool> stop(false);
+    std::atomic<size_t> connections(0);
+    std::thread churn([&handler, &stop, &connections, &name, &recorder]() {
+        auto other = Util::CreateElementName("churn");
+        while (!stop) {
+            OHOS::sptr<ApduChannelStub> otherService(new ApduChannelStub());
+            handler->OnAbilityConnected(other, otherService->AsObject(), true);
+            handler->OnAbilityDisconnected(other, false);
+            handler->OnRemoteDied(otherService->AsObject());
+            // the service is reconnected, its channel stays the recorder
+            handler->OnAbilityConnected(name, recorder.AsObject(), false);
+            ++connections;
+        }
+    });
+
+    for (size_t i = 0; i < iterations; ++i) {
+        EXPECT_EQ(handler->OnHCEData(&select[0], select.size()), ERR_OK);
+    }
+    // the selects overlap at least one reconnection
+    while (connections == 0) {
+        std::this_thread::yield();
+    }
+    stop = true;
+    churn.join();
+
+    EXPECT_EQ(recorder.WaitForCommands(iterations), iterations);
+    // the connected service is used, the apdu path does not connect the service again
+    EXPECT_NE(handler->Dump().find("warm connection count: 0/"), std::string::npos);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the static responses of the service are sent to the reader without connecting the service
+*/
+TEST(CardEmulationEventHandler, OnHCEData_StaticResponse)
+{
+    const std::vector<unsigned char> select = HexStrToBytes("00A404000E325041592E5359532E444446303100");
+    const std::vector<unsigned char> selectResponse = HexStrToBytes("6F0B840E325041592E5359532E44444630319000");
+    const std::vector<unsigned char> getData = HexStrToBytes("80CA9F3600");
+    auto service = std::make_shared<CardEmulationServiceInfo>(NFC_EE_HOST);
+    service->SetName(Util::CreateElementName("app1"));
+    auto aids = AidSet::FromRawString({"325041592E5359532E4444463031"});
+    aids->SetType(CARDEMULATION_SERVICE_TYPE_NORMAL);
+    service->AddAidset(std::move(aids));
+    EXPECT_EQ(service->SetStaticResponses(CARDEMULATION_SERVICE_TYPE_NORMAL,
+                                          {StaticApduResponse{HexStrToBytes("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"),
+                                                              HexStrToBytes("00A404000E325041592E5359532E4444463031"),
+                                                              selectResponse},
+                                           StaticApduResponse{HexStrToBytes("FFFF"),
+                                                              HexStrToBytes("80CA"),
+                                                              HexStrToBytes("6A88")}}),
+              ERR_OK);
+
+    auto dh = std::make_shared<DeviceHostCEMock>();
+    EXPECT_CALL(*dh, SendData(selectResponse)).WillOnce(Return(true));
+    EXPECT_CALL(*dh, SendData(HexStrToBytes("6A88"))).WillOnce(Return(true));
+    auto routingManager = std::make_shared<SingleServiceRoutingManager>(service);
+    auto handler = std::make_shared<CardEmulationEventHandler>(dh, routingManager);
+    handler->OnHCEActivated();
+
+    EXPECT_EQ(handler->OnHCEData(&select[0], select.size()), ERR_OK);
+    EXPECT_EQ(handler->OnHCEData(&getData[0], getData.size()), ERR_OK);
+    handler->OnHCEDeactivated();
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : after a select answered statically, the commands do not reach the service of a previous transaction
+*/
+TEST(CardEmulationEventHandler, OnHCEData_StaticSelectAfterTransaction)
+{
+    const std::vector<unsigned char> select1 = HexStrToBytes("00A4040007F001020304050600");
+    const std::vector<unsigned char> select2 = HexStrToBytes("00A4040007F001020304050700");
+    const std::vector<unsigned char> getData = HexStrToBytes("80CA9F3600");
+    ApduRecorder recorder1;
+    auto service1 = std::make_shared<CardEmulationServiceInfo>(NFC_EE_HOST);
+    service1->SetName(Util::CreateElementName("app1"));
+    service1->SetApduChannel(recorder1.AsObject());
+    ApduRecorder recorder2;
+    auto service2 = std::make_shared<CardEmulationServiceInfo>(NFC_EE_HOST);
+    service2->SetName(Util::CreateElementName("app2"));
+    service2->SetApduChannel(recorder2.AsObject());
+    EXPECT_EQ(service2->SetStaticResponses(CARDEMULATION_SERVICE_TYPE_NORMAL,
+                                           {StaticApduResponse{HexStrToBytes("FFFFFFFFFFFFFFFFFFFFFF"),
+                                                               HexStrToBytes("00A4040007F00102030405"),
+                                                               HexStrToBytes("9000")}}),
+              ERR_OK);
+
+    auto dh = std::make_shared<DeviceHostCEMock>();
+    EXPECT_CALL(*dh, SendData(_)).Times(AnyNumber()).WillRepeatedly(Return(true));
+    auto routingManager = std::make_shared<SingleServiceRoutingManager>(service1);
+    auto handler = std::make_shared<CardEmulationEventHandler>(dh, routingManager);
+    handler->OnHCEActivated();
+    EXPECT_EQ(handler->OnHCEData(&select1[0], select1.size()), ERR_OK);
+    EXPECT_EQ(recorder1.WaitForCommands(1), 1u);
+    handler->OnHCEDeactivated();
+
+    routingManager->SetService(service2);
+    handler->OnHCEActivated();
+    EXPECT_EQ(handler->OnHCEData(&select2[0], select2.size()), ERR_OK);
+    EXPECT_EQ(handler->OnHCEData(&getData[0], getData.size()), ERR_OK);
+    EXPECT_EQ(recorder2.WaitForCommands(1), 1u);
+    EXPECT_EQ(recorder1.WaitForCommands(1), 1u);
+    handler->OnHCEDeactivated();
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the pinned services are warmed on the nfc handler after the transaction, not on activation
+*/
+TEST(CardEmulationEventHandler, OnHCEDeactivated_WarmPinnedServices)
+{
+    auto dh = std::make_shared<DeviceHostCEMock>();
+    auto handler = std::make_shared<CardEmulationEventHandler>(dh, std::make_shared<EmptyAidRoutingManager>());
+    EXPECT_CALL(*dh, PostTask(_, _)).Times(0);
+    handler->OnHCEActivated();
+    ::testing::Mock::VerifyAndClearExpectations(dh.get());
+
+    std::function<void()> warm;
+    EXPECT_CALL(*dh, PostTask(_, 0)).WillOnce(::testing::Invoke([&warm](std::function<void()> task, int64_t delayMs) {
+        warm = std::move(task);
+        return true;
+    }));
+    handler->OnHCEDeactivated();
+    ASSERT_TRUE(warm);
+    // nothing is pinned, no connection is made
+    warm();
+    EXPECT_NE(handler->Dump().find("warm connection count: 0/"), std::string::npos);
+}
+}  // namespace OHOS::nfc::cardemulation::test
@@ -19,10 +19,15 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 
+#include "aid_routing_adapter.h"
+#include "aid_routing_planner.h"
+#include "aid_routing_policy_factory.h"
 #include "aid_set.h"
 #include "card_emulation_def.h"
+#include "card_emulation_device_host_mock.h"
 #include "card_emulation_error.h"
 #include "card_emulation_service_info.h"
 #include "card_emulation_service_info_lite.h"
@@ -43,6 +48,8 @@ using namespace testing;
 class InstalledCEAppGetterMock : public InstalledCeServiceGetter {
 public:
     MOCK_METHOD1(GetInstalled, std::vector<std::shared_ptr<CardEmulationServiceInfo>>(int));
+    MOCK_METHOD2(GetInstalledByBundle,
+                 std::vector<std::shared_ptr<CardEmulationServiceInfo>>(int userId, const std::string& bundleName));
 
     MOCK_METHOD1(GetDynamic, std::vector<std::shared_ptr<CardEmulationServiceInfo>>(int userId));
     MOCK_METHOD1(GetDefaultElementName, OHOS::AppExecFwk::ElementName(int userId));
@@ -56,6 +63,8 @@ public:
 class ICEAppObserverMock : public IAidRoutingManager {
 public:
     MOCK_METHOD1(GetCardEmulationServicesByAid, std::vector<ServiceInfoTypePair>(const std::string& aid));
+    MOCK_METHOD0(GetPrimaryService, std::shared_ptr<CardEmulationServiceInfo>());
+    MOCK_METHOD0(GetPreferredService, std::shared_ptr<CardEmulationServiceInfo>());
     MOCK_METHOD3(OnCeServiceChanged,
                  int(std::vector<std::shared_ptr<CardEmulationServiceInfo>> const& apps,
                      const std::shared_ptr<CardEmulationServiceInfo>& primary,
@@ -65,6 +74,8 @@ public:
 class CEAppTestObserver : public IAidRoutingManager {
 public:
     MOCK_METHOD1(GetCardEmulationServicesByAid, std::vector<ServiceInfoTypePair>(const std::string& aid));
+    MOCK_METHOD0(GetPrimaryService, std::shared_ptr<CardEmulationServiceInfo>());
+    MOCK_METHOD0(GetPreferredService, std::shared_ptr<CardEmulationServiceInfo>());
     CEAppTestObserver(int expectNotifedCount,
                       size_t appCount,
                       OHOS::AppExecFwk::ElementName primaryServiceName,
@@ -485,4 +496,175 @@ TEST(CardEmulationServiceInfoManager, NoInit)
         EXPECT_TRUE(cesm.GetPrimaryServiceForType(0, {}) == OHOS::AppExecFwk::ElementName());
     }
 }
+
+class CommitCountingAdapter : public AidRoutingAdapter {
+public:
+    explicit CommitCountingAdapter(std::shared_ptr<ICardEmulationDeviceHost> dh) : AidRoutingAdapter(dh)
+    {
+    }
+    int AddAidRoutingEntry(const std::vector<unsigned char>& aid, int target, int aidType) override
+    {
+        return 0;
+    }
+    int CommitAidRouting() override
+    {
+        ++commitCount_;
+        return 0;
+    }
+    int commitCount_{0};
+};
+
+static std::shared_ptr<CardEmulationServiceInfo> CreatePackageService(const std::string& bundleName,
+                                                                      const std::string& aid)
+{
+    auto info = std::make_shared<CardEmulationServiceInfo>(NFC_EE_HOST);
+    info->SetName(Util::CreateElementName("ability_" + bundleName, bundleName));
+    auto aidset = AidSet::FromRawString({aid});
+    aidset->SetType(CARDEMULATION_SERVICE_TYPE_NORMAL);
+    info->AddAidsetToStatic(std::move(aidset));
+    return info;
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the package events within the window are applied per package and routed once
+*/
+TEST(CardEmulationServiceInfoManager, PackageChangesCoalesced)
+{
+    constexpr int packageCount = 8;
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> installed;
+    std::map<std::string, std::vector<std::shared_ptr<CardEmulationServiceInfo>>> updated;
+    for (int i = 0; i < packageCount; ++i) {
+        std::string bundleName = "pkg" + std::to_string(i);
+        installed.push_back(CreatePackageService(bundleName, "A00000000101" + std::to_string(10 + i)));
+        updated[bundleName] = {CreatePackageService(bundleName, "B00000000101" + std::to_string(10 + i))};
+    }
+    // pkg1 is removed, pkg8 is installed
+    updated["pkg1"] = {};
+    updated["pkg8"] = {CreatePackageService("pkg8", "C0000000010118")};
+
+    auto dh = std::make_shared<DeviceHostCEMock>();
+    EXPECT_CALL(*dh, GetAidRoutingTableSize()).WillRepeatedly(Return(512));
+    EXPECT_CALL(*dh, GetRemainRoutingTableSize()).WillRepeatedly(Return(512));
+    EXPECT_CALL(*dh, ClearRouting()).WillRepeatedly(Return(true));
+    EXPECT_CALL(*dh, GetDefaultRoute()).WillRepeatedly(Return(0));
+    EXPECT_CALL(*dh, GetDefaultOffHostRoute()).WillRepeatedly(Return(2));
+    EXPECT_CALL(*dh, GetOffHostUiccRoute()).WillRepeatedly(Return(std::vector<int>{}));
+    EXPECT_CALL(*dh, GetOffHostEseRoute()).WillRepeatedly(Return(std::vector<int>{2}));
+    EXPECT_CALL(*dh, GetAidMatchingMode()).WillRepeatedly(Return(AID_ROUTING_MODE_MASK_PREFIX));
+    auto adapter = std::make_shared<CommitCountingAdapter>(dh);
+    auto policy = RoutingPolicyFactory().CreateRoutingPolicy(
+        {NFC_EE_HOST}, adapter->GetAidRoutingMode(), CARDEMULATION_SERVICE_TYPE_SECURE);
+    auto planner = std::make_shared<AidRoutingPlanner>(std::move(policy), adapter);
+
+    auto getter = std::make_shared<InstalledCEAppGetterMock>();
+    EXPECT_CALL(*getter, GetInstalled(_)).WillOnce(Return(installed));
+    EXPECT_CALL(*getter, GetInstalledByBundle(DEFAULT_USER_ID, _))
+        .Times(packageCount + 1)
+        .WillRepeatedly(Invoke([&updated](int, const std::string& bundleName) { return updated[bundleName]; }));
+    EXPECT_CALL(*getter, GetDynamic(_))
+        .WillRepeatedly(Return(std::vector<std::shared_ptr<CardEmulationServiceInfo>>()));
+    EXPECT_CALL(*getter, GetDefaultElementName(_)).WillRepeatedly(Return(OHOS::AppExecFwk::ElementName()));
+
+    auto cesm = std::make_shared<CardEmulationServiceInfoManager>(planner, getter);
+    std::vector<std::function<void()>> scheduled;
+    cesm->SetPackageUpdateScheduler(
+        [&scheduled](std::function<void()> task, std::chrono::milliseconds) { scheduled.push_back(std::move(task)); },
+        CardEmulationServiceInfoManager::PACKAGE_UPDATE_WINDOW);
+    EXPECT_EQ(cesm->OnServiceUpdated(DEFAULT_USER_ID), ERR_OK);
+    EXPECT_EQ(adapter->commitCount_, 1);
+
+    for (auto& package : updated) {
+        cesm->OnPackageChanged(DEFAULT_USER_ID, package.first);
+    }
+    // repeated events of a package are applied once
+    cesm->OnPackageChanged(DEFAULT_USER_ID, "pkg0");
+    ASSERT_EQ(scheduled.size(), 1u);
+    EXPECT_EQ(adapter->commitCount_, 1);
+
+    scheduled[0]();
+    EXPECT_EQ(adapter->commitCount_, 2);
+    EXPECT_TRUE(planner->GetCardEmulationServicesByAid("A0000000010110").empty());
+    EXPECT_EQ(planner->GetCardEmulationServicesByAid("B0000000010110").size(), 1u);
+    EXPECT_TRUE(planner->GetCardEmulationServicesByAid("B0000000010111").empty());
+    EXPECT_EQ(planner->GetCardEmulationServicesByAid("C0000000010118").size(), 1u);
+    auto services = cesm->GetServicesByType(DEFAULT_USER_ID, CARDEMULATION_SERVICE_TYPE_NORMAL);
+    EXPECT_EQ(services.size(), static_cast<size_t>(packageCount));
+
+    // a new window starts with the next event
+    cesm->OnPackageChanged(DEFAULT_USER_ID, "pkg8");
+    EXPECT_EQ(scheduled.size(), 2u);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the services read without a bundle name are all read again, at once when the manager is not shared
+*/
+TEST(CardEmulationServiceInfoManager, PackageChangesWithoutBundleName)
+{
+    auto info = CreatePackageService("", "A0000000010110");
+    auto updated = CreatePackageService("", "B0000000010110");
+
+    auto observer = std::make_shared<ICEAppObserverMock>();
+    EXPECT_CALL(*observer, OnCeServiceChanged(_, _, _)).Times(2).WillRepeatedly(Return(0));
+    auto getter = std::make_shared<InstalledCEAppGetterMock>();
+    EXPECT_CALL(*getter, GetInstalled(_))
+        .WillOnce(Return(std::vector<std::shared_ptr<CardEmulationServiceInfo>>{info}))
+        .WillOnce(Return(std::vector<std::shared_ptr<CardEmulationServiceInfo>>{updated}));
+    EXPECT_CALL(*getter, GetInstalledByBundle(_, _)).Times(0);
+    EXPECT_CALL(*getter, GetDynamic(_))
+        .WillRepeatedly(Return(std::vector<std::shared_ptr<CardEmulationServiceInfo>>()));
+    EXPECT_CALL(*getter, GetDefaultElementName(_)).WillRepeatedly(Return(OHOS::AppExecFwk::ElementName()));
+
+    CardEmulationServiceInfoManager cesm(observer, getter);
+    EXPECT_EQ(cesm.OnServiceUpdated(DEFAULT_USER_ID), ERR_OK);
+    cesm.SetPackageUpdateScheduler(
+        [](std::function<void()> task, std::chrono::milliseconds) { FAIL() << "scheduled without an owner"; },
+        CardEmulationServiceInfoManager::PACKAGE_UPDATE_WINDOW);
+    cesm.OnPackageChanged(DEFAULT_USER_ID, "pkg0");
+    auto services = cesm.GetServicesByType(DEFAULT_USER_ID, CARDEMULATION_SERVICE_TYPE_NORMAL);
+    ASSERT_EQ(services.size(), 1u);
+
+    // the next event is applied as well, no flush is left pending
+    EXPECT_CALL(*getter, GetInstalled(_))
+        .WillOnce(Return(std::vector<std::shared_ptr<CardEmulationServiceInfo>>{info}));
+    EXPECT_CALL(*observer, OnCeServiceChanged(_, _, _)).WillOnce(Return(0));
+    cesm.OnPackageChanged(DEFAULT_USER_ID, "pkg0");
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the services loaded from the json file keep their bundle, only the changed package is read again
+*/
+TEST(CardEmulationServiceInfoManager, PackageChangesLoadedFromJson)
+{
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> installed;
+    nlohmann::json::parse(Util::CreateServicesJson(3, 1)).at("abilities").get_to(installed);
+    ASSERT_EQ(installed.size(), 3u);
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> reinstalled;
+    nlohmann::json::parse(Util::CreateServicesJson(3, 2)).at("abilities").get_to(reinstalled);
+    auto updated = reinstalled[1];
+    ASSERT_EQ(updated->GetName()->GetBundleName(), "bundle1");
+
+    auto observer = std::make_shared<ICEAppObserverMock>();
+    EXPECT_CALL(*observer, OnCeServiceChanged(_, _, _)).Times(2).WillRepeatedly(Return(0));
+    auto getter = std::make_shared<InstalledCEAppGetterMock>();
+    EXPECT_CALL(*getter, GetInstalled(_)).WillOnce(Return(installed));
+    EXPECT_CALL(*getter, GetInstalledByBundle(_, _)).Times(0);
+    EXPECT_CALL(*getter, GetInstalledByBundle(DEFAULT_USER_ID, "bundle1"))
+        .WillOnce(Return(std::vector<std::shared_ptr<CardEmulationServiceInfo>>{updated}));
+    EXPECT_CALL(*getter, GetDynamic(_))
+        .WillRepeatedly(Return(std::vector<std::shared_ptr<CardEmulationServiceInfo>>()));
+    EXPECT_CALL(*getter, GetDefaultElementName(_)).WillRepeatedly(Return(OHOS::AppExecFwk::ElementName()));
+
+    CardEmulationServiceInfoManager cesm(observer, getter);
+    EXPECT_EQ(cesm.OnServiceUpdated(DEFAULT_USER_ID), ERR_OK);
+    cesm.OnPackageChanged(DEFAULT_USER_ID, "bundle1");
+    EXPECT_EQ(cesm.GetServicesByType(DEFAULT_USER_ID, CARDEMULATION_SERVICE_TYPE_NORMAL).size(), 2u);
+    auto secure = cesm.GetServicesByType(DEFAULT_USER_ID, CARDEMULATION_SERVICE_TYPE_SECURE);
+    ASSERT_EQ(secure.size(), 1u);
+}
 }
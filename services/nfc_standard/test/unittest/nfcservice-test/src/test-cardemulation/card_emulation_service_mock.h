@@ -21,6 +21,7 @@
 #include "card_emulation_service_info.h"
 #include "card_emulation_service_info_lite.h"
 #include "element_name.h"
+#include "icard_emulation_agent.h"
 #include "icard_emulation_service.h"
 namespace OHOS::nfc::cardemulation::test{
 class MockCardEmulationService : public OHOS::nfc::cardemulation::ICardEmulationService {
@@ -42,6 +43,12 @@ public:
                      const OHOS::AppExecFwk::ElementName& elementName,
                      const std::string& tag,
                      const std::vector<std::string>& aidSet));
+    MOCK_METHOD5(AddAidsForService,
+                 int(int userId,
+                     const OHOS::AppExecFwk::ElementName& elementName,
+                     const std::string& tag,
+                     const std::vector<std::string>& aidSet,
+                     const std::vector<OHOS::nfc::sdk::cardemulation::StaticApduResponse>& responses));
     MOCK_METHOD3(RemoveAidsForService,
                  int(int userId, const OHOS::AppExecFwk::ElementName& elementName, const std::string& tag));
     MOCK_METHOD3(MarkOffHostForService,
@@ -62,6 +69,7 @@ public:
                  std::vector<std::unique_ptr<OHOS::nfc::sdk::cardemulation::CardEmulationServiceInfoLite>>(
                      int userId,
                      const std::string& type));
+    MOCK_METHOD1(Dump, void(int fd));
 
     MOCK_METHOD0(OnHCEActivated, int(void));
     MOCK_METHOD2(OnHCEData, int(const unsigned char* data, size_t len));
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/hce_latency_tracer.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+using namespace OHOS::nfc;
+namespace OHOS::nfc::cardemulation::test {
+static constexpr int64_t NS_PER_US = 1000;
+
+class FakeClock {
+public:
+    HceLatencyTracer::Clock Get()
+    {
+        return [this]() { return now_; };
+    }
+    void Advance(int64_t us)
+    {
+        now_ += us * NS_PER_US;
+    }
+
+private:
+    int64_t now_{NS_PER_US};
+};
+
+// one command apdu handled by the application
+static void TraceAppApdu(HceLatencyTracer& tracer, FakeClock& clock, int64_t appUs)
+{
+    tracer.Begin();
+    clock.Advance(50);
+    tracer.Mark(HceStage::DEVICE_HOST);
+    clock.Advance(20);
+    tracer.Mark(HceStage::DISPATCHED);
+    clock.Advance(10);
+    tracer.Mark(HceStage::AID_RESOLVED);
+    clock.Advance(100);
+    tracer.Mark(HceStage::SENT_TO_APP);
+    clock.Advance(appUs);
+    tracer.Mark(HceStage::APP_RESPONDED);
+    clock.Advance(300);
+    tracer.End();
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the time in the application is separated from the time in the stack
+*/
+TEST(HceLatencyTracer, app_and_stack)
+{
+    FakeClock clock;
+    HceLatencyTracer tracer(clock.Get());
+    tracer.SetService("svc1");
+    TraceAppApdu(tracer, clock, 2000);
+
+    ServiceLatency latency;
+    ASSERT_TRUE(tracer.GetServiceLatency("svc1", latency));
+    EXPECT_EQ(latency.total_.GetCount(), 1u);
+    EXPECT_EQ(latency.total_.GetMax(), 2480u);
+    EXPECT_EQ(latency.app_.GetMax(), 2000u);
+    EXPECT_EQ(latency.stack_.GetMax(), 480u);
+    EXPECT_EQ(tracer.GetStageLatency(HceStage::DEVICE_HOST).GetMax(), 50u);
+    EXPECT_EQ(tracer.GetStageLatency(HceStage::APP_RESPONDED).GetMax(), 2000u);
+    EXPECT_EQ(tracer.GetStageLatency(HceStage::SENT_TO_READER).GetMax(), 300u);
+
+    // answered statically, the stack takes all the time
+    tracer.Begin();
+    tracer.Mark(HceStage::DISPATCHED);
+    clock.Advance(40);
+    tracer.End();
+    ASSERT_TRUE(tracer.GetServiceLatency("svc1", latency));
+    EXPECT_EQ(latency.total_.GetCount(), 2u);
+    EXPECT_EQ(latency.app_.GetCount(), 1u);
+    EXPECT_EQ(latency.stack_.GetCount(), 2u);
+
+    EXPECT_NE(tracer.Dump().find("svc1"), std::string::npos);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : a trace is closed once, a new command or the deactivation abandons it
+*/
+TEST(HceLatencyTracer, abandoned)
+{
+    FakeClock clock;
+    HceLatencyTracer tracer(clock.Get());
+    // no open trace
+    tracer.Mark(HceStage::DISPATCHED);
+    tracer.End();
+    EXPECT_TRUE(tracer.GetTracedServices().empty());
+
+    tracer.Begin();
+    tracer.Begin();
+    EXPECT_EQ(tracer.GetAbandonedCount(), 1u);
+    tracer.Deactivate();
+    EXPECT_EQ(tracer.GetAbandonedCount(), 2u);
+    tracer.End();
+    EXPECT_TRUE(tracer.GetTracedServices().empty());
+
+    // the service is forgotten on deactivation
+    tracer.SetService("svc1");
+    tracer.Deactivate();
+    TraceAppApdu(tracer, clock, 10);
+    ServiceLatency latency;
+    EXPECT_FALSE(tracer.GetServiceLatency("svc1", latency));
+    EXPECT_TRUE(tracer.GetServiceLatency(HceLatencyTracer::UNRESOLVED_SERVICE, latency));
+
+    tracer.Reset();
+    EXPECT_TRUE(tracer.GetTracedServices().empty());
+    EXPECT_EQ(tracer.GetAbandonedCount(), 0u);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the services above the limit are counted together
+*/
+TEST(HceLatencyTracer, service_limit)
+{
+    FakeClock clock;
+    HceLatencyTracer tracer(clock.Get());
+    for (size_t i = 0; i < HceLatencyTracer::MAX_TRACED_SERVICES + 3; ++i) {
+        tracer.SetService("svc" + std::to_string(i));
+        TraceAppApdu(tracer, clock, 10);
+    }
+    EXPECT_EQ(tracer.GetTracedServices().size(), HceLatencyTracer::MAX_TRACED_SERVICES + 1);
+    ServiceLatency latency;
+    ASSERT_TRUE(tracer.GetServiceLatency(HceLatencyTracer::OTHER_SERVICES, latency));
+    EXPECT_EQ(latency.total_.GetCount(), 3u);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the stages are marked from the threads the apdu passes, each trace is closed once
+*/
+TEST(HceLatencyTracer, threads)
+{
+    constexpr int apduCount = 1000;
+    HceLatencyTracer tracer;
+    tracer.SetService("svc1");
+    for (int i = 0; i < apduCount; ++i) {
+        tracer.Begin();
+        std::thread dispatcher([&tracer]() {
+            tracer.Mark(HceStage::DISPATCHED);
+            tracer.Mark(HceStage::SENT_TO_APP);
+        });
+        dispatcher.join();
+        tracer.Mark(HceStage::APP_RESPONDED);
+        tracer.End();
+    }
+    ServiceLatency latency;
+    ASSERT_TRUE(tracer.GetServiceLatency("svc1", latency));
+    EXPECT_EQ(latency.total_.GetCount(), static_cast<uint64_t>(apduCount));
+    EXPECT_EQ(latency.app_.GetCount(), static_cast<uint64_t>(apduCount));
+    EXPECT_EQ(tracer.GetStageLatency(HceStage::DISPATCHED).GetCount(), static_cast<uint64_t>(apduCount));
+    EXPECT_EQ(tracer.GetAbandonedCount(), 0u);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the percentiles are the upper bounds of the log2 buckets
+*/
+TEST(HceLatencyTracer, histogram)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.Percentile(50), 0u);
+    for (uint64_t us = 1; us <= 100; ++us) {
+        histogram.Add(us);
+    }
+    EXPECT_EQ(histogram.GetCount(), 100u);
+    EXPECT_EQ(histogram.GetMean(), 50u);
+    EXPECT_EQ(histogram.Percentile(50), 63u);
+    EXPECT_EQ(histogram.Percentile(99), 100u);
+    histogram.Add(UINT64_MAX / 2);
+    EXPECT_EQ(histogram.Percentile(100), UINT64_MAX / 2);
+}
+}  // namespace OHOS::nfc::cardemulation::test
@@ -88,4 +88,43 @@ TEST(IT_AidRoutingPlanner, plan)
     AidRoutingPlanner planner(std::move(policy), controller);
     EXPECT_EQ(ERR_COMMIT_ROUTING_FAILED, planner.OnCeServiceChanged({info1, info2, info3}, info2, info3));
 }
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : sibling aids merged into a prefix entry make room for the whole aidset
+*/
+TEST(IT_AidRoutingPlanner, plan_compressed)
+{
+    auto as1 = AidSet::FromRawString({"F0010203040501", "F0010203040502", "F0010203040503", "F0010203040504"});
+    as1->SetType(kSecureType);
+    std::shared_ptr<CardEmulationServiceInfo> info1 = std::make_shared<CardEmulationServiceInfo>("eSE1");
+    info1->SetName(Util::CreateElementName("info1"));
+    info1->AddAidset(std::move(as1));
+
+    auto dh = std::make_shared<DeviceHostCEMock>();
+    // 4 exact aids need 44 bytes, the prefix entry needs 10 bytes
+    size_t capacity = 44;
+    std::vector<unsigned char> prefix = HexStrToBytes("F00102030405");
+    EXPECT_CALL(*dh, GetAidRoutingTableSize()).WillRepeatedly(testing::Return(capacity));
+    EXPECT_CALL(*dh, GetRemainRoutingTableSize()).WillRepeatedly(testing::Return(capacity - 4));
+    EXPECT_CALL(*dh, ClearRouting()).WillRepeatedly(testing::Return(true));
+    EXPECT_CALL(*dh, AddAidRouting(std::string(prefix.begin(), prefix.end()), 2, AidTypeToInt(AidType::PREFIX)))
+        .WillOnce(testing::Return(true));
+    EXPECT_CALL(*dh, AddAidRouting(std::string(), 0, AidTypeToInt(AidType::PREFIX))).WillOnce(testing::Return(true));
+    EXPECT_CALL(*dh, CommitRouting()).WillRepeatedly(testing::Return(true));
+    EXPECT_CALL(*dh, GetDefaultRoute()).WillRepeatedly(testing::Return(0));
+    EXPECT_CALL(*dh, GetDefaultOffHostRoute()).WillRepeatedly(testing::Return(2));
+    EXPECT_CALL(*dh, GetOffHostUiccRoute()).WillRepeatedly(testing::Return(std::vector<int>{}));
+    EXPECT_CALL(*dh, GetOffHostEseRoute()).WillRepeatedly(testing::Return(std::vector<int>{2}));
+    EXPECT_CALL(*dh, GetAidMatchingMode()).WillRepeatedly(testing::Return(AID_ROUTING_MODE_MASK_PREFIX));
+
+    auto controller = std::make_shared<AidRoutingAdapter>(dh);
+    auto mode = controller->GetAidRoutingMode();
+    auto policy = RoutingPolicyFactory().CreateRoutingPolicy(kSupportedLocations, mode, kSecureType);
+    AidRoutingPlanner planner(std::move(policy), controller);
+    EXPECT_EQ(ERR_OK, planner.OnCeServiceChanged({info1}, info1, nullptr));
+    EXPECT_EQ(planner.GetCardEmulationServicesByAid("F0010203040504").size(), 1u);
+    EXPECT_NE(planner.Dump().find("evicted aidset count: 0"), std::string::npos);
+}
 }
\ No newline at end of file
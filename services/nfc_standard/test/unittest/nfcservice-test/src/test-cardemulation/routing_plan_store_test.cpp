@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "routing_plan_store.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "aid_routing_adapter.h"
+#include "aid_routing_planner.h"
+#include "aid_routing_policy_factory.h"
+#include "aid_set.h"
+#include "card_emulation_def.h"
+#include "card_emulation_device_host_mock.h"
+#include "card_emulation_service_info.h"
+#include "card_emulation_util.h"
+#include "test_util.h"
+
+using namespace testing;
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+namespace OHOS::nfc::cardemulation::test {
+static const std::string kSecureType = CARDEMULATION_SERVICE_TYPE_SECURE;
+static const std::string kNormalType = CARDEMULATION_SERVICE_TYPE_NORMAL;
+static const std::vector<std::string> kSupportedLocations = {"host", "eSE1"};
+
+class MemoryPlanStore : public RoutingPlanStore {
+public:
+    MemoryPlanStore() : RoutingPlanStore("")
+    {
+    }
+    std::string content_{};
+
+protected:
+    bool ReadFile(std::string& content) override
+    {
+        content = content_;
+        return !content.empty();
+    }
+    bool WriteFile(const std::string& content) override
+    {
+        content_ = content;
+        return true;
+    }
+};
+
+class RecordingAdapter : public AidRoutingAdapter {
+public:
+    explicit RecordingAdapter(std::shared_ptr<ICardEmulationDeviceHost> dh) : AidRoutingAdapter(dh)
+    {
+    }
+    int AddAidRoutingEntry(const std::vector<unsigned char>& aid, int target, int aidType) override
+    {
+        pending_.push_back(RoutingEntry{aid, target, aidType});
+        return 0;
+    }
+    int CommitAidRouting() override
+    {
+        committed_ = std::move(pending_);
+        pending_.clear();
+        ++commitCount_;
+        return 0;
+    }
+    std::vector<RoutingEntry> pending_{};
+    std::vector<RoutingEntry> committed_{};
+    int commitCount_{0};
+};
+
+static std::shared_ptr<CardEmulationServiceInfo> CreateService(const std::string& name,
+                                                               const std::string& location,
+                                                               const std::string& type,
+                                                               const std::vector<std::string>& aids)
+{
+    auto info = std::make_shared<CardEmulationServiceInfo>(location);
+    Util::CardEmulationServiceInfoSetName(info, name);
+    auto as = AidSet::FromRawString(aids);
+    as->SetType(type);
+    info->AddAidset(std::move(as));
+    return info;
+}
+
+static std::shared_ptr<DeviceHostCEMock> CreateDeviceHost()
+{
+    auto dh = std::make_shared<DeviceHostCEMock>();
+    EXPECT_CALL(*dh, GetAidRoutingTableSize()).WillRepeatedly(Return(512));
+    EXPECT_CALL(*dh, GetRemainRoutingTableSize()).WillRepeatedly(Return(512));
+    EXPECT_CALL(*dh, ClearRouting()).WillRepeatedly(Return(true));
+    EXPECT_CALL(*dh, GetDefaultRoute()).WillRepeatedly(Return(0));
+    EXPECT_CALL(*dh, GetDefaultOffHostRoute()).WillRepeatedly(Return(2));
+    EXPECT_CALL(*dh, GetOffHostUiccRoute()).WillRepeatedly(Return(std::vector<int>{}));
+    EXPECT_CALL(*dh, GetOffHostEseRoute()).WillRepeatedly(Return(std::vector<int>{2}));
+    EXPECT_CALL(*dh, GetAidMatchingMode()).WillRepeatedly(Return(AID_ROUTING_MODE_MASK_PREFIX));
+    EXPECT_CALL(*dh, IsNfcEnabled()).WillRepeatedly(Return(true));
+    return dh;
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the hash changes with every planning input
+*/
+TEST(RoutingPlanStore, hash_inputs)
+{
+    auto ese = CreateService("app1", "eSE1", kSecureType, {"A0000000010101"});
+    auto host = CreateService("app2", "host", kNormalType, {"B0000000010101"});
+    auto hash = RoutingPlanStore::HashInputs({ese, host}, ese, nullptr, AID_ROUTING_MODE_MASK_PREFIX, 512, 0);
+
+    EXPECT_EQ(RoutingPlanStore::HashInputs({ese, host}, ese, nullptr, AID_ROUTING_MODE_MASK_PREFIX, 512, 0), hash);
+    EXPECT_NE(RoutingPlanStore::HashInputs({ese, host}, ese, host, AID_ROUTING_MODE_MASK_PREFIX, 512, 0), hash);
+    EXPECT_NE(RoutingPlanStore::HashInputs({ese, host}, nullptr, nullptr, AID_ROUTING_MODE_MASK_PREFIX, 512, 0),
+              hash);
+    EXPECT_NE(RoutingPlanStore::HashInputs({ese, host}, ese, nullptr, 0, 512, 0), hash);
+    EXPECT_NE(RoutingPlanStore::HashInputs({ese, host}, ese, nullptr, AID_ROUTING_MODE_MASK_PREFIX, 256, 0), hash);
+    EXPECT_NE(RoutingPlanStore::HashInputs({ese}, ese, nullptr, AID_ROUTING_MODE_MASK_PREFIX, 512, 0), hash);
+
+    auto as = AidSet::FromRawString({"B0000000010102"});
+    as->SetType(kNormalType);
+    host->AddAidset(std::move(as));
+    EXPECT_NE(RoutingPlanStore::HashInputs({ese, host}, ese, nullptr, AID_ROUTING_MODE_MASK_PREFIX, 512, 0), hash);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the stored plan is read back by another store
+*/
+TEST(RoutingPlanStore, store_load)
+{
+    RoutingPlan plan;
+    plan.inputsHash_ = 0xFEDCBA9876543210ULL;
+    plan.entries_.push_back(RoutingEntry{HexStrToBytes("A0000000010101"), 2, AidTypeToInt(AidType::EXACT)});
+    plan.entries_.push_back(RoutingEntry{HexStrToBytes("A00000000201"), 2, AidTypeToInt(AidType::PREFIX)});
+    plan.aidsets_.push_back(RoutingPlan::RoutedAidset{"app1", kSecureType});
+
+    MemoryPlanStore writer;
+    EXPECT_EQ(writer.Load(), nullptr);
+    EXPECT_TRUE(writer.Store(plan));
+
+    MemoryPlanStore reader;
+    reader.content_ = writer.content_;
+    auto loaded = reader.Load();
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->inputsHash_, plan.inputsHash_);
+    ASSERT_EQ(loaded->entries_.size(), 2u);
+    EXPECT_EQ(loaded->entries_[1].aid_, plan.entries_[1].aid_);
+    EXPECT_EQ(loaded->entries_[1].aidPattern_, AidTypeToInt(AidType::PREFIX));
+    ASSERT_EQ(loaded->aidsets_.size(), 1u);
+    EXPECT_EQ(loaded->aidsets_[0].service_, "app1");
+
+    MemoryPlanStore broken;
+    broken.content_ = "{\"version\":";
+    EXPECT_EQ(broken.Load(), nullptr);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : unchanged inputs program the stored plan and defer the planning
+*/
+TEST(RoutingPlanStore, planner_fast_path)
+{
+    auto ese = CreateService("app1", "eSE1", kSecureType, {"A0000000010101", "A0000000010102"});
+    auto host = CreateService("app2", "host", kNormalType, {"B0000000010101"});
+    auto dh = CreateDeviceHost();
+    auto controller = std::make_shared<RecordingAdapter>(dh);
+    auto policy = RoutingPolicyFactory().CreateRoutingPolicy(
+        kSupportedLocations, controller->GetAidRoutingMode(), kSecureType);
+    auto planner = std::make_shared<AidRoutingPlanner>(std::move(policy), controller);
+    auto store = std::make_shared<MemoryPlanStore>();
+    std::vector<std::function<void()>> deferred;
+    planner->SetPlanStore(store, [&deferred](std::function<void()> task) { deferred.push_back(std::move(task)); });
+
+    // planned and stored
+    planner->OnCeServiceChanged({ese, host}, ese, nullptr);
+    EXPECT_TRUE(deferred.empty());
+    ASSERT_NE(store->Load(), nullptr);
+    auto planned = controller->committed_;
+    EXPECT_EQ(store->Load()->entries_.size() + 1, planned.size());
+
+    // same inputs, the stored plan is programmed and the planning is deferred
+    planner->OnCeServiceChanged({ese, host}, ese, nullptr);
+    EXPECT_EQ(controller->committed_.size(), planned.size());
+    EXPECT_EQ(controller->commitCount_, 2);
+    EXPECT_EQ(planner->GetCardEmulationServicesByAid("A0000000010101").size(), 1u);
+    ASSERT_EQ(deferred.size(), 1u);
+    // the planning agrees with the stored plan, nothing is programmed again
+    deferred[0]();
+    EXPECT_EQ(controller->commitCount_, 2);
+
+    // a stale plan of the same inputs is corrected by the deferred planning
+    RoutingPlan stale = *store->Load();
+    stale.entries_.pop_back();
+    store->Store(stale);
+    planner->OnCeServiceChanged({ese, host}, ese, nullptr);
+    EXPECT_EQ(controller->committed_.size(), planned.size() - 1);
+    ASSERT_EQ(deferred.size(), 2u);
+    deferred[1]();
+    EXPECT_EQ(controller->commitCount_, 4);
+    EXPECT_EQ(controller->committed_.size(), planned.size());
+
+    // a deferred planning replaced by a newer one is dropped
+    planner->OnCeServiceChanged({ese, host}, ese, nullptr);
+    planner->OnCeServiceChanged({ese, host}, nullptr, nullptr);
+    ASSERT_EQ(deferred.size(), 3u);
+    int commitCount = controller->commitCount_;
+    deferred[2]();
+    EXPECT_EQ(controller->commitCount_, commitCount);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the deferred planning is dropped while nfc is off and without an executor
+*/
+TEST(RoutingPlanStore, planner_deferred_nfc_off)
+{
+    auto ese = CreateService("app1", "eSE1", kSecureType, {"A0000000010101", "A0000000010102"});
+    auto host = CreateService("app2", "host", kNormalType, {"B0000000010101"});
+    auto dh = CreateDeviceHost();
+    auto controller = std::make_shared<RecordingAdapter>(dh);
+    auto policy = RoutingPolicyFactory().CreateRoutingPolicy(
+        kSupportedLocations, controller->GetAidRoutingMode(), kSecureType);
+    auto planner = std::make_shared<AidRoutingPlanner>(std::move(policy), controller);
+    auto store = std::make_shared<MemoryPlanStore>();
+    std::vector<std::function<void()>> deferred;
+    planner->SetPlanStore(store, [&deferred](std::function<void()> task) { deferred.push_back(std::move(task)); });
+    planner->OnCeServiceChanged({ese, host}, ese, nullptr);
+
+    RoutingPlan stale = *store->Load();
+    stale.entries_.pop_back();
+    store->Store(stale);
+    planner->OnCeServiceChanged({ese, host}, ese, nullptr);
+    ASSERT_EQ(deferred.size(), 1u);
+    int commitCount = controller->commitCount_;
+    EXPECT_CALL(*dh, IsNfcEnabled()).WillRepeatedly(Return(false));
+    deferred[0]();
+    EXPECT_EQ(controller->commitCount_, commitCount);
+    EXPECT_EQ(store->Load()->entries_.size(), stale.entries_.size());
+
+    // without an executor the stored plan is kept
+    planner->SetPlanStore(store, nullptr);
+    planner->OnCeServiceChanged({ese, host}, ese, nullptr);
+    EXPECT_EQ(deferred.size(), 1u);
+    EXPECT_EQ(controller->commitCount_, commitCount + 1);
+    EXPECT_EQ(controller->committed_.size(), stale.entries_.size() + 1);
+}
+}  // namespace OHOS::nfc::cardemulation::test
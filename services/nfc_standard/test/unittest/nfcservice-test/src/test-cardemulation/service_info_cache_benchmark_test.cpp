@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "service_info_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#include "card_emulation_service_info.h"
+#include "nlohmann/json.hpp"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+namespace OHOS::nfc::cardemulation::test {
+static const std::string kSourcePath = "./service_info_cache_benchmark_test_static.json";
+
+static void WriteSource(const std::string& content)
+{
+    std::ofstream f(kSourcePath, std::ios::trunc);
+    f << content;
+}
+
+// what CeServiceGetter does without the cache
+static std::vector<std::shared_ptr<CardEmulationServiceInfo>> ParseSource()
+{
+    std::ifstream f(kSourcePath);
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> infos;
+    nlohmann::json::parse(f).at("abilities").get_to(infos);
+    return infos;
+}
+
+static void RemoveFiles(const ServiceInfoCache& cache)
+{
+    std::remove(kSourcePath.c_str());
+    std::remove(cache.GetCachePath().c_str());
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : parsing 500 services from json and from the cache
+*/
+TEST(ServiceInfoCache, benchmark_500_services)
+{
+    constexpr size_t serviceCount = 500;
+    constexpr size_t aidsPerService = 4;
+    ServiceInfoCache cache(kSourcePath);
+    WriteSource(Util::CreateServicesJson(serviceCount, aidsPerService));
+
+    auto start = std::chrono::steady_clock::now();
+    auto parsed = ParseSource();
+    auto jsonElapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> infos;
+    SourceStamp stamp;
+    EXPECT_FALSE(cache.Load(infos, stamp));
+    EXPECT_TRUE(cache.Store(stamp, parsed));
+
+    start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(cache.Load(infos, stamp));
+    auto cacheElapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    printf("services: %zu, aids: %zu, json: %lld us, cache: %lld us\n",
+           serviceCount,
+           serviceCount * (aidsPerService + 1),
+           static_cast<long long>(jsonElapsed.count()),
+           static_cast<long long>(cacheElapsed.count()));
+
+    EXPECT_EQ(parsed.size(), infos.size());
+    RemoveFiles(cache);
+}
+}  // namespace OHOS::nfc::cardemulation::test
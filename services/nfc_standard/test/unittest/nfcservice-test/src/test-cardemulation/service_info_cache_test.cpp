@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "service_info_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "aid_set.h"
+#include "card_emulation_def.h"
+#include "card_emulation_service_info.h"
+#include "element_name.h"
+#include "nlohmann/json.hpp"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+namespace OHOS::nfc::cardemulation::test {
+static const std::string kSourcePath = "./service_info_cache_test_static.json";
+
+static void WriteSource(const std::string& content)
+{
+    std::ofstream f(kSourcePath, std::ios::trunc);
+    f << content;
+}
+
+// what CeServiceGetter does without the cache
+static std::vector<std::shared_ptr<CardEmulationServiceInfo>> ParseSource()
+{
+    std::ifstream f(kSourcePath);
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> infos;
+    nlohmann::json::parse(f).at("abilities").get_to(infos);
+    return infos;
+}
+
+static void RemoveFiles(const ServiceInfoCache& cache)
+{
+    std::remove(kSourcePath.c_str());
+    std::remove(cache.GetCachePath().c_str());
+}
+
+static void ExpectSameServices(const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& expected,
+                               const std::vector<std::shared_ptr<CardEmulationServiceInfo>>& actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i]->GetName()->GetAbilityName(), actual[i]->GetName()->GetAbilityName());
+        EXPECT_EQ(expected[i]->GetName()->GetBundleName(), actual[i]->GetName()->GetBundleName());
+        EXPECT_EQ(expected[i]->GetExecutionEnvironment(), actual[i]->GetExecutionEnvironment());
+        EXPECT_EQ(expected[i]->GetLabel(), actual[i]->GetLabel());
+        EXPECT_EQ(expected[i]->MustUnlock(), actual[i]->MustUnlock());
+        expected[i]->Visit([&actual, i](const std::string& type, std::shared_ptr<AidSet> aidset) {
+            auto restored = actual[i]->GetAidsetByType(type);
+            ASSERT_TRUE(restored != nullptr);
+            EXPECT_EQ(aidset->GetAllAidRawString(), restored->GetAllAidRawString());
+            EXPECT_EQ(aidset->GetDescription(), restored->GetDescription());
+            EXPECT_EQ(restored->GetOwner().lock(), actual[i]);
+        });
+    }
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the services read from the cache equal the parsed ones
+*/
+TEST(ServiceInfoCache, round_trip)
+{
+    ServiceInfoCache cache(kSourcePath);
+    WriteSource(Util::CreateServicesJson(4, 3));
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> infos;
+    SourceStamp stamp;
+    EXPECT_FALSE(cache.Load(infos, stamp));
+    EXPECT_TRUE(infos.empty());
+
+    auto parsed = ParseSource();
+    EXPECT_TRUE(cache.Store(stamp, parsed));
+    SourceStamp cachedStamp;
+    EXPECT_TRUE(cache.Load(infos, cachedStamp));
+    EXPECT_EQ(cachedStamp.hash_, stamp.hash_);
+    ExpectSameServices(parsed, infos);
+    auto aidset = infos[1]->GetAidsetByType(CARDEMULATION_SERVICE_TYPE_SECURE);
+    ASSERT_TRUE(aidset != nullptr);
+    EXPECT_TRUE(aidset->HasAidString(AidString("B0000000000001*")));
+    RemoveFiles(cache);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : a changed json file makes the cache stale, a touched one does not
+*/
+TEST(ServiceInfoCache, stale)
+{
+    ServiceInfoCache cache(kSourcePath);
+    std::string content = Util::CreateServicesJson(2, 1);
+    WriteSource(content);
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> infos;
+    SourceStamp stamp;
+    EXPECT_FALSE(cache.Load(infos, stamp));
+    EXPECT_TRUE(cache.Store(stamp, ParseSource()));
+
+    // rewritten with the same content
+    WriteSource(content);
+    EXPECT_TRUE(cache.Load(infos, stamp));
+    EXPECT_EQ(infos.size(), 2u);
+
+    WriteSource(Util::CreateServicesJson(3, 1));
+    EXPECT_FALSE(cache.Load(infos, stamp));
+    EXPECT_TRUE(cache.Store(stamp, ParseSource()));
+    EXPECT_TRUE(cache.Load(infos, stamp));
+    EXPECT_EQ(infos.size(), 3u);
+
+    // a cut cache is rejected
+    {
+        std::ofstream f(cache.GetCachePath(), std::ios::binary | std::ios::trunc);
+        f << "CESC";
+    }
+    EXPECT_FALSE(cache.Load(infos, stamp));
+
+    std::remove(kSourcePath.c_str());
+    EXPECT_FALSE(cache.Load(infos, stamp));
+    RemoveFiles(cache);
+}
+}  // namespace OHOS::nfc::cardemulation::test
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "soft_nfcc.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "aid_routing_adapter.h"
+#include "aid_string.h"
+#include "card_emulation_util.h"
+
+namespace OHOS::nfc::cardemulation {
+namespace test {
+// qualifier type of an aid entry, the matching pattern is or-ed in
+static constexpr unsigned char AID_QUALIFIER_TYPE = 0x02;
+
+SoftNfcc::SoftNfcc(const SoftNfccConfig& config)
+    : config_(config),
+    staged_(),
+    committed_(),
+    rejected_(0),
+    commits_(0),
+    lastSentData_()
+{
+}
+
+bool SoftNfcc::AddAidRouting(std::string aid, int route, int aidInfo)
+{
+    if (!IsKnownRoute(route) || !IsSupportedAid(aid.size(), aidInfo)) {
+        ++rejected_;
+        return false;
+    }
+    Entry entry;
+    entry.aid_.assign(aid.begin(), aid.end());
+    entry.route_ = route;
+    entry.aidInfo_ = aidInfo;
+    if (config_.secure_) {
+        entry.powerState_ = POWER_SWITCHED_ON;
+    } else {
+        entry.powerState_ = (route == config_.defaultRoute_) ? config_.hostPowerState_ : config_.offHostPowerState_;
+    }
+
+    // an aid is routed once, adding it again moves it
+    auto it = std::find_if(
+        staged_.begin(), staged_.end(), [&entry](const Entry& e) { return e.aid_ == entry.aid_; });
+    int used = GetStagedBytes() - ((it != staged_.end()) ? GetEntryCost(it->aid_.size()) : 0);
+    if (used + GetEntryCost(entry.aid_.size()) > GetAidRoutingTableSize()) {
+        ++rejected_;
+        return false;
+    }
+    if (it != staged_.end()) {
+        *it = std::move(entry);
+    } else {
+        staged_.emplace_back(std::move(entry));
+    }
+    return true;
+}
+
+bool SoftNfcc::RemoveAidRouting(const std::string& aid)
+{
+    std::vector<unsigned char> bytes(aid.begin(), aid.end());
+    auto it = std::find_if(staged_.begin(), staged_.end(), [&bytes](const Entry& e) { return e.aid_ == bytes; });
+    if (it == staged_.end()) {
+        return false;
+    }
+    staged_.erase(it);
+    return true;
+}
+
+bool SoftNfcc::ClearRouting()
+{
+    staged_.clear();
+    return true;
+}
+
+bool SoftNfcc::CommitRouting()
+{
+    committed_ = staged_;
+    ++commits_;
+    return true;
+}
+
+int SoftNfcc::GetRemainRoutingTableSize()
+{
+    return GetAidRoutingTableSize() - GetStagedBytes();
+}
+
+int SoftNfcc::GetAidRoutingTableSize()
+{
+    return std::max(config_.capacity_ - config_.techProtoBytes_, 0);
+}
+
+int SoftNfcc::GetDefaultRoute()
+{
+    return config_.defaultRoute_;
+}
+
+int SoftNfcc::GetDefaultOffHostRoute()
+{
+    return config_.defaultOffHostRoute_;
+}
+
+std::vector<int> SoftNfcc::GetOffHostUiccRoute()
+{
+    return config_.uiccRoutes_;
+}
+
+std::vector<int> SoftNfcc::GetOffHostEseRoute()
+{
+    return config_.eseRoutes_;
+}
+
+int SoftNfcc::GetAidMatchingMode()
+{
+    return config_.matchingMode_;
+}
+
+int SoftNfcc::GetDefaultIsoDepRouteDestination()
+{
+    return config_.defaultRoute_;
+}
+
+bool SoftNfcc::GetExtendedLengthApdusSupported()
+{
+    return config_.extendedLengthApdus_;
+}
+
+bool SoftNfcc::SendData(std::vector<unsigned char> data)
+{
+    lastSentData_ = std::move(data);
+    return true;
+}
+
+bool SoftNfcc::DumpRoutingTable(int fd)
+{
+    dprintf(fd, "soft nfcc, capacity: %d, committed: %d bytes\n", GetAidRoutingTableSize(), GetCommittedBytes());
+    for (auto& entry : committed_) {
+        dprintf(fd, "  route: 0x%02X, power: 0x%02X, pattern: 0x%02X, aid: %s\n",
+                entry.route_, entry.powerState_, entry.aidInfo_, BytesToHexStr(entry.aid_).c_str());
+    }
+    return true;
+}
+
+bool SoftNfcc::PostTask(std::function<void()> task, int64_t delayMs)
+{
+    return false;
+}
+
+bool SoftNfcc::IsNfcEnabled()
+{
+    return true;
+}
+
+int SoftNfcc::Resolve(const std::vector<unsigned char>& aid, uint8_t powerState) const
+{
+    for (auto& entry : committed_) {
+        if ((entry.powerState_ & powerState) == 0) {
+            continue;
+        }
+        bool matched = false;
+        if (entry.aidInfo_ == AidTypeToInt(AidType::EXACT)) {
+            matched = (entry.aid_ == aid);
+        } else if (entry.aidInfo_ == AidTypeToInt(AidType::PREFIX)) {
+            matched = entry.aid_.size() <= aid.size() && std::equal(entry.aid_.begin(), entry.aid_.end(), aid.begin());
+        } else if (entry.aidInfo_ == AidTypeToInt(AidType::SUBSET)) {
+            // the selected aid is the beginning of the entry
+            matched = !aid.empty() && aid.size() <= entry.aid_.size() &&
+                      std::equal(aid.begin(), aid.end(), entry.aid_.begin());
+        }
+        if (matched) {
+            return entry.route_;
+        }
+    }
+    return NOT_ROUTED;
+}
+
+const std::vector<SoftNfcc::Entry>& SoftNfcc::GetCommittedEntries() const
+{
+    return committed_;
+}
+
+std::vector<unsigned char> SoftNfcc::GetCommittedTable() const
+{
+    std::vector<unsigned char> table;
+    table.reserve(static_cast<size_t>(GetCommittedBytes()));
+    for (auto& entry : committed_) {
+        // type, length, route, power state, aid
+        table.push_back(AID_QUALIFIER_TYPE | static_cast<unsigned char>(entry.aidInfo_));
+        table.push_back(static_cast<unsigned char>(entry.aid_.size() + 2));
+        table.push_back(static_cast<unsigned char>(entry.route_));
+        table.push_back(entry.powerState_);
+        table.insert(table.end(), entry.aid_.begin(), entry.aid_.end());
+    }
+    return table;
+}
+
+int SoftNfcc::GetCommittedBytes() const
+{
+    int bytes = 0;
+    for (auto& entry : committed_) {
+        bytes += GetEntryCost(entry.aid_.size());
+    }
+    return bytes;
+}
+
+size_t SoftNfcc::GetRejectedCount() const
+{
+    return rejected_;
+}
+
+size_t SoftNfcc::GetCommitCount() const
+{
+    return commits_;
+}
+
+const std::vector<unsigned char>& SoftNfcc::GetLastSentData() const
+{
+    return lastSentData_;
+}
+
+int SoftNfcc::GetEntryCost(size_t aidLength)
+{
+    return AID_HEAD_LENGTH + static_cast<int>(aidLength);
+}
+
+bool SoftNfcc::IsKnownRoute(int route) const
+{
+    if (route == config_.defaultRoute_ || route == config_.defaultOffHostRoute_) {
+        return true;
+    }
+    return std::find(config_.eseRoutes_.begin(), config_.eseRoutes_.end(), route) != config_.eseRoutes_.end() ||
+           std::find(config_.uiccRoutes_.begin(), config_.uiccRoutes_.end(), route) != config_.uiccRoutes_.end();
+}
+
+bool SoftNfcc::IsSupportedAid(size_t aidLength, int aidInfo) const
+{
+    if (aidLength > AID_MAX_LENGTH_IN_BYTES) {
+        return false;
+    }
+    if (aidInfo == AidTypeToInt(AidType::EXACT)) {
+        return aidLength > 0;
+    }
+    if (aidInfo == AidTypeToInt(AidType::PREFIX)) {
+        // the empty aid is the default aid route, accepted in every matching mode
+        return aidLength == 0 || IsAidPrefixMode(config_.matchingMode_);
+    }
+    if (aidInfo == AidTypeToInt(AidType::SUBSET)) {
+        return aidLength > 0 && IsAidSubsetMode(config_.matchingMode_);
+    }
+    return false;
+}
+
+int SoftNfcc::GetStagedBytes() const
+{
+    int bytes = 0;
+    for (auto& entry : staged_) {
+        bytes += GetEntryCost(entry.aid_.size());
+    }
+    return bytes;
+}
+}  // namespace test
+}  // namespace OHOS::nfc::cardemulation
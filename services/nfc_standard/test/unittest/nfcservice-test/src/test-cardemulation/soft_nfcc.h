@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SERVICE_CARD_EMULATION_TEST_SOFT_NFCC_H
+#define SERVICE_CARD_EMULATION_TEST_SOFT_NFCC_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "card_emulation_def.h"
+#include "icard_emulation_device_host.h"
+
+namespace OHOS::nfc::cardemulation {
+namespace test {
+// power state bits of a listen mode routing entry, NCI 2.0
+constexpr uint8_t POWER_SWITCHED_ON = 0x01;
+constexpr uint8_t POWER_SWITCHED_OFF = 0x02;
+constexpr uint8_t POWER_BATTERY_OFF = 0x04;
+constexpr uint8_t POWER_SCREEN_OFF_UNLOCKED = 0x08;
+constexpr uint8_t POWER_SCREEN_ON_LOCKED = 0x10;
+constexpr uint8_t POWER_SCREEN_OFF_LOCKED = 0x20;
+
+class SoftNfccConfig final {
+public:
+    // bytes of the listen mode routing table
+    int capacity_{0x200};
+    // bytes of the technology and protocol entries, not available for aids
+    int techProtoBytes_{0};
+    // AID_ROUTING_MODE_MASK_PREFIX | AID_ROUTING_MODE_MASK_SUBSET, 0 for exact only
+    int matchingMode_{AID_ROUTING_MODE_MASK_PREFIX};
+    int defaultRoute_{0};
+    int defaultOffHostRoute_{2};
+    std::vector<int> uiccRoutes_{};
+    std::vector<int> eseRoutes_{2};
+    // the power states NciBalCe gives the entries
+    uint8_t hostPowerState_{0x11};
+    uint8_t offHostPowerState_{0x01};
+    bool secure_{false};
+    bool extendedLengthApdus_{false};
+};
+
+/*
+ * In-process model of the aid part of the listen mode routing table of a
+ * NFCC. The entries are staged by AddAidRouting/RemoveAidRouting/ClearRouting
+ * like the NFA does, each costs AID_HEAD_LENGTH bytes plus the aid, and only
+ * reach the controller on CommitRouting. SELECTs are resolved against the
+ * committed table: the first entry in table order matching the aid and the
+ * power state wins.
+ */
+class SoftNfcc final : public ICardEmulationDeviceHost {
+public:
+    static constexpr int NOT_ROUTED = -1;
+    class Entry final {
+    public:
+        std::vector<unsigned char> aid_;
+        int route_;
+        // AidTypeToInt of the aid type
+        int aidInfo_;
+        uint8_t powerState_;
+    };
+
+    explicit SoftNfcc(const SoftNfccConfig& config = SoftNfccConfig());
+    ~SoftNfcc() override = default;
+
+    bool AddAidRouting(std::string aid, int route, int aidInfo) override;
+    bool RemoveAidRouting(const std::string& aid) override;
+    bool ClearRouting() override;
+    bool CommitRouting() override;
+    int GetRemainRoutingTableSize() override;
+    int GetAidRoutingTableSize() override;
+    int GetDefaultRoute() override;
+    int GetDefaultOffHostRoute() override;
+    std::vector<int> GetOffHostUiccRoute() override;
+    std::vector<int> GetOffHostEseRoute() override;
+    int GetAidMatchingMode() override;
+    int GetDefaultIsoDepRouteDestination() override;
+    bool GetExtendedLengthApdusSupported() override;
+    bool SendData(std::vector<unsigned char> data) override;
+    bool DumpRoutingTable(int fd) override;
+    // there is no handler, the callers run the task at once
+    bool PostTask(std::function<void()> task, int64_t delayMs) override;
+    bool IsNfcEnabled() override;
+
+    /**
+     * brief: the route the controller sends a SELECT to
+     * parameter:
+     *   aid -- aid of the SELECT
+     *   powerState -- one of the POWER_* bits
+     * return: route of the first matching committed entry, NOT_ROUTED when none matches
+     */
+    int Resolve(const std::vector<unsigned char>& aid, uint8_t powerState = POWER_SWITCHED_ON) const;
+    const std::vector<Entry>& GetCommittedEntries() const;
+    // the committed entries as routing entries of RF_SET_LISTEN_MODE_ROUTING_CMD
+    std::vector<unsigned char> GetCommittedTable() const;
+    // bytes of the committed aid entries
+    int GetCommittedBytes() const;
+    // entries refused for capacity, matching mode or route
+    size_t GetRejectedCount() const;
+    size_t GetCommitCount() const;
+    const std::vector<unsigned char>& GetLastSentData() const;
+
+private:
+    static int GetEntryCost(size_t aidLength);
+    bool IsKnownRoute(int route) const;
+    bool IsSupportedAid(size_t aidLength, int aidInfo) const;
+    int GetStagedBytes() const;
+
+private:
+    SoftNfccConfig config_;
+    std::vector<Entry> staged_;
+    std::vector<Entry> committed_;
+    size_t rejected_;
+    size_t commits_;
+    std::vector<unsigned char> lastSentData_;
+};
+}  // namespace test
+}  // namespace OHOS::nfc::cardemulation
+#endif  // !SERVICE_CARD_EMULATION_TEST_SOFT_NFCC_H
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "soft_nfcc.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "aid_routing_adapter.h"
+#include "aid_routing_planner.h"
+#include "aid_routing_policy_factory.h"
+#include "aid_set.h"
+#include "aid_string.h"
+#include "card_emulation_error.h"
+#include "card_emulation_service_info.h"
+#include "card_emulation_util.h"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+namespace OHOS::nfc::cardemulation::test {
+static const std::string kSecureType = "secure";
+static const std::string kNormalType = "other";
+static const std::vector<std::string> kSupportedLocations = {"host", "eSE1"};
+
+// host and off host services in turn, without conflicts, four aids and a prefix aid each
+static std::vector<std::shared_ptr<CardEmulationServiceInfo>> CreateServices(size_t count, size_t aidsPerService)
+{
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> infos;
+    for (size_t i = 0; i < count; i++) {
+        bool offHost = (i % 2) != 0;
+        std::vector<std::string> aids;
+        for (size_t j = 0; j < aidsPerService; j++) {
+            std::stringstream ss;
+            ss << "A0000000" << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << i
+               << std::setw(2) << std::setfill('0') << j;
+            aids.push_back(ss.str());
+        }
+        std::stringstream prefix;
+        prefix << "B000000000" << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << i << "*";
+        aids.push_back(prefix.str());
+        auto aidset = AidSet::FromRawString(aids);
+        aidset->SetType(kNormalType);
+        auto info = std::make_shared<CardEmulationServiceInfo>(offHost ? "eSE1" : "host");
+        info->SetName(Util::CreateElementName("ability" + std::to_string(i)));
+        info->AddAidset(std::move(aidset));
+        infos.push_back(info);
+    }
+    return infos;
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : planning throughput and table fill against the soft nfcc, the programmed aids resolve to their services
+*/
+TEST(SoftNfcc, benchmark_planner)
+{
+    constexpr size_t serviceCount = 100;
+    constexpr size_t aidsPerService = 4;
+    constexpr int rounds = 20;
+    SoftNfccConfig config;
+    auto nfcc = std::make_shared<SoftNfcc>(config);
+    auto controller = std::make_shared<AidRoutingAdapter>(nfcc);
+    auto policy = RoutingPolicyFactory().CreateRoutingPolicy(
+        kSupportedLocations, controller->GetAidRoutingMode(), kSecureType);
+    AidRoutingPlanner planner(std::move(policy), controller);
+    auto infos = CreateServices(serviceCount, aidsPerService);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        EXPECT_EQ(ERR_OK, planner.OnCeServiceChanged(infos, nullptr, nullptr));
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(nfcc->GetCommitCount(), static_cast<size_t>(rounds));
+    EXPECT_EQ(nfcc->GetRejectedCount(), 0u);
+
+    int committed = nfcc->GetCommittedBytes();
+    EXPECT_LE(committed, nfcc->GetAidRoutingTableSize());
+    EXPECT_EQ(nfcc->GetCommittedTable().size(), static_cast<size_t>(committed));
+    printf("services: %zu, aids: %zu, plan: %lld us, entries: %zu, fill: %d / %d bytes (%.1f%%)\n",
+           serviceCount,
+           serviceCount * (aidsPerService + 1),
+           static_cast<long long>(elapsed.count() / rounds),
+           nfcc->GetCommittedEntries().size(),
+           committed,
+           nfcc->GetAidRoutingTableSize(),
+           committed * 100.0 / nfcc->GetAidRoutingTableSize());
+
+    // conformance, the controller sends every SELECT where the planner resolves its service,
+    // the aids of the evicted services go to the default route
+    size_t routed = 0;
+    for (size_t i = 0; i < serviceCount; i++) {
+        std::stringstream ss;
+        ss << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << i;
+        std::vector<std::string> selects{"A0000000" + ss.str() + "00", "B000000000" + ss.str()};
+        for (auto& select : selects) {
+            auto services = planner.GetCardEmulationServicesByAid(select);
+            int expected = config.defaultRoute_;
+            if (!services.empty()) {
+                auto owner = services[0].first.lock();
+                ASSERT_TRUE(owner != nullptr);
+                expected = controller->LocationStringToInt(owner->GetExecutionEnvironment());
+                ++routed;
+            }
+            EXPECT_EQ(nfcc->Resolve(HexStrToBytes(select)), expected) << select;
+        }
+    }
+    EXPECT_GT(routed, 0u);
+}
+}  // namespace OHOS::nfc::cardemulation::test
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "soft_nfcc.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "aid_string.h"
+#include "card_emulation_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+namespace OHOS::nfc::cardemulation::test {
+static constexpr int kHost = 0;
+static constexpr int kEse = 2;
+
+static std::string Raw(const std::string& hex)
+{
+    auto bytes = HexStrToBytes(hex);
+    return std::string(bytes.begin(), bytes.end());
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : every entry costs its aid and AID_HEAD_LENGTH bytes, the table refuses entries above the capacity
+*/
+TEST(SoftNfcc, capacity)
+{
+    SoftNfccConfig config;
+    config.capacity_ = 0x30;
+    config.techProtoBytes_ = 0x10;
+    SoftNfcc nfcc(config);
+    EXPECT_EQ(nfcc.GetAidRoutingTableSize(), 0x20);
+    EXPECT_EQ(nfcc.GetRemainRoutingTableSize(), 0x20);
+
+    // 16 + 4 bytes
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("A0000000031010A0000000031010A000"), kHost, AidTypeToInt(AidType::EXACT)));
+    // 5 + 4 bytes
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("A000000004"), kEse, AidTypeToInt(AidType::EXACT)));
+    EXPECT_EQ(nfcc.GetRemainRoutingTableSize(), 3);
+    EXPECT_FALSE(nfcc.AddAidRouting(std::string(), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_EQ(nfcc.GetRejectedCount(), 1u);
+
+    // routed again, not counted twice
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("A000000004"), kHost, AidTypeToInt(AidType::EXACT)));
+    EXPECT_EQ(nfcc.GetRemainRoutingTableSize(), 3);
+    EXPECT_TRUE(nfcc.RemoveAidRouting(Raw("A000000004")));
+    EXPECT_FALSE(nfcc.RemoveAidRouting(Raw("A000000004")));
+    EXPECT_TRUE(nfcc.AddAidRouting(std::string(), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_EQ(nfcc.GetRemainRoutingTableSize(), 8);
+
+    // staged entries take effect on commit
+    EXPECT_EQ(nfcc.GetCommittedBytes(), 0);
+    EXPECT_TRUE(nfcc.CommitRouting());
+    EXPECT_EQ(nfcc.GetCommittedBytes(), 24);
+    EXPECT_EQ(nfcc.GetCommittedTable().size(), 24u);
+    EXPECT_TRUE(nfcc.ClearRouting());
+    EXPECT_EQ(nfcc.GetRemainRoutingTableSize(), 0x20);
+    EXPECT_EQ(nfcc.GetCommittedEntries().size(), 2u);
+
+    // unknown route, aid above 16 bytes
+    EXPECT_FALSE(nfcc.AddAidRouting(Raw("A000000004"), 0x55, AidTypeToInt(AidType::EXACT)));
+    EXPECT_FALSE(
+        nfcc.AddAidRouting(Raw("A0000000031010A0000000031010A00000"), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_EQ(nfcc.GetRejectedCount(), 3u);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : prefix and subset entries need the matching mode, the default aid route is always accepted
+*/
+TEST(SoftNfcc, matching_mode)
+{
+    SoftNfccConfig config;
+    config.matchingMode_ = 0;
+    SoftNfcc exactOnly(config);
+    EXPECT_TRUE(exactOnly.AddAidRouting(Raw("A000000004"), kHost, AidTypeToInt(AidType::EXACT)));
+    EXPECT_FALSE(exactOnly.AddAidRouting(Raw("A000000005"), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_FALSE(exactOnly.AddAidRouting(Raw("A000000006"), kHost, AidTypeToInt(AidType::SUBSET)));
+    EXPECT_FALSE(exactOnly.AddAidRouting(std::string(), kHost, AidTypeToInt(AidType::EXACT)));
+    EXPECT_TRUE(exactOnly.AddAidRouting(std::string(), kHost, AidTypeToInt(AidType::PREFIX)));
+
+    config.matchingMode_ = AID_ROUTING_MODE_MASK_PREFIX | AID_ROUTING_MODE_MASK_SUBSET;
+    SoftNfcc all(config);
+    EXPECT_TRUE(all.AddAidRouting(Raw("A000000005"), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_TRUE(all.AddAidRouting(Raw("A000000006"), kHost, AidTypeToInt(AidType::SUBSET)));
+    EXPECT_EQ(all.GetRejectedCount(), 0u);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : a SELECT is routed by the first matching entry of the committed table
+*/
+TEST(SoftNfcc, resolve)
+{
+    SoftNfccConfig config;
+    config.matchingMode_ = AID_ROUTING_MODE_MASK_PREFIX | AID_ROUTING_MODE_MASK_SUBSET;
+    SoftNfcc nfcc(config);
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("A0000000031010"), kEse, AidTypeToInt(AidType::EXACT)));
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("A000000003"), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("F0010203040506"), kEse, AidTypeToInt(AidType::SUBSET)));
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("A0000000031010")), SoftNfcc::NOT_ROUTED);
+    EXPECT_TRUE(nfcc.CommitRouting());
+
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("A0000000031010")), kEse);
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("A0000000032010")), kHost);
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("A000000003")), kHost);
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("F00102")), kEse);
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("F0010203040506")), kEse);
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("F001020304050607")), SoftNfcc::NOT_ROUTED);
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("B000000003")), SoftNfcc::NOT_ROUTED);
+
+    // the default aid route catches the rest
+    EXPECT_TRUE(nfcc.AddAidRouting(std::string(), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_TRUE(nfcc.CommitRouting());
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("B000000003")), kHost);
+    EXPECT_EQ(nfcc.GetCommitCount(), 2u);
+
+    // table order, the prefix entry hides the exact one behind it
+    nfcc.ClearRouting();
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("A000000003"), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("A0000000031010"), kEse, AidTypeToInt(AidType::EXACT)));
+    EXPECT_TRUE(nfcc.CommitRouting());
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("A0000000031010")), kHost);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the entries are matched in the power states NciBalCe gives them
+*/
+TEST(SoftNfcc, power_state)
+{
+    SoftNfccConfig config;
+    SoftNfcc nfcc(config);
+    EXPECT_TRUE(nfcc.AddAidRouting(Raw("A000000004"), kEse, AidTypeToInt(AidType::EXACT)));
+    EXPECT_TRUE(nfcc.AddAidRouting(std::string(), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_TRUE(nfcc.CommitRouting());
+    EXPECT_EQ(nfcc.GetCommittedEntries()[0].powerState_, config.offHostPowerState_);
+    EXPECT_EQ(nfcc.GetCommittedEntries()[1].powerState_, config.hostPowerState_);
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("A000000004"), POWER_SWITCHED_ON), kEse);
+    // the off host entry is not active with the screen locked, the default route takes the SELECT
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("A000000004"), POWER_SCREEN_ON_LOCKED), kHost);
+    EXPECT_EQ(nfcc.Resolve(HexStrToBytes("A000000004"), POWER_SWITCHED_OFF), SoftNfcc::NOT_ROUTED);
+
+    config.secure_ = true;
+    SoftNfcc secure(config);
+    EXPECT_TRUE(secure.AddAidRouting(std::string(), kHost, AidTypeToInt(AidType::PREFIX)));
+    EXPECT_TRUE(secure.CommitRouting());
+    EXPECT_EQ(secure.GetCommittedEntries()[0].powerState_, POWER_SWITCHED_ON);
+    EXPECT_EQ(secure.Resolve(HexStrToBytes("A000000004"), POWER_SCREEN_ON_LOCKED), SoftNfcc::NOT_ROUTED);
+
+    // type, length, route, power state, aid
+    auto table = secure.GetCommittedTable();
+    std::vector<unsigned char> expected{0x12, 0x02, kHost, POWER_SWITCHED_ON};
+    EXPECT_EQ(table, expected);
+}
+}  // namespace OHOS::nfc::cardemulation::test
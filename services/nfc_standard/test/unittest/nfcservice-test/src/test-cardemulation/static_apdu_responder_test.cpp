@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "static_apdu_responder.h"
+
+#include <gtest/gtest.h>
+
+#include "aid_set.h"
+#include "card_emulation_def.h"
+#include "card_emulation_error.h"
+#include "card_emulation_service_info.h"
+#include "card_emulation_util.h"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+using namespace OHOS::nfc::sdk::cardemulation;
+namespace OHOS::nfc::cardemulation::test {
+static const std::string kNormalType = CARDEMULATION_SERVICE_TYPE_NORMAL;
+static const std::string kSecureType = CARDEMULATION_SERVICE_TYPE_SECURE;
+
+// SELECT 2PAY.SYS.DDF01, with any Le
+static StaticApduResponse SelectPpse()
+{
+    return StaticApduResponse{HexStrToBytes("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"),
+                              HexStrToBytes("00A404000E325041592E5359532E4444463031"),
+                              HexStrToBytes("6F0B840E325041592E5359532E44444630319000")};
+}
+
+// GET DATA of any tag
+static StaticApduResponse GetData()
+{
+    return StaticApduResponse{HexStrToBytes("FFFF"), HexStrToBytes("80CA"), HexStrToBytes("6A88")};
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : commands are answered by the first matching entry, the masked bytes are ignored
+*/
+TEST(StaticApduResponder, match)
+{
+    StaticApduResponder responder;
+    EXPECT_EQ(responder.Set(kNormalType, {SelectPpse(), GetData()}), ERR_OK);
+    EXPECT_EQ(responder.GetEntryCount(), 2u);
+
+    auto select = HexStrToBytes("00A404000E325041592E5359532E444446303100");
+    auto response = responder.Match(&select[0], select.size());
+    ASSERT_TRUE(response != nullptr);
+    EXPECT_EQ(*response, HexStrToBytes("6F0B840E325041592E5359532E44444630319000"));
+
+    auto getData = HexStrToBytes("80CA9F3600");
+    response = responder.Match(&getData[0], getData.size());
+    ASSERT_TRUE(response != nullptr);
+    EXPECT_EQ(*response, HexStrToBytes("6A88"));
+
+    auto other = HexStrToBytes("00B2010C00");
+    EXPECT_TRUE(responder.Match(&other[0], other.size()) == nullptr);
+    // shorter than the pattern
+    auto shortSelect = HexStrToBytes("00A40400");
+    EXPECT_TRUE(responder.Match(&shortSelect[0], shortSelect.size()) == nullptr);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : malformed entries and tables over the limits are rejected, the table is unchanged
+*/
+TEST(StaticApduResponder, limits)
+{
+    StaticApduResponder responder;
+    EXPECT_EQ(responder.Set(kNormalType, {GetData()}), ERR_OK);
+
+    StaticApduResponse noStatusWord{HexStrToBytes("FF"), HexStrToBytes("80"), HexStrToBytes("90")};
+    EXPECT_EQ(responder.Set(kNormalType, {noStatusWord}), ERR_INVALID_STATIC_RESPONSE);
+    StaticApduResponse maskMismatch{HexStrToBytes("FFFF"), HexStrToBytes("80"), HexStrToBytes("9000")};
+    EXPECT_EQ(responder.Set(kNormalType, {maskMismatch}), ERR_INVALID_STATIC_RESPONSE);
+
+    std::vector<StaticApduResponse> tooMany(StaticApduResponder::MAX_ENTRY_COUNT, GetData());
+    EXPECT_EQ(responder.Set(kSecureType, tooMany), ERR_INVALID_STATIC_RESPONSE);
+    StaticApduResponse tooLarge{HexStrToBytes("FF"),
+                                HexStrToBytes("80"),
+                                std::vector<unsigned char>(StaticApduResponder::MAX_TABLE_BYTES)};
+    EXPECT_EQ(responder.Set(kSecureType, {tooLarge}), ERR_INVALID_STATIC_RESPONSE);
+
+    EXPECT_EQ(responder.GetEntryCount(), 1u);
+    auto getData = HexStrToBytes("80CA9F3600");
+    EXPECT_TRUE(responder.Match(&getData[0], getData.size()) != nullptr);
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : the responses are per type, removing the aids of a type removes its responses
+*/
+TEST(StaticApduResponder, service_info)
+{
+    auto info = std::make_shared<CardEmulationServiceInfo>(NFC_EE_HOST);
+    info->SetName(Util::CreateElementName("app1"));
+    auto aids = AidSet::FromRawString({"325041592E5359532E4444463031"});
+    aids->SetType(kNormalType);
+    info->AddAidset(std::move(aids));
+    EXPECT_EQ(info->SetStaticResponses(kNormalType, {SelectPpse()}), ERR_OK);
+    EXPECT_EQ(info->SetStaticResponses(kSecureType, {GetData()}), ERR_OK);
+
+    auto select = HexStrToBytes("00A404000E325041592E5359532E444446303100");
+    std::vector<unsigned char> response;
+    EXPECT_TRUE(info->RespondStatically(&select[0], select.size(), response));
+    EXPECT_EQ(response, HexStrToBytes("6F0B840E325041592E5359532E44444630319000"));
+
+    info->RemoveAidset(kNormalType);
+    EXPECT_FALSE(info->RespondStatically(&select[0], select.size(), response));
+    auto getData = HexStrToBytes("80CA9F3600");
+    EXPECT_TRUE(info->RespondStatically(&getData[0], getData.size(), response));
+
+    // service updated
+    info->ClearStaticResponses();
+    EXPECT_FALSE(info->RespondStatically(&getData[0], getData.size(), response));
+}
+}  // namespace OHOS::nfc::cardemulation::test
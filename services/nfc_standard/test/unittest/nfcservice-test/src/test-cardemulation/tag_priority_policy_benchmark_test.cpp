@@ -0,0 +1,93 @@
+/*
+  * Copyright (C) 2021 Huawei Device Co., Ltd.
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  *     http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include "tag_priority_policy.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+#include "aid_set.h"
+#include "card_emulation_def.h"
+#include "card_emulation_service_info.h"
+#include "test_util.h"
+
+using namespace OHOS::nfc::cardemulation;
+using namespace OHOS::nfc::cardemulation::test;
+namespace OHOS::nfc::cardemulation::test {
+static std::string kSecureType = CARDEMULATION_SERVICE_TYPE_SECURE;
+static std::string kNormalType = CARDEMULATION_SERVICE_TYPE_NORMAL;
+static const std::vector<std::string> kSupportedLocations = {"host", "eSE1"};
+
+// synthetic population: every app owns one aidset of distinct aids, odd apps are routed to eSE1.
+static std::vector<std::shared_ptr<CardEmulationServiceInfo>> CreateSyntheticApps(size_t count, size_t aidsPerApp)
+{
+    std::vector<std::shared_ptr<CardEmulationServiceInfo>> apps;
+    apps.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        std::vector<std::string> aids;
+        for (size_t j = 0; j < aidsPerApp; j++) {
+            std::stringstream ss;
+            ss << "A0000000" << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << i
+               << std::setw(2) << std::setfill('0') << j;
+            aids.emplace_back(ss.str());
+        }
+        auto as = AidSet::FromRawString(aids);
+        as->SetType(kNormalType);
+
+        auto app = std::make_shared<CardEmulationServiceInfo>((i % 2 == 0) ? "host" : "eSE1");
+        app->SetName(Util::CreateElementName("app" + std::to_string(i)));
+        app->AddAidset(std::move(as));
+        apps.emplace_back(app);
+    }
+    return apps;
+}
+
+/**
+* @tc.number:
+* @tc.name  :
+* @tc.desc  : planning time for synthetic app populations
+*/
+TEST(TagPriorityPolicy, plan_benchmark_synthetic_population)
+{
+    constexpr size_t aidsPerApp = 4;
+    for (size_t count : {100u, 200u, 400u, 800u}) {
+        auto apps = CreateSyntheticApps(count, aidsPerApp);
+        // conflicts with every aid of the first app, must be denied
+        auto conflicting = AidSet::FromRawString({"A0000000000000*"});
+        conflicting->SetType(kNormalType);
+        auto offHost = std::make_shared<CardEmulationServiceInfo>("eSE1");
+        offHost->SetName(Util::CreateElementName("conflicting"));
+        offHost->AddAidset(std::move(conflicting));
+        apps.emplace_back(offHost);
+
+        TagPriorityPolicy policy(kSupportedLocations, AID_ROUTING_MODE_MASK_PREFIX, kSecureType);
+        auto start = std::chrono::steady_clock::now();
+        auto entries = policy.PlanRoutingTable(apps, nullptr, nullptr);
+        auto elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        printf("apps: %zu, aids: %zu, planning: %lld us\n",
+               count,
+               count * aidsPerApp,
+               static_cast<long long>(elapsed.count()));
+
+        ASSERT_EQ(entries.size(), count);
+        EXPECT_EQ(entries.back()->GetOwner().lock(), apps[count - 1]);
+    }
+}
+}  // namespace OHOS::nfc::cardemulation::test
@@ -15,6 +15,9 @@
 
 #include "test_util.h"
 
+#include <iomanip>
+#include <sstream>
+
 #include "element_name_util.h"
 
 namespace OHOS::nfc::cardemulation::test {
@@ -40,4 +43,27 @@ OHOS::AppExecFwk::ElementName Util::CreateEmptyElementName()
 {
     return OHOS::AppExecFwk::ElementName();
 }
+
+std::string Util::CreateServicesJson(size_t count, size_t aidsPerService)
+{
+    std::stringstream ss;
+    ss << "{\"abilities\": [";
+    for (size_t i = 0; i < count; i++) {
+        bool offHost = (i % 2) != 0;
+        ss << (i ? "," : "") << "{\"ability_name\": \"ability" << i << "\", \"bundle_name\": \"bundle" << i
+           << "\", \"ability_type\": \"" << (offHost ? "offhost_card_emulation" : "host_card_emulation")
+           << "\", \"aid_sets\": [{\"aids\": [";
+        for (size_t j = 0; j < aidsPerService; j++) {
+            ss << (j ? "," : "") << "\"A0000000" << std::uppercase << std::hex << std::setw(4) << std::setfill('0')
+               << i << std::setw(2) << std::setfill('0') << j << std::dec << "\"";
+        }
+        ss << ", \"B000000000" << std::setw(4) << std::setfill('0') << i << "*\"";
+        ss << "], \"description\": \"service " << i << "\", \"type\": \"" << (offHost ? "secure" : "normal")
+           << "\"}], \"environment\": \"" << (offHost ? "eSE1" : "host")
+           << "\", \"icon\": \"$icon\", \"label\": \"label" << i
+           << "\", \"unlock_device\": " << (offHost ? "true" : "false") << "}";
+    }
+    ss << "]}";
+    return ss.str();
+}
 }  // namespace OHOS::nfc::cardemulation::test
@@ -34,6 +34,8 @@ public:
                                                            std::string deviceId = "");
 
     static OHOS::AppExecFwk::ElementName CreateEmptyElementName();
+    // the layout of <user>_static.json, odd services are off host
+    static std::string CreateServicesJson(size_t count, size_t aidsPerService);
 };
 }  // namespace test
 }  // namespace OHOS::nfc::cardemulation
@@ -14,9 +14,14 @@
  */
 #include "access_control_enforcer.h"
 
+#include <chrono>
+#include <future>
+
 #include "access_rule_application_controller.h"
 #include "access_rule_cache.h"
+#include "access_rule_cache_store.h"
 #include "access_rule_files_controller.h"
+#include "apdu_filter_set.h"
 #include "bundle_manager.h"
 #include "channel_access_rule.h"
 #include "loghelper.h"
@@ -33,10 +38,20 @@ AccessControlEnforcer::AccessControlEnforcer(std::weak_ptr<Terminal> terminal)
       accessRuleApplicationController_(std::shared_ptr<AccessRuleApplicationController>()),
       accessRuleFilesController_(std::shared_ptr<AccessRuleFilesController>()),
       accessRuleCache_(std::make_shared<AccessRuleCache>()),
+      accessRuleCacheStore_(std::shared_ptr<AccessRuleCacheStore>()),
+      rulesChangedListener_(),
       noRuleFound_(false),
       hasAra_(true),
       hasArf_(true),
-      rulesRead_(false)
+      rulesRead_(false),
+      nfcEventDecisions_(),
+      channelAccessDecisions_(),
+      channelAccessDecisionStats_(),
+      decisionsRulesGeneration_(0),
+      certHashes_(),
+      refreshTagCheckIntervalMs_(REFRESH_TAG_CHECK_INTERVAL_MS),
+      lastRefreshTagCheck_(),
+      refreshTagCheckRequested_(true)
 {
 }
 
@@ -70,12 +85,38 @@ std::weak_ptr<AccessRuleCache> AccessControlEnforcer::GetAccessRuleCache()
     return accessRuleCache_;
 }
 
+void AccessControlEnforcer::SetAccessRuleCacheStore(std::shared_ptr<AccessRuleCacheStore> accessRuleCacheStore)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    accessRuleCacheStore_ = accessRuleCacheStore;
+}
+
+void AccessControlEnforcer::SetRulesChangedListener(RulesChangedListener listener)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    rulesChangedListener_ = listener;
+}
+
+std::shared_ptr<AccessRuleCacheStore> AccessControlEnforcer::GetAccessRuleCacheStore()
+{
+    if (!accessRuleCacheStore_) {
+        std::shared_ptr<Terminal> terminal = terminal_.lock();
+        if (!terminal) {
+            return accessRuleCacheStore_;
+        }
+        accessRuleCacheStore_ =
+            std::make_shared<AccessRuleCacheStore>(AccessRuleCacheStore::GetPath(terminal->GetName()));
+    }
+    return accessRuleCacheStore_;
+}
+
 void AccessControlEnforcer::Reset()
 {
     DebugLog("Reset access control enforcer");
     std::lock_guard<std::mutex> lock(mutex_);
     accessRuleCache_->SetRefreshTag("");
     accessRuleCache_->ClearAccessRules();
+    nfcEventDecisions_.clear();
     accessRuleApplicationController_ = std::shared_ptr<AccessRuleApplicationController>();
     accessRuleFilesController_ = std::shared_ptr<AccessRuleFilesController>();
 }
@@ -87,6 +128,18 @@ void AccessControlEnforcer::Initialize()
     hasAra_ = true;
     hasArf_ = true;
     noRuleFound_ = false;
+    nfcEventDecisions_.clear();
+    // the controllers read the refresh tag
+    lastRefreshTagCheck_ = std::chrono::steady_clock::now();
+    refreshTagCheckRequested_ = false;
+    // the rules of the last run are restored after boot or a reset of the SE, ARA or ARF re-reads them only when
+    // the refresh tag of the SE does not match
+    std::shared_ptr<AccessRuleCacheStore> accessRuleCacheStore = GetAccessRuleCacheStore();
+    bool restored = false;
+    if (accessRuleCacheStore && accessRuleCache_->GetRefreshTag().empty()) {
+        restored = accessRuleCacheStore->Load(*accessRuleCache_);
+    }
+    uint64_t generation = accessRuleCache_->GetGeneration();
     /*
      * Access Rule Application
      * When a device application attempts to access an SE application, the Access Control enforcer shall request
@@ -134,13 +187,21 @@ void AccessControlEnforcer::Initialize()
     }
     if (!hasAra_ && !hasArf_) {
         DebugLog("Neither ARA nor ARF, deny all access");
+        if (restored) {
+            // not confirmed by the SE
+            accessRuleCache_->SetRefreshTag("");
+            accessRuleCache_->ClearAccessRules();
+        }
         rulesRead_ = false;
+    } else {
+        StoreAccessRules(generation);
     }
     rulesRead_ = true;
 }
 
 bool AccessControlEnforcer::IsNoRuleFound()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     return noRuleFound_;
 }
 
@@ -163,22 +224,12 @@ void AccessControlEnforcer::CheckCommand(std::weak_ptr<OHOS::se::SeChannel> chan
         throw AccessControlError("Access not allowed");
     }
     if (channelAccessRule->HasApduFilter()) {
-        std::vector<std::string> apduFilters = channelAccessRule->GetApduFilters();
-        if (apduFilters.size() == 0) {
-            DebugLog("Access rule not match");
-            throw AccessControlError("Access rule not match");
-        }
-        for (std::string apduFilter : apduFilters) {
-            if (apduFilter.length() == 8) {
-                if ((((command[0] & 0xFF) & (apduFilter[4] & 0xFF)) == apduFilter[0]) &&
-                    (((command[1] & 0xFF) & (apduFilter[5] & 0xFF)) == apduFilter[1]) &&
-                    (((command[2] & 0xFF) & (apduFilter[6] & 0xFF)) == apduFilter[2]) &&
-                    (((command[3] & 0xFF) & (apduFilter[7] & 0xFF)) == apduFilter[3])) {
-                    DebugLog("Command matched apdu filter");
-                    return;
-                }
-            }
+        std::shared_ptr<const ApduFilterSet> apduFilterSet = sChannel->GetApduFilterSet();
+        if (apduFilterSet && apduFilterSet->Matches(command)) {
+            DebugLog("Command matched apdu filter");
+            return;
         }
+        DebugLog("Access rule not match");
         throw AccessControlError("Access rule not match");
     }
     if (channelAccessRule->GetApduAccessRule() != ChannelAccessRule::ACCESSRULE::ALWAYS) {
@@ -200,11 +251,26 @@ std::shared_ptr<ChannelAccessRule> AccessControlEnforcer::EstablishChannelAccess
             DebugLog("Bundle is null");
             throw AccessControlError("Bundle is null");
         }
-        std::vector<std::string> appCertHashes = this->GetHashesFromBundle(bundleName);
+        std::vector<std::string> signatures = this->GetSignaturesFromBundle(bundleName);
         if (checkRefreshTag) {
             this->CheckRefreshTag();
         }
-        channelAccessRule = this->GetAccessRule(aid, appCertHashes);
+        channelAccessRule = FindChannelAccessDecision(aid, bundleName, signatures);
+        if (!channelAccessRule) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            channelAccessRule = this->GetAccessRule(aid, this->GetHashesFromSignatures({bundleName}, {signatures})[0]);
+            if (rulesRead_) {
+                if (channelAccessDecisions_.find(bundleName) == channelAccessDecisions_.end() &&
+                    channelAccessDecisions_.size() >= MAX_CHANNEL_ACCESS_DECISION_BUNDLES) {
+                    channelAccessDecisions_.clear();
+                }
+                ChannelAccessDecision& decision = channelAccessDecisions_[bundleName][aid];
+                decision.signatures_ = signatures;
+                decision.channelAccessRule_ = std::make_shared<ChannelAccessRule>(*channelAccessRule);
+                decision.costUs_ = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+        }
     }
     if (!channelAccessRule) {
         DebugLog("No apdu access allowed");
@@ -217,8 +283,48 @@ std::shared_ptr<ChannelAccessRule> AccessControlEnforcer::EstablishChannelAccess
     return channelAccessRule;
 }
 
+// under mutex_, a copy of the decision, nullptr when it is not made yet
+std::shared_ptr<ChannelAccessRule> AccessControlEnforcer::FindChannelAccessDecision(
+    const std::string& aid, const std::string& bundleName, const std::vector<std::string>& signatures)
+{
+    SyncDecisionsWithRules();
+    std::map<std::string, std::map<std::string, ChannelAccessDecision>>::iterator bundleIter =
+        channelAccessDecisions_.find(bundleName);
+    if (bundleIter != channelAccessDecisions_.end()) {
+        std::map<std::string, ChannelAccessDecision>::iterator aidIter = bundleIter->second.find(aid);
+        if (aidIter != bundleIter->second.end()) {
+            if (aidIter->second.signatures_ == signatures) {
+                channelAccessDecisionStats_.hits_++;
+                channelAccessDecisionStats_.savedUs_ += aidIter->second.costUs_;
+                return std::make_shared<ChannelAccessRule>(*aidIter->second.channelAccessRule_);
+            }
+            DebugLog("Signatures of the bundle changed");
+            channelAccessDecisions_.erase(bundleIter);
+        }
+    }
+    channelAccessDecisionStats_.misses_++;
+    return std::shared_ptr<ChannelAccessRule>();
+}
+
+ChannelAccessDecisionStats AccessControlEnforcer::GetChannelAccessDecisionStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return channelAccessDecisionStats_;
+}
+
+// under mutex_, the decisions are made with the current rules only
+void AccessControlEnforcer::SyncDecisionsWithRules()
+{
+    if (decisionsRulesGeneration_ != accessRuleCache_->GetGeneration()) {
+        DebugLog("Access rules changed, clear the decisions");
+        nfcEventDecisions_.clear();
+        channelAccessDecisions_.clear();
+        decisionsRulesGeneration_ = accessRuleCache_->GetGeneration();
+    }
+}
+
 std::shared_ptr<ChannelAccessRule> AccessControlEnforcer::GetAccessRule(const std::string& aid,
-                                                                        std::vector<std::string> appCertHashes)
+                                                                        const std::vector<std::string>& appCertHashes)
 {
     DebugLog("AccessControlEnforcer::GetAccessRule");
     ChannelAccessRule channelAccessRule;
@@ -238,21 +344,58 @@ std::vector<bool> AccessControlEnforcer::IsNfcEventAllowed(const std::string& ai
 {
     DebugLog("AccessControlEnforcer::IsNfcEventAllowed");
     std::vector<bool> nfcEventAllowed;
-    if (hasAra_ || hasArf_) {
-        for (std::string bundleName : bundleNames) {
-            std::vector<std::string> appCertHashes = this->GetHashesFromBundle(bundleName);
-            std::shared_ptr<ChannelAccessRule> channelAccess = GetAccessRule(aid, appCertHashes);
-            nfcEventAllowed.push_back(
-                (channelAccess->GetNFCEventAccessRule() == ChannelAccessRule::ACCESSRULE::ALWAYS));
-        }
-    } else {
-        for (std::string bundleName : bundleNames) {
-            nfcEventAllowed.push_back(false);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!hasAra_ && !hasArf_) {
+        nfcEventAllowed.assign(bundleNames.size(), false);
+        return nfcEventAllowed;
+    }
+    SyncDecisionsWithRules();
+    // the signatures are looked up for every event, a bundle reinstalled with other signatures is decided again
+    std::vector<std::vector<std::string>> appCertHashes = this->GetHashesFromBundles(bundleNames);
+    if (nfcEventDecisions_.find(aid) == nfcEventDecisions_.end() &&
+        nfcEventDecisions_.size() >= MAX_NFC_EVENT_DECISION_AIDS) {
+        nfcEventDecisions_.clear();
+    }
+    std::map<std::string, NfcEventDecision>& decisions = nfcEventDecisions_[aid];
+    for (size_t i = 0; i < bundleNames.size(); i++) {
+        std::map<std::string, NfcEventDecision>::iterator iter = decisions.find(bundleNames[i]);
+        if (iter != decisions.end() && iter->second.hashes_ == appCertHashes[i]) {
+            nfcEventAllowed.push_back(iter->second.allowed_);
+            continue;
         }
+        std::shared_ptr<ChannelAccessRule> channelAccess = GetAccessRule(aid, appCertHashes[i]);
+        NfcEventDecision& decision = decisions[bundleNames[i]];
+        decision.hashes_ = appCertHashes[i];
+        decision.allowed_ = (channelAccess->GetNFCEventAccessRule() == ChannelAccessRule::ACCESSRULE::ALWAYS);
+        nfcEventAllowed.push_back(decision.allowed_);
     }
     return nfcEventAllowed;
 }
 
+void AccessControlEnforcer::ClearNfcEventDecisions()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    nfcEventDecisions_.clear();
+}
+
+void AccessControlEnforcer::OnBundleChanged(const std::string& bundleName)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bundleName.empty()) {
+        DebugLog("Unknown bundle changed, clear the decisions of all bundles");
+        certHashes_.clear();
+        channelAccessDecisions_.clear();
+        nfcEventDecisions_.clear();
+        return;
+    }
+    certHashes_.erase(bundleName);
+    channelAccessDecisions_.erase(bundleName);
+    for (std::map<std::string, std::map<std::string, NfcEventDecision>>::iterator iter = nfcEventDecisions_.begin();
+         iter != nfcEventDecisions_.end(); iter++) {
+        iter->second.erase(bundleName);
+    }
+}
+
 bool AccessControlEnforcer::CheckCarrierPrivilege(std::weak_ptr<osal::BundleInfo> bInfo, bool checkRefreshTag)
 {
     DebugLog("AccessControlEnforcer::CheckCarrierPrivilege");
@@ -285,6 +428,21 @@ bool AccessControlEnforcer::CheckCarrierPrivilege(std::weak_ptr<osal::BundleInfo
 std::vector<std::string> AccessControlEnforcer::GetHashesFromBundle(const std::string& bundleName)
 {
     DebugLog("AccessControlEnforcer::GetHashesFromBundle");
+    return GetHashesFromBundles({bundleName})[0];
+}
+
+std::vector<std::vector<std::string>> AccessControlEnforcer::GetHashesFromBundles(
+    const std::vector<std::string>& bundleNames)
+{
+    std::vector<std::vector<std::string>> signatures;
+    for (const std::string& bundleName : bundleNames) {
+        signatures.push_back(GetSignaturesFromBundle(bundleName));
+    }
+    return GetHashesFromSignatures(bundleNames, signatures);
+}
+
+std::vector<std::string> AccessControlEnforcer::GetSignaturesFromBundle(const std::string& bundleName)
+{
     if (bundleName.empty()) {
         DebugLog("Bundle name is empty");
         throw AccessControlError("Bundle name is null");
@@ -300,38 +458,148 @@ std::vector<std::string> AccessControlEnforcer::GetHashesFromBundle(const std::s
         DebugLog("Bundle info is empty");
         throw AccessControlError("Bundle info does not exist");
     }
-    std::vector<std::string> hashes;
-    for (std::string signature : bundleInfo->signatures_) {
-        // OpenSSL
-        // SHA-1
-        unsigned char hash1[SHA_DIGEST_LENGTH] = "";
-        SHA_CTX ctx1;
-        SHA1_Init(&ctx1);
-        SHA1_Update(&ctx1, signature.c_str(), signature.size());
-        SHA1_Final(hash1, &ctx1);
-        hashes.push_back(UnsignedCharArrayToString(hash1, SHA_DIGEST_LENGTH));
-        // SHA-256
-        unsigned char hash256[SHA256_DIGEST_LENGTH] = "";
-        SHA256_CTX ctx256;
-        SHA256_Init(&ctx256);
-        SHA256_Update(&ctx256, signature.c_str(), signature.size());
-        SHA256_Final(hash256, &ctx256);
-        hashes.push_back(UnsignedCharArrayToString(hash256, SHA256_DIGEST_LENGTH));
+    return bundleInfo->signatures_;
+}
+
+// under mutex_, the hashes of the signatures of each bundle, the cached ones are not computed again
+std::vector<std::vector<std::string>> AccessControlEnforcer::GetHashesFromSignatures(
+    const std::vector<std::string>& bundleNames, const std::vector<std::vector<std::string>>& signatures)
+{
+    std::vector<std::vector<std::string>> hashes(bundleNames.size());
+    // the bundles not in the cache and their signatures
+    std::vector<size_t> missedBundles;
+    std::vector<const std::string*> missedSignatures;
+    size_t missedBytes = 0;
+    for (size_t i = 0; i < bundleNames.size(); i++) {
+        std::map<std::string, CertHashes>::iterator iter = certHashes_.find(bundleNames[i]);
+        if (iter != certHashes_.end() && iter->second.signatures_ == signatures[i]) {
+            hashes[i] = iter->second.hashes_;
+            continue;
+        }
+        missedBundles.push_back(i);
+        for (const std::string& signature : signatures[i]) {
+            missedSignatures.push_back(&signature);
+            missedBytes += signature.size();
+        }
+    }
+    if (missedBundles.empty()) {
+        return hashes;
+    }
+
+    std::vector<std::vector<std::string>> signatureHashes(missedSignatures.size());
+    if (missedSignatures.size() > 1 && missedBytes >= PARALLEL_HASH_MIN_BYTES) {
+        std::vector<std::future<std::vector<std::string>>> futures;
+        for (size_t i = 1; i < missedSignatures.size(); i++) {
+            futures.push_back(std::async(std::launch::async, &AccessControlEnforcer::HashSignature,
+                                         std::cref(*missedSignatures[i])));
+        }
+        signatureHashes[0] = HashSignature(*missedSignatures[0]);
+        for (size_t i = 1; i < missedSignatures.size(); i++) {
+            signatureHashes[i] = futures[i - 1].get();
+        }
+    } else {
+        for (size_t i = 0; i < missedSignatures.size(); i++) {
+            signatureHashes[i] = HashSignature(*missedSignatures[i]);
+        }
+    }
+
+    size_t next = 0;
+    for (size_t i : missedBundles) {
+        for (size_t j = 0; j < signatures[i].size(); j++, next++) {
+            hashes[i].insert(hashes[i].end(), signatureHashes[next].begin(), signatureHashes[next].end());
+        }
+        if (certHashes_.find(bundleNames[i]) == certHashes_.end() && certHashes_.size() >= MAX_CERT_HASH_BUNDLES) {
+            certHashes_.clear();
+        }
+        CertHashes& certHashes = certHashes_[bundleNames[i]];
+        certHashes.signatures_ = signatures[i];
+        certHashes.hashes_ = hashes[i];
     }
     return hashes;
 }
 
+std::vector<std::string> AccessControlEnforcer::HashSignature(const std::string& signature)
+{
+    // OpenSSL
+    unsigned char hash1[SHA_DIGEST_LENGTH] = "";
+    SHA1(reinterpret_cast<const unsigned char*>(signature.data()), signature.size(), hash1);
+    unsigned char hash256[SHA256_DIGEST_LENGTH] = "";
+    SHA256(reinterpret_cast<const unsigned char*>(signature.data()), signature.size(), hash256);
+    return {UnsignedCharArrayToString(hash1, SHA_DIGEST_LENGTH),
+            UnsignedCharArrayToString(hash256, SHA256_DIGEST_LENGTH)};
+}
+
+void AccessControlEnforcer::SetRefreshTagCheckInterval(uint64_t intervalMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    refreshTagCheckIntervalMs_ = intervalMs;
+}
+
+void AccessControlEnforcer::RequestRefreshTagCheck()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    refreshTagCheckRequested_ = true;
+}
+
+bool AccessControlEnforcer::IsRefreshTagCheckDue()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return IsRefreshTagCheckDueLocked();
+}
+
+void AccessControlEnforcer::CheckRefreshTagIfDue()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!hasAra_ && !hasArf_) {
+        return;
+    }
+    CheckRefreshTag();
+}
+
+bool AccessControlEnforcer::IsRefreshTagCheckDueLocked()
+{
+    return refreshTagCheckRequested_ ||
+           std::chrono::steady_clock::now() - lastRefreshTagCheck_ >=
+               std::chrono::milliseconds(refreshTagCheckIntervalMs_);
+}
+
+// under mutex_, rate limited by the refresh tag check interval
 void AccessControlEnforcer::CheckRefreshTag()
 {
     DebugLog("AccessControlEnforcer::CheckRefreshTag");
+    if (!IsRefreshTagCheckDueLocked()) {
+        return;
+    }
+    lastRefreshTagCheck_ = std::chrono::steady_clock::now();
+    refreshTagCheckRequested_ = false;
+    uint64_t generation = accessRuleCache_->GetGeneration();
     if (hasAra_ && accessRuleApplicationController_) {
         accessRuleApplicationController_->Initialize();
         hasArf_ = false;
     } else if (hasArf_ && accessRuleFilesController_) {
         accessRuleFilesController_->Initialize();
     }
+    StoreAccessRules(generation);
 };
 
+void AccessControlEnforcer::StoreAccessRules(uint64_t generation)
+{
+    if (accessRuleCache_->GetGeneration() == generation) {
+        return;
+    }
+    if (rulesChangedListener_) {
+        rulesChangedListener_();
+    }
+    if (accessRuleCache_->GetRefreshTag().empty()) {
+        return;
+    }
+    std::shared_ptr<AccessRuleCacheStore> accessRuleCacheStore = GetAccessRuleCacheStore();
+    if (accessRuleCacheStore) {
+        DebugLog("Access rules re-read, update the snapshot");
+        accessRuleCacheStore->Store(*accessRuleCache_);
+    }
+}
+
 std::string AccessControlEnforcer::UnsignedCharArrayToString(const unsigned char* charArray, int length)
 {
     std::string result = "";
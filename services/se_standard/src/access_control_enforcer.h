@@ -15,6 +15,10 @@
 #ifndef ACCESS_CONTROL_ENFORCER_H
 #define ACCESS_CONTROL_ENFORCER_H
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -31,9 +35,22 @@ class SeChannel;
 class Terminal;
 namespace security {
 class AccessRuleCache;
+class AccessRuleCacheStore;
 class ChannelAccessRule;
 class AccessRuleApplicationController;
 class AccessRuleFilesController;
+// counters of the channel access decisions cache of an enforcer
+class ChannelAccessDecisionStats {
+public:
+    uint64_t hits_{0};
+    uint64_t misses_{0};
+    // the time the decisions served from the cache took to make, in microseconds
+    uint64_t savedUs_{0};
+    double GetHitRate() const
+    {
+        return (hits_ + misses_) == 0 ? 0 : static_cast<double>(hits_) / (hits_ + misses_);
+    }
+};
 /*
  * Software that is part of the Secure Element access API, it obtains access
  * rules from the Secure Element and applies those rules to restrict device
@@ -48,16 +65,46 @@ public:
     void SetBundleManager(std::weak_ptr<osal::BundleManager> bundleManager);
     std::weak_ptr<Terminal> GetTerminal();
     std::weak_ptr<AccessRuleCache> GetAccessRuleCache();
+    // where the rules are kept across reboots and resets of the SE, a file of the terminal by default
+    void SetAccessRuleCacheStore(std::shared_ptr<AccessRuleCacheStore> accessRuleCacheStore);
+    // called under the lock of the enforcer when the rules were re-read, it must not call back into the enforcer
+    using RulesChangedListener = std::function<void()>;
+    void SetRulesChangedListener(RulesChangedListener listener);
     void Reset();
     void Initialize();
     bool IsNoRuleFound();
     void CheckCommand(std::weak_ptr<OHOS::se::SeChannel> channel, const std::string& command);
+    /**
+     * @brief Establishes the channel access of the bundle to the SE application. The decisions are cached per
+     * bundle and AID while the signatures of the bundle and the rules are unchanged.
+     */
     std::shared_ptr<ChannelAccessRule> EstablishChannelAccessRuleForBundle(const std::string& aid,
                                                                            const std::string& bundleName,
                                                                            bool checkRefreshTag);
-    std::shared_ptr<ChannelAccessRule> GetAccessRule(const std::string& aid, std::vector<std::string> appCertHashes);
+    ChannelAccessDecisionStats GetChannelAccessDecisionStats();
+    std::shared_ptr<ChannelAccessRule> GetAccessRule(const std::string& aid,
+                                                     const std::vector<std::string>& appCertHashes);
+    /**
+     * @brief Checks the NFC event access of the bundles to the SE application. The decisions are cached per AID,
+     * bundle and the hashes of its signatures until the rules change.
+     */
     std::vector<bool> IsNfcEventAllowed(const std::string& aid, const std::vector<std::string>& bundleNames);
+    void ClearNfcEventDecisions();
+    // the bundle is updated or uninstalled, forget the hashes and the decisions of it, of all bundles if it is empty
+    void OnBundleChanged(const std::string& bundleName);
     bool CheckCarrierPrivilege(std::weak_ptr<osal::BundleInfo> pInfo, bool checkRefreshTag);
+    /**
+     * @brief The refresh tag is checked at most once per interval, unless a check is requested. The rules are
+     * re-read when the tag changed.
+     */
+    void SetRefreshTagCheckInterval(uint64_t intervalMs);
+    // the next check runs regardless of the interval, on a reset of the SE or a refresh asked by the user
+    void RequestRefreshTagCheck();
+    bool IsRefreshTagCheckDue();
+    // the ARA-M or the ARF is read under the lock of the enforcer, the channels to open wait for it
+    void CheckRefreshTagIfDue();
+
+    static const uint64_t REFRESH_TAG_CHECK_INTERVAL_MS{60 * 1000};
 
 private:
     std::mutex mutex_;
@@ -66,12 +113,63 @@ private:
     std::shared_ptr<AccessRuleApplicationController> accessRuleApplicationController_;
     std::shared_ptr<AccessRuleFilesController> accessRuleFilesController_;
     std::shared_ptr<AccessRuleCache> accessRuleCache_;
+    std::shared_ptr<AccessRuleCacheStore> accessRuleCacheStore_;
+    RulesChangedListener rulesChangedListener_;
     bool noRuleFound_;
     bool hasAra_;
     bool hasArf_;
     bool rulesRead_;
+    class NfcEventDecision {
+    public:
+        // the hashes of the signatures of the bundle the decision is made for
+        std::vector<std::string> hashes_;
+        bool allowed_;
+    };
+    // AID -> bundle name -> NFC event decision
+    std::map<std::string, std::map<std::string, NfcEventDecision>> nfcEventDecisions_;
+    class ChannelAccessDecision {
+    public:
+        // the signatures of the bundle the decision is made for
+        std::vector<std::string> signatures_;
+        std::shared_ptr<ChannelAccessRule> channelAccessRule_;
+        uint64_t costUs_;
+    };
+    // bundle name -> AID -> channel access
+    std::map<std::string, std::map<std::string, ChannelAccessDecision>> channelAccessDecisions_;
+    ChannelAccessDecisionStats channelAccessDecisionStats_;
+    // the generation of the access rule cache the decisions are made with
+    uint64_t decisionsRulesGeneration_;
+    static const size_t MAX_NFC_EVENT_DECISION_AIDS = 64;
+    static const size_t MAX_CHANNEL_ACCESS_DECISION_BUNDLES = 64;
+    class CertHashes {
+    public:
+        std::vector<std::string> signatures_;
+        // SHA-1 and SHA-256 of each signature
+        std::vector<std::string> hashes_;
+    };
+    // bundle name -> hashes of the signatures
+    std::map<std::string, CertHashes> certHashes_;
+    static const size_t MAX_CERT_HASH_BUNDLES = 64;
+    // below it starting a thread costs more than hashing the signatures
+    static const size_t PARALLEL_HASH_MIN_BYTES = 16 * 1024;
+    uint64_t refreshTagCheckIntervalMs_;
+    std::chrono::steady_clock::time_point lastRefreshTagCheck_;
+    bool refreshTagCheckRequested_;
+    void SyncDecisionsWithRules();
+    std::shared_ptr<ChannelAccessRule> FindChannelAccessDecision(const std::string& aid,
+                                                                 const std::string& bundleName,
+                                                                 const std::vector<std::string>& signatures);
+    std::vector<std::string> GetSignaturesFromBundle(const std::string& bundleName);
+    std::vector<std::vector<std::string>> GetHashesFromSignatures(
+        const std::vector<std::string>& bundleNames, const std::vector<std::vector<std::string>>& signatures);
+    std::vector<std::vector<std::string>> GetHashesFromBundles(const std::vector<std::string>& bundleNames);
     std::vector<std::string> GetHashesFromBundle(const std::string& bundleName);
+    static std::vector<std::string> HashSignature(const std::string& signature);
+    std::shared_ptr<AccessRuleCacheStore> GetAccessRuleCacheStore();
+    bool IsRefreshTagCheckDueLocked();
     void CheckRefreshTag();
+    // under mutex_, writes the snapshot and notifies the listener when the rules were re-read since the generation
+    void StoreAccessRules(uint64_t generation);
     static std::string UnsignedCharArrayToString(const unsigned char* charArray, int length);
 };
 }  // namespace security
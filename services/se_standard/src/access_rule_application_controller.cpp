@@ -132,18 +132,13 @@ std::vector<RefArDo> AccessRuleApplicationController::GetAllAccessRules(std::sha
 {
     InfoLog("AccessRuleApplicationController::GetAllAccessRules");
     // GET DATA [All]: Fetches the first bytes of the Response-ALL-AR-DO
-    std::string responseAll = this->GetDataAll(channel);
-    std::shared_ptr<BerTlv> bt = BerTlv::StrToBerTlv(responseAll);
-    int valueLength = bt->GetValue().length();
-    while (valueLength < bt->GetLength()) {
+    ResponseAllArDoAssembler assembler;
+    assembler.Append(this->GetDataAll(channel));
+    while (!assembler.IsComplete()) {
         // GET DATA [Next]: Fetches the next (succeeding) bytes of the Response-ALL-AR-DO
-        std::string responseNext = this->GetDataNext(channel);
-        responseAll += responseNext;
-        valueLength += responseNext.length();
+        assembler.Append(this->GetDataNext(channel));
     }
-    bt = BerTlv::StrToBerTlv(responseAll);
-    std::shared_ptr<ResponseAllArDo> raad = ResponseAllArDo::BerTlvToResponseAllArDo(bt);
-    return raad->GetRefArDoArray();
+    return assembler.GetRefArDoArray();
 }
 
 std::string AccessRuleApplicationController::GetDataRefreshTag(std::shared_ptr<OHOS::se::SeChannel> channel)
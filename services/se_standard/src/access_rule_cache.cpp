@@ -23,9 +23,55 @@
 #include "general-data-objects/pkg_ref_do.h"
 #include "general-data-objects/ref_do.h"
 #include "loghelper.h"
+#include "se_common_exception.h"
 
 namespace OHOS::se::security {
-AccessRuleCache::AccessRuleCache() : refreshTag_(""), accessRuleMap_({}), carrierPrivilegeCache_({}) {}
+// tags of the snapshot, private to the file
+static const int SNAPSHOT_TAG = 0xF0;
+static const int SNAPSHOT_RULE_TAG = 0xF1;
+static const int SNAPSHOT_CARRIER_PRIVILEGE_TAG = 0xF2;
+static const int SNAPSHOT_VERSION_TAG = 0x80;
+static const int SNAPSHOT_REFRESH_TAG_TAG = 0x81;
+static const int SNAPSHOT_ACCESS_TAG = 0x82;
+static const int SNAPSHOT_REASON_TAG = 0x83;
+static const int SNAPSHOT_APDU_FILTER_TAG = 0x84;
+// changed whenever the merging of the rules or the layout of the snapshot changes
+static const char SNAPSHOT_VERSION = 1;
+// access rule, apdu access rule, has apdu filter, nfc event access rule
+static const size_t SNAPSHOT_ACCESS_LENGTH = 4;
+static const size_t APDU_FILTER_LENGTH = 8;
+
+static std::string ToTlv(int tag, const std::string& value)
+{
+    return BerTlv(tag, value.length(), value).GetData();
+}
+
+// the children of a constructed BER-TLV
+static std::vector<std::shared_ptr<BerTlv>> ParseChildren(std::shared_ptr<BerTlv> berTlv)
+{
+    std::vector<std::shared_ptr<BerTlv>> children;
+    std::string value = berTlv->GetValue();
+    BerTlvReader reader(value);
+    while (!reader.IsEnd()) {
+        children.push_back(reader.ToBerTlv(reader.Next()));
+    }
+    return children;
+}
+
+static ChannelAccessRule::ACCESSRULE ToAccessRule(char value)
+{
+    if (value != ChannelAccessRule::ACCESSRULE::ALWAYS && value != ChannelAccessRule::ACCESSRULE::NEVER &&
+        value != ChannelAccessRule::ACCESSRULE::UNKNOWN) {
+        ErrorLog("Invalid access rule in snapshot");
+        throw AccessControlError("Parsing data error");
+    }
+    return static_cast<ChannelAccessRule::ACCESSRULE>(value);
+}
+
+AccessRuleCache::AccessRuleCache()
+    : refreshTag_(""), accessRuleMap_({}), carrierPrivilegeCache_({}), generation_(0), index_({}), indexGeneration_(0)
+{
+}
 
 AccessRuleCache::~AccessRuleCache()
 {
@@ -48,9 +94,20 @@ void AccessRuleCache::SetRefreshTag(const std::string& refreshTag)
     refreshTag_ = refreshTag;
 }
 
+std::string AccessRuleCache::GetRefreshTag()
+{
+    return refreshTag_;
+}
+
+uint64_t AccessRuleCache::GetGeneration() const
+{
+    return generation_;
+}
+
 void AccessRuleCache::ClearAccessRules()
 {
     DebugLog("AccessRuleCache::ClearAccessRules");
+    ++generation_;
     accessRuleMap_.clear();
     carrierPrivilegeCache_.clear();
 }
@@ -58,6 +115,7 @@ void AccessRuleCache::ClearAccessRules()
 void AccessRuleCache::AddAccessRule(std::shared_ptr<RefDo> refDo, ChannelAccessRule channelAccessRule)
 {
     DebugLog("AccessRuleCache::AddAccessRule");
+    ++generation_;
     if (CARRIER_PRIVILEGE_AID == refDo->GetAidRefDo()->GetAid()) {
         carrierPrivilegeCache_.push_back(*refDo);
         return;
@@ -145,7 +203,7 @@ void AccessRuleCache::AddAccessRule(std::shared_ptr<RefDo> refDo, std::shared_pt
     this->AddAccessRule(refDo, channelAccessRule);
 }
 
-ChannelAccessRule AccessRuleCache::GetAccessRule(const std::string& aid, std::vector<std::string> hashes)
+ChannelAccessRule AccessRuleCache::GetAccessRule(const std::string& aid, const std::vector<std::string>& hashes)
 {
     DebugLog("AccessRuleCache::GetAccessRule");
     ChannelAccessRule channelAccessRule = this->GetAccessRuleWithUnknown(aid, hashes);
@@ -184,93 +242,171 @@ bool AccessRuleCache::CheckCarrierPrivilege(std::string bundleName, std::vector<
     return false;
 }
 
-ChannelAccessRule AccessRuleCache::GetAccessRuleWithUnknown(const std::string& aid, std::vector<std::string> hashes)
+ChannelAccessRule AccessRuleCache::GetAccessRuleWithUnknown(const std::string& aid,
+                                                            const std::vector<std::string>& hashes)
 {
     DebugLog("AccessRuleCache::GetAccessRule");
-    // Secure Element Access Control – Public Release v1.0, 4.2.3 Algorithm for Applying Rules
-    std::shared_ptr<AidRefDo> aidRefDo;
-    std::shared_ptr<HashRefDo> hashRefDo;
-    std::shared_ptr<RefDo> refDo;
-    std::map<RefDo, ChannelAccessRule>::iterator iter;
     if (hashes.size() == 0) {
         DebugLog("Application certificates do not exist.");
         return ChannelAccessRule();
     }
-    for (std::string hash : hashes) {
-        aidRefDo = AidRefDo::AidToAidRefDo(aid);
-        hashRefDo = std::make_shared<HashRefDo>(hash);
-        refDo = std::make_shared<RefDo>(aidRefDo, hashRefDo);
-        iter = accessRuleMap_.find(*refDo);
-        if (iter != accessRuleMap_.end()) {
-            DebugLog("Find the access rule by the given aid and hash");
-            return iter->second;
-        }
+    if (indexGeneration_ != generation_) {
+        BuildIndex();
+    }
+    ChannelAccessRule* channelAccessRule = FindAccessRule(aid, hashes);
+    if (!channelAccessRule) {
+        DebugLog("No rule found");
+        return ChannelAccessRule();
     }
-    DebugLog("No rule found by the given aid and the given hash");
+    return *channelAccessRule;
+}
 
-    for (iter = accessRuleMap_.begin(); iter != accessRuleMap_.end(); iter++) {
-        RefDo arRefDo = iter->first;
-        std::string arAid = arRefDo.GetAidRefDo()->GetAid();
-        std::string arHash = arRefDo.GetHashRefDo()->GetHash();
-        if (aid == arAid && arHash.length() > 0) {
+ChannelAccessRule* AccessRuleCache::FindAccessRule(const std::string& aid, const std::vector<std::string>& hashes)
+{
+    // Secure Element Access Control – Public Release v1.0, 4.2.3 Algorithm for Applying Rules
+    static ChannelAccessRule specificRulesHavePriority = []() {
+        ChannelAccessRule channelAccessRule = ChannelAccessRule();
+        channelAccessRule.SetAccessRule(ChannelAccessRule::ACCESSRULE::NEVER, "Specific rules have priority.");
+        channelAccessRule.SetApduAccessRule(ChannelAccessRule::ACCESSRULE::NEVER);
+        channelAccessRule.SetNFCEventAccessRule(ChannelAccessRule::ACCESSRULE::NEVER);
+        return channelAccessRule;
+    }();
+    // the rules of the given aid first, then the rules of any aid
+    for (const std::string* ruleAid : {&aid, &EMPTY_AID}) {
+        std::unordered_map<std::string, AidRules>::iterator aidIter = index_.find(*ruleAid);
+        if (aidIter == index_.end()) {
+            continue;
+        }
+        AidRules& aidRules = aidIter->second;
+        for (const std::string& hash : hashes) {
+            std::unordered_map<std::string, ChannelAccessRule*>::iterator hashIter = aidRules.hashRules_.find(hash);
+            if (hashIter != aidRules.hashRules_.end()) {
+                DebugLog("Find the access rule by the aid and the given hash");
+                return hashIter->second;
+            }
+        }
+        if (aidRules.hasSpecificHash_) {
             DebugLog("Aid has a specific rule with different hash, denied access");
-            ChannelAccessRule channelAccessRule = ChannelAccessRule();
-            channelAccessRule.SetAccessRule(ChannelAccessRule::ACCESSRULE::NEVER, "Specific rules have priority.");
-            channelAccessRule.SetApduAccessRule(ChannelAccessRule::ACCESSRULE::NEVER);
-            channelAccessRule.SetNFCEventAccessRule(ChannelAccessRule::ACCESSRULE::NEVER);
-            return channelAccessRule;
+            return &specificRulesHavePriority;
+        }
+        std::unordered_map<std::string, ChannelAccessRule*>::iterator anyIter = aidRules.hashRules_.find("");
+        if (anyIter != aidRules.hashRules_.end()) {
+            DebugLog("Find the access rule by the aid and the empty hash");
+            return anyIter->second;
         }
     }
+    return nullptr;
+}
 
-    {
-        aidRefDo = AidRefDo::AidToAidRefDo(aid);
-        hashRefDo = std::make_shared<HashRefDo>("");
-        refDo = std::make_shared<RefDo>(aidRefDo, hashRefDo);
-        iter = accessRuleMap_.find(*refDo);
-        if (iter != accessRuleMap_.end()) {
-            DebugLog("Find the access rule by the given aid and the empty hash");
-            return iter->second;
-        }
+void AccessRuleCache::BuildIndex()
+{
+    DebugLog("AccessRuleCache::BuildIndex");
+    index_.clear();
+    for (std::map<RefDo, ChannelAccessRule>::iterator iter = accessRuleMap_.begin(); iter != accessRuleMap_.end();
+         iter++) {
+        RefDo refDo = iter->first;
+        std::string hash = refDo.GetHashRefDo()->GetHash();
+        AidRules& aidRules = index_[refDo.GetAidRefDo()->GetAid()];
+        aidRules.hashRules_[hash] = &iter->second;
+        aidRules.hasSpecificHash_ = aidRules.hasSpecificHash_ || !hash.empty();
     }
-    DebugLog("No rule found by the given aid");
+    indexGeneration_ = generation_;
+}
 
-    for (std::string hash : hashes) {
-        aidRefDo = std::make_shared<AidRefDo>(AidRefDo::AID_REF_DO_TAG, EMPTY_AID);
-        hashRefDo = std::make_shared<HashRefDo>(hash);
-        refDo = std::make_shared<RefDo>(aidRefDo, hashRefDo);
-        iter = accessRuleMap_.find(*refDo);
-        if (iter != accessRuleMap_.end()) {
-            DebugLog("Find the access rule by the empty aid and the given hash");
-            return iter->second;
+std::string AccessRuleCache::Serialize()
+{
+    DebugLog("AccessRuleCache::Serialize");
+    std::string value = ToTlv(SNAPSHOT_VERSION_TAG, std::string(1, SNAPSHOT_VERSION));
+    value += ToTlv(SNAPSHOT_REFRESH_TAG_TAG, refreshTag_);
+    for (auto rule : accessRuleMap_) {
+        RefDo refDo = rule.first;
+        ChannelAccessRule& channelAccessRule = rule.second;
+        std::string access = {(char)channelAccessRule.GetAccessRule(),
+                              (char)channelAccessRule.GetApduAccessRule(),
+                              (char)channelAccessRule.HasApduFilter(),
+                              (char)channelAccessRule.GetNFCEventAccessRule()};
+        std::string ruleValue = refDo.GetData() + ToTlv(SNAPSHOT_ACCESS_TAG, access);
+        ruleValue += ToTlv(SNAPSHOT_REASON_TAG, channelAccessRule.GetReason());
+        for (std::string apduFilter : channelAccessRule.GetApduFilters()) {
+            ruleValue += ToTlv(SNAPSHOT_APDU_FILTER_TAG, apduFilter);
         }
+        value += ToTlv(SNAPSHOT_RULE_TAG, ruleValue);
     }
-    DebugLog("No rule found by the given hash");
+    for (RefDo refDo : carrierPrivilegeCache_) {
+        value += ToTlv(SNAPSHOT_CARRIER_PRIVILEGE_TAG, refDo.GetData());
+    }
+    return ToTlv(SNAPSHOT_TAG, value);
+}
 
-    for (iter = accessRuleMap_.begin(); iter != accessRuleMap_.end(); iter++) {
-        RefDo arRefDo = iter->first;
-        std::string arAid = arRefDo.GetAidRefDo()->GetAid();
-        std::string arHash = arRefDo.GetHashRefDo()->GetHash();
-        if (arAid.empty() && arHash.length() > 0) {
-            DebugLog("Empty aid has a specific rule with different hash, denied access");
-            ChannelAccessRule channelAccessRule = ChannelAccessRule();
-            channelAccessRule.SetAccessRule(ChannelAccessRule::ACCESSRULE::NEVER, "Specific rules have priority.");
-            channelAccessRule.SetApduAccessRule(ChannelAccessRule::ACCESSRULE::NEVER);
-            channelAccessRule.SetNFCEventAccessRule(ChannelAccessRule::ACCESSRULE::NEVER);
-            return channelAccessRule;
+bool AccessRuleCache::Deserialize(const std::string& data)
+{
+    DebugLog("AccessRuleCache::Deserialize");
+    ClearAccessRules();
+    refreshTag_ = "";
+    try {
+        std::string snapshot = data;
+        std::shared_ptr<BerTlv> bt = BerTlv::StrToBerTlv(snapshot);
+        if (bt->GetTag() != SNAPSHOT_TAG) {
+            ErrorLog("Invalid tag in snapshot");
+            throw AccessControlError("Parsing data error");
+        }
+        std::vector<std::shared_ptr<BerTlv>> children = ParseChildren(bt);
+        if (children.size() < 2 || children[0]->GetTag() != SNAPSHOT_VERSION_TAG ||
+            children[1]->GetTag() != SNAPSHOT_REFRESH_TAG_TAG) {
+            ErrorLog("Invalid header in snapshot");
+            throw AccessControlError("Parsing data error");
+        }
+        if (children[0]->GetValue() != std::string(1, SNAPSHOT_VERSION)) {
+            InfoLog("Snapshot of another version is ignored");
+            return false;
+        }
+        for (size_t i = 2; i < children.size(); i++) {
+            if (children[i]->GetTag() == SNAPSHOT_RULE_TAG) {
+                RestoreAccessRule(children[i]);
+            } else if (children[i]->GetTag() == SNAPSHOT_CARRIER_PRIVILEGE_TAG) {
+                std::string refData = children[i]->GetValue();
+                carrierPrivilegeCache_.push_back(*RefDo::BerTlvToRefDo(BerTlv::StrToBerTlv(refData)));
+            } else {
+                ErrorLog("Invalid tag in snapshot");
+                throw AccessControlError("Parsing data error");
+            }
         }
+        refreshTag_ = children[1]->GetValue();
+        ++generation_;
+        return true;
+    } catch (const std::runtime_error& error) {
+        ErrorLog("Snapshot is malformed: %s", error.what());
+        ClearAccessRules();
+        return false;
     }
+}
 
-    {
-        aidRefDo = std::make_shared<AidRefDo>(AidRefDo::AID_REF_DO_TAG, EMPTY_AID);
-        hashRefDo = std::make_shared<HashRefDo>("");
-        refDo = std::make_shared<RefDo>(aidRefDo, hashRefDo);
-        iter = accessRuleMap_.find(*refDo);
-        if (iter != accessRuleMap_.end()) {
-            DebugLog("Find the access rule by the empty aid and the empty hash");
-            return iter->second;
+void AccessRuleCache::RestoreAccessRule(std::shared_ptr<BerTlv> rule)
+{
+    // REF-DO, access, reason, apdu filters
+    std::vector<std::shared_ptr<BerTlv>> children = ParseChildren(rule);
+    if (children.size() < 3 || children[1]->GetTag() != SNAPSHOT_ACCESS_TAG ||
+        children[1]->GetValue().length() != SNAPSHOT_ACCESS_LENGTH || children[2]->GetTag() != SNAPSHOT_REASON_TAG) {
+        ErrorLog("Invalid rule in snapshot");
+        throw AccessControlError("Parsing data error");
+    }
+    std::shared_ptr<RefDo> refDo = RefDo::BerTlvToRefDo(children[0]);
+    std::string access = children[1]->GetValue();
+    ChannelAccessRule channelAccessRule = ChannelAccessRule();
+    channelAccessRule.SetAccessRule(ToAccessRule(access[0]), children[2]->GetValue());
+    channelAccessRule.SetApduAccessRule(ToAccessRule(access[1]));
+    channelAccessRule.SetHasApduFilter(access[2] != 0);
+    channelAccessRule.SetNFCEventAccessRule(ToAccessRule(access[3]));
+    std::vector<std::string> apduFilters;
+    for (size_t i = 3; i < children.size(); i++) {
+        if (children[i]->GetTag() != SNAPSHOT_APDU_FILTER_TAG ||
+            children[i]->GetValue().length() != APDU_FILTER_LENGTH) {
+            ErrorLog("Invalid apdu filter in snapshot");
+            throw AccessControlError("Parsing data error");
         }
+        apduFilters.push_back(children[i]->GetValue());
     }
-    DebugLog("No rule found");
-    return ChannelAccessRule();
+    channelAccessRule.SetApduFilters(apduFilters);
+    accessRuleMap_.insert(std::pair<RefDo, ChannelAccessRule>(*refDo, channelAccessRule));
 }
 }  // namespace OHOS::se::security
\ No newline at end of file
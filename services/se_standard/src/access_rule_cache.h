@@ -15,14 +15,17 @@
 #ifndef ACCESS_RULE_CACHE_H
 #define ACCESS_RULE_CACHE_H
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace OHOS::se::security {
 class ChannelAccessRule;
 class ArDo;
+class BerTlv;
 class RefDo;
 static const std::string EMPTY_AID = "";
 static const std::string CARRIER_PRIVILEGE_AID = {
@@ -33,17 +36,38 @@ public:
     ~AccessRuleCache();
     bool CompareRefreshTag(const std::string& refreshTag);
     void SetRefreshTag(const std::string& refreshTag);
+    std::string GetRefreshTag();
     void ClearAccessRules();
     void AddAccessRule(std::shared_ptr<RefDo> refDo, ChannelAccessRule channelAccess);
     void AddAccessRule(std::shared_ptr<RefDo> refDo, std::shared_ptr<ArDo> arDo);
-    ChannelAccessRule GetAccessRule(const std::string& aid, std::vector<std::string> hashes);
+    ChannelAccessRule GetAccessRule(const std::string& aid, const std::vector<std::string>& hashes);
     bool CheckCarrierPrivilege(std::string bundleName, std::vector<std::string> hashes);
+    // changes whenever the rules are cleared or added, the decisions derived from the rules are stale then
+    uint64_t GetGeneration() const;
+    // the refresh tag and the merged rules as BER-TLV, for the snapshot of the rules on disk
+    std::string Serialize();
+    // replaces the refresh tag and the rules, nothing is kept when the data is malformed
+    bool Deserialize(const std::string& data);
 
 private:
-    ChannelAccessRule GetAccessRuleWithUnknown(const std::string& aid, std::vector<std::string> hashes);
+    // the rules of an AID by hash, the empty hash is the rule for any application
+    class AidRules {
+    public:
+        std::unordered_map<std::string, ChannelAccessRule*> hashRules_;
+        // a rule names a hash, the applications with other hashes are denied the AID
+        bool hasSpecificHash_{false};
+    };
+    ChannelAccessRule GetAccessRuleWithUnknown(const std::string& aid, const std::vector<std::string>& hashes);
+    ChannelAccessRule* FindAccessRule(const std::string& aid, const std::vector<std::string>& hashes);
+    void BuildIndex();
+    void RestoreAccessRule(std::shared_ptr<BerTlv> rule);
     std::string refreshTag_;
     std::map<RefDo, ChannelAccessRule> accessRuleMap_;
     std::vector<RefDo> carrierPrivilegeCache_;
+    uint64_t generation_;
+    // AID (empty for any AID) -> hash -> merged rule of accessRuleMap_, built on the first lookup after a change
+    std::unordered_map<std::string, AidRules> index_;
+    uint64_t indexGeneration_;
 };
 }  // namespace OHOS::se::security
 #endif /* ACCESS_RULE_CACHE_H */
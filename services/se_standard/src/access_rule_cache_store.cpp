@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "access_rule_cache_store.h"
+
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "access_rule_cache.h"
+#include "loghelper.h"
+
+namespace OHOS::se::security {
+static const std::string ACCESS_RULE_CACHE_DIR = "/data/se";
+static const std::string ACCESS_RULE_CACHE_FILE_SUFFIX = "_access_rules.tlv";
+
+AccessRuleCacheStore::AccessRuleCacheStore(const std::string& path) : path_(path) {}
+
+AccessRuleCacheStore::~AccessRuleCacheStore() {}
+
+std::string AccessRuleCacheStore::GetPath(const std::string& terminalName)
+{
+    return ACCESS_RULE_CACHE_DIR + "/" + terminalName + ACCESS_RULE_CACHE_FILE_SUFFIX;
+}
+
+bool AccessRuleCacheStore::Load(AccessRuleCache& accessRuleCache)
+{
+    DebugLog("AccessRuleCacheStore::Load");
+    std::string content;
+    if (!ReadFile(content)) {
+        DebugLog("No access rule snapshot: %s", path_.c_str());
+        return false;
+    }
+    if (!accessRuleCache.Deserialize(content)) {
+        ErrorLog("Fail to restore access rule snapshot: %s", path_.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool AccessRuleCacheStore::Store(AccessRuleCache& accessRuleCache)
+{
+    DebugLog("AccessRuleCacheStore::Store");
+    if (!WriteFile(accessRuleCache.Serialize())) {
+        ErrorLog("Fail to write access rule snapshot: %s", path_.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool AccessRuleCacheStore::ReadFile(std::string& content)
+{
+    std::ifstream f(path_, std::ios::binary);
+    if (!f.is_open()) {
+        return false;
+    }
+    std::stringstream ss;
+    ss << f.rdbuf();
+    content = ss.str();
+    return !content.empty();
+}
+
+bool AccessRuleCacheStore::WriteFile(const std::string& content)
+{
+    std::string::size_type separator = path_.find_last_of('/');
+    if (separator != std::string::npos && separator > 0) {
+        std::string dir = path_.substr(0, separator);
+        if (mkdir(dir.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+            ErrorLog("Fail to create access rule snapshot directory: %s", dir.c_str());
+            return false;
+        }
+    }
+    // a crash while writing leaves the previous snapshot in place
+    std::string tmp = path_ + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f.is_open()) {
+            return false;
+        }
+        f.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (!f.good()) {
+            f.close();
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+}  // namespace OHOS::se::security
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ACCESS_RULE_CACHE_STORE_H
+#define ACCESS_RULE_CACHE_STORE_H
+
+#include <string>
+
+namespace OHOS::se::security {
+class AccessRuleCache;
+/*
+ * Persists the access rules of a terminal together with their refresh tag,
+ * so that after boot or a reset of the SE only the refresh tag is read while
+ * the rules on the SE are unchanged.
+ */
+class AccessRuleCacheStore {
+public:
+    explicit AccessRuleCacheStore(const std::string& path);
+    virtual ~AccessRuleCacheStore();
+    AccessRuleCacheStore(const AccessRuleCacheStore&) = delete;
+    AccessRuleCacheStore& operator=(const AccessRuleCacheStore&) = delete;
+
+    // the snapshot file of the terminal, in the data directory of the service
+    static std::string GetPath(const std::string& terminalName);
+    /**
+     * @brief Restores the refresh tag and the rules of the snapshot
+     * @param accessRuleCache the cache to fill
+     * @return True if the snapshot is read, the cache is left empty otherwise
+     */
+    bool Load(AccessRuleCache& accessRuleCache);
+    /**
+     * @brief Replaces the snapshot with the refresh tag and the rules of the cache
+     * @param accessRuleCache the cache to save
+     * @return True if written to the file
+     */
+    bool Store(AccessRuleCache& accessRuleCache);
+
+protected:
+    virtual bool ReadFile(std::string& content);
+    virtual bool WriteFile(const std::string& content);
+
+private:
+    std::string path_;
+};
+}  // namespace OHOS::se::security
+#endif /* ACCESS_RULE_CACHE_STORE_H */
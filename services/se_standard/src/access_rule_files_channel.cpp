@@ -20,7 +20,11 @@
 #include "se_common_exception.h"
 
 namespace OHOS::se::security {
-AccessRuleFilesChannel::AccessRuleFilesChannel() : channel_(std::shared_ptr<SeChannel>()) {}
+AccessRuleFilesChannel::AccessRuleFilesChannel()
+    : channel_(std::shared_ptr<SeChannel>()),
+      extendedLengthSupported_(false)
+{
+}
 
 AccessRuleFilesChannel::~AccessRuleFilesChannel() {}
 
@@ -43,4 +47,52 @@ void AccessRuleFilesChannel::Close()
         channel_->Close();
     }
 }
+
+bool AccessRuleFilesChannel::IsExtendedLengthSupported()
+{
+    return extendedLengthSupported_;
+}
+
+void AccessRuleFilesChannel::SetExtendedLengthSupported(bool extendedLengthSupported)
+{
+    extendedLengthSupported_ = extendedLengthSupported;
+}
+
+bool AccessRuleFilesChannel::IsExtendedLengthSupportedByAtr(const std::string& atr)
+{
+    if (atr.length() < 2) {
+        return false;
+    }
+    size_t historicalLength = atr[1] & 0x0F;
+    // TS T0, then the interface bytes announced by T0 and each TDi, TDi is the last of its group
+    size_t index = 1;
+    int indicator = atr[1] & 0xF0;
+    while (true) {
+        index += ((indicator & 0x10) ? 1 : 0) + ((indicator & 0x20) ? 1 : 0) + ((indicator & 0x40) ? 1 : 0) +
+                 ((indicator & 0x80) ? 1 : 0);
+        if (!(indicator & 0x80) || index >= atr.length()) {
+            break;
+        }
+        indicator = atr[index] & 0xF0;
+    }
+    size_t begin = index + 1;
+    size_t end = begin + historicalLength;
+    // category indicator 0x80, COMPACT-TLV data objects follow
+    if (historicalLength == 0 || end > atr.length() || (atr[begin] & 0xFF) != 0x80) {
+        return false;
+    }
+    for (size_t i = begin + 1; i < end;) {
+        int tag = (atr[i] >> 4) & 0x0F;
+        size_t length = atr[i] & 0x0F;
+        if (i + 1 + length > end) {
+            break;
+        }
+        // card capabilities, the third software function table tells the extended Lc and Le fields
+        if (tag == 0x07 && length >= 3) {
+            return (atr[i + 3] & 0x40) != 0;
+        }
+        i += 1 + length;
+    }
+    return false;
+}
 }  // namespace OHOS::se::security
\ No newline at end of file
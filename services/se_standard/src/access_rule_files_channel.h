@@ -30,9 +30,14 @@ public:
     void SetChannel(std::shared_ptr<OHOS::se::SeChannel> channel);
     std::string Transmit(std::string cmd);
     void Close();
+    bool IsExtendedLengthSupported();
+    void SetExtendedLengthSupported(bool extendedLengthSupported);
+    // the card capabilities in the historical bytes of the ATR, ISO/IEC 7816-4 8.1.1.2.7
+    static bool IsExtendedLengthSupportedByAtr(const std::string& atr);
 
 private:
     std::shared_ptr<OHOS::se::SeChannel> channel_;
+    bool extendedLengthSupported_;
 };
 }  // namespace OHOS::se::security
 #endif /* ACCESS_RULE_FILES_CHANNEL_H */
\ No newline at end of file
@@ -37,7 +37,8 @@ AccessRuleFilesController::AccessRuleFilesController(std::weak_ptr<AccessRuleCac
       accessControlRule_(std::shared_ptr<AccessControlRules>()),
       accessControlMainPath_(""),
       pkcs15Path_(""),
-      acmfFound_(true)
+      acmfFound_(true),
+      atrChecked_(false)
 {
 }
 
@@ -115,6 +116,11 @@ bool AccessRuleFilesController::SelectAccessControlRules(std::string aid)
     channelAccess->SetApduAccessRule(ChannelAccessRule::ACCESSRULE::ALWAYS);
     channel->SetChannelAccess(channelAccess);
     arfChannel_->SetChannel(channel);
+    if (!atrChecked_) {
+        arfChannel_->SetExtendedLengthSupported(
+            AccessRuleFilesChannel::IsExtendedLengthSupportedByAtr(terminal->GetAtr()));
+        atrChecked_ = true;
+    }
 
     if (aid.empty()) {
         if (pkcs15Path_.empty()) {
@@ -145,8 +151,7 @@ bool AccessRuleFilesController::UpdateAccessControlRules()
     }
 
     if (!acmfFound_) {
-        accessRuleCache->SetRefreshTag("");
-        accessRuleCache->ClearAccessRules();
+        // the rules were cleared when the ACMF was lost, the ones restored since are kept until the tag differs
         accessControlMainPath_ = "";
         if (arfChannel_) {
             arfChannel_->Close();
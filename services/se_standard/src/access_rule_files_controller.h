@@ -46,6 +46,8 @@ private:
     std::string accessControlMainPath_;
     std::string pkcs15Path_;
     bool acmfFound_;
+    // the ATR is checked for the extended length once, a refused extended read turns it off for good
+    bool atrChecked_;
     void GetAcmf();
     bool SelectAccessControlRules(std::string aid);
     bool UpdateAccessControlRules();
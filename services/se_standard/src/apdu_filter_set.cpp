@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "apdu_filter_set.h"
+
+#include <algorithm>
+#include <bitset>
+#include <utility>
+
+namespace OHOS::se::security {
+static const size_t APDU_HEADER_LENGTH = 4;
+// pairs checked before the loop may exit
+static const size_t MATCH_BLOCK_SIZE = 8;
+
+static uint32_t ToHeader(const std::string& bytes, size_t offset)
+{
+    return (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset])) << 24) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 1])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 2])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + 3]));
+}
+
+ApduFilterSet::ApduFilterSet(const std::vector<std::string>& apduFilters) : values_(), masks_()
+{
+    std::vector<std::pair<uint32_t, uint32_t>> filters;
+    for (const std::string& apduFilter : apduFilters) {
+        if (apduFilter.length() != APDU_FILTER_LENGTH) {
+            continue;
+        }
+        uint32_t value = ToHeader(apduFilter, 0);
+        uint32_t mask = ToHeader(apduFilter, APDU_HEADER_LENGTH);
+        if ((value & mask) != value) {
+            // a bit outside of the mask, no command matches
+            continue;
+        }
+        filters.push_back(std::make_pair(mask, value));
+    }
+    std::sort(filters.begin(), filters.end(),
+              [](const std::pair<uint32_t, uint32_t>& a, const std::pair<uint32_t, uint32_t>& b) {
+                  size_t aBits = std::bitset<32>(a.first).count();
+                  size_t bBits = std::bitset<32>(b.first).count();
+                  return aBits != bBits ? aBits < bBits : a < b;
+              });
+    filters.erase(std::unique(filters.begin(), filters.end()), filters.end());
+    for (const std::pair<uint32_t, uint32_t>& filter : filters) {
+        masks_.push_back(filter.first);
+        values_.push_back(filter.second);
+    }
+}
+
+ApduFilterSet::~ApduFilterSet() {}
+
+bool ApduFilterSet::Matches(const std::string& command) const
+{
+    if (command.length() < APDU_HEADER_LENGTH) {
+        return false;
+    }
+    uint32_t header = ToHeader(command, 0);
+    const uint32_t* values = values_.data();
+    const uint32_t* masks = masks_.data();
+    size_t size = values_.size();
+    for (size_t begin = 0; begin < size; begin += MATCH_BLOCK_SIZE) {
+        size_t end = std::min(begin + MATCH_BLOCK_SIZE, size);
+        uint32_t matched = 0;
+        for (size_t i = begin; i < end; i++) {
+            matched |= static_cast<uint32_t>((header & masks[i]) == values[i]);
+        }
+        if (matched) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ApduFilterSet::GetSize() const
+{
+    return values_.size();
+}
+}  // namespace OHOS::se::security
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef APDU_FILTER_SET_H
+#define APDU_FILTER_SET_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS::se::security {
+/*
+ * The APDU filters of a channel access rule compiled into 32-bit (value, mask)
+ * pairs over the CLA INS P1 P2 header. A command header is checked against
+ * blocks of pairs without branches, so the compiler can vectorize the loop,
+ * and the broadest filters come first since they match most commands.
+ */
+class ApduFilterSet {
+public:
+    // the filters of APDU-AR-DO, 4 bytes of header and 4 bytes of mask each
+    explicit ApduFilterSet(const std::vector<std::string>& apduFilters);
+    ~ApduFilterSet();
+    ApduFilterSet(const ApduFilterSet&) = delete;
+    ApduFilterSet& operator=(const ApduFilterSet&) = delete;
+
+    /**
+     * @brief Checks the header of the command against the filters
+     * @param command the command APDU
+     * @return True if a filter matches, false for a command shorter than the header or no filters
+     */
+    bool Matches(const std::string& command) const;
+    size_t GetSize() const;
+
+    static const size_t APDU_FILTER_LENGTH = 8;
+
+private:
+    std::vector<uint32_t> values_;
+    std::vector<uint32_t> masks_;
+};
+}  // namespace OHOS::se::security
+#endif  // !APDU_FILTER_SET_H
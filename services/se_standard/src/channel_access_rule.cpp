@@ -14,6 +14,8 @@
  */
 #include "channel_access_rule.h"
 
+#include "apdu_filter_set.h"
+
 namespace OHOS::se::security {
 ChannelAccessRule::ChannelAccessRule()
     : accessRule_(UNKNOWN),
@@ -21,6 +23,7 @@ ChannelAccessRule::ChannelAccessRule()
       apduAccessRule_(UNKNOWN),
       hasApduFilter_(false),
       apduFilters_({}),
+      apduFilterSet_(std::shared_ptr<const ApduFilterSet>()),
       nfcAccessRule_(UNKNOWN),
       bundleName_(""),
       callingPid_(0),
@@ -74,6 +77,12 @@ std::vector<std::string> ChannelAccessRule::GetApduFilters()
 void ChannelAccessRule::SetApduFilters(std::vector<std::string> apduFilters)
 {
     apduFilters_ = apduFilters;
+    apduFilterSet_ = std::make_shared<const ApduFilterSet>(apduFilters_);
+}
+
+std::shared_ptr<const ApduFilterSet> ChannelAccessRule::GetApduFilterSet()
+{
+    return apduFilterSet_;
 }
 
 ChannelAccessRule::ACCESSRULE ChannelAccessRule::GetNFCEventAccessRule()
@@ -20,6 +20,7 @@
 #include <vector>
 
 namespace OHOS::se::security {
+class ApduFilterSet;
 class ChannelAccessRule {
 public:
     enum ACCESSRULE { ALWAYS, NEVER, UNKNOWN };
@@ -34,6 +35,8 @@ public:
     void SetHasApduFilter(bool hasApduFilter);
     std::vector<std::string> GetApduFilters();
     void SetApduFilters(std::vector<std::string> apduFilters);
+    // the filters compiled for matching, shared by the copies of the rule, null before the filters are set
+    std::shared_ptr<const ApduFilterSet> GetApduFilterSet();
     ChannelAccessRule::ACCESSRULE GetNFCEventAccessRule();
     void SetNFCEventAccessRule(ACCESSRULE nfcAccessRule);
     std::string GetBundleName();
@@ -52,6 +55,7 @@ private:
     ACCESSRULE apduAccessRule_;
     bool hasApduFilter_;
     std::vector<std::string> apduFilters_;
+    std::shared_ptr<const ApduFilterSet> apduFilterSet_;
     ACCESSRULE nfcAccessRule_;
     std::string bundleName_;
     int callingPid_;
@@ -51,16 +51,16 @@ std::shared_ptr<ArDo> ArDo::BerTlvToArDo(std::shared_ptr<BerTlv> berTlv)
         throw AccessControlError("Parsing data error");
     }
 
-    std::shared_ptr<BerTlv> tlv = BerTlv::StrToBerTlv(value);
+    BerTlvReader reader(value, 0, length);
+    std::shared_ptr<BerTlv> tlv = reader.ToBerTlv(reader.Next());
     std::shared_ptr<ApduArDo> apduArDo;
     std::shared_ptr<NfcArDo> nfcArDo;
     apduArDo = ApduArDo::BerTlvToApduArDo(tlv);
     if (apduArDo) {
-        std::string tlvStr = value.substr((apduArDo->GetData()).length());
-        if (tlvStr.empty()) {
+        if (reader.IsEnd()) {
             tlv = std::shared_ptr<BerTlv>();
         } else {
-            tlv = BerTlv::StrToBerTlv(tlvStr);
+            tlv = reader.ToBerTlv(reader.Next());
         }
     }
     if (tlv) {
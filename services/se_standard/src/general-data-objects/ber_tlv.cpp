@@ -14,18 +14,21 @@
  */
 #include "ber_tlv.h"
 
+#include <utility>
+
 #include "loghelper.h"
 #include "se_common_exception.h"
 
 namespace OHOS::se::security {
 BerTlv::BerTlv(int tag, int length, std::string value, std::string data)
-    : tag_(tag), length_(length), value_(value), data_(data)
+    : tag_(tag), length_(length), value_(std::move(value)), data_(std::move(data))
 {
 }
 
-BerTlv::BerTlv(int tag, int length, std::string value) : tag_(tag), length_(length), value_(value), data_("")
+BerTlv::BerTlv(int tag, int length, std::string value) : tag_(tag), length_(length), value_(""), data_("")
 {
     std::string data = "";
+    data.reserve(value.length() + 6);
     // tag
     if (tag > 0xFF) {
         data += (char)(((tag & 0x0000FF00) >> 8) & 0xFF);
@@ -51,7 +54,8 @@ BerTlv::BerTlv(int tag, int length, std::string value) : tag_(tag), length_(leng
     }
     // value
     data += value;
-    data_ = data;
+    value_ = std::move(value);
+    data_ = std::move(data);
 }
 
 BerTlv::~BerTlv() {}
@@ -82,12 +86,98 @@ std::shared_ptr<BerTlv> BerTlv::StrToBerTlv(std::string& data)
         ErrorLog("Data is empty");
         throw AccessControlError("Parsing data error");
     }
+    int tag = 0;
+    int length = 0;
+    size_t curIndex = BerTlvReader::ReadHeader(data, 0, data.length(), tag, length);
+
+    // a value shorter than the length is left to the data objects to refuse
+    std::string value;
+    if (length == 0) {
+        value = "";
+    } else if (curIndex + length > data.length()) {
+        value = data.substr(curIndex);
+    } else {
+        value = data.substr(curIndex, length);
+    }
+    return std::make_shared<BerTlv>(tag, length, value, data.substr(0, curIndex + length));
+}
+
+void BerTlv::Print()
+{
+    printf("BerTlv::Tag : %d\n", tag_);
+    printf("BerTlv::Length : %d\n", length_);
+    printf("BerTlv::Value : ");
+    for (size_t i = 0; i < value_.length(); i++) {
+        printf("0x%02X ", value_[i]);
+    }
+    printf("\n");
+}
+
+BerTlvReader::BerTlvReader(const std::string& data) : data_(data), index_(0), end_(data.length()) {}
+
+BerTlvReader::BerTlvReader(const std::string& data, size_t begin, size_t end)
+    : data_(data), index_(begin), end_(end)
+{
+    if (begin > end || end > data.length()) {
+        ErrorLog("Invalid range of the reader");
+        throw AccessControlError("Parsing data error");
+    }
+}
+
+BerTlvReader::~BerTlvReader() {}
+
+bool BerTlvReader::IsEnd() const
+{
+    return index_ >= end_;
+}
+
+BerTlvReader::Tlv BerTlvReader::Next()
+{
+    if (IsEnd()) {
+        ErrorLog("Data is empty");
+        throw AccessControlError("Parsing data error");
+    }
+    Tlv tlv;
+    tlv.offset_ = index_;
+    tlv.valueOffset_ = ReadHeader(data_, index_, end_, tlv.tag_, tlv.length_);
+    if ((size_t)tlv.length_ > end_ - tlv.valueOffset_) {
+        ErrorLog("Value length not enough");
+        throw AccessControlError("Parsing data error");
+    }
+    index_ = tlv.valueOffset_ + tlv.length_;
+    return tlv;
+}
 
-    int curIndex = 0;
+BerTlvReader BerTlvReader::GetChildren(const Tlv& tlv) const
+{
+    return BerTlvReader(data_, tlv.valueOffset_, tlv.valueOffset_ + tlv.length_);
+}
+
+std::string BerTlvReader::GetValue(const Tlv& tlv) const
+{
+    return data_.substr(tlv.valueOffset_, tlv.length_);
+}
+
+std::string BerTlvReader::GetData(const Tlv& tlv) const
+{
+    return data_.substr(tlv.offset_, tlv.valueOffset_ + tlv.length_ - tlv.offset_);
+}
+
+std::shared_ptr<BerTlv> BerTlvReader::ToBerTlv(const Tlv& tlv) const
+{
+    return std::make_shared<BerTlv>(tlv.tag_, tlv.length_, GetValue(tlv), GetData(tlv));
+}
+
+size_t BerTlvReader::ReadHeader(const std::string& data, size_t offset, size_t end, int& tag, int& length)
+{
+    size_t curIndex = offset;
+    if (curIndex >= end) {
+        ErrorLog("Data length error");
+        throw AccessControlError("Parsing data error");
+    }
     int temp = data[curIndex++] & 0xff;
-    int tag = 0;
     if ((temp & 0x1f) == 0x1f) {
-        if (curIndex >= (int)data.length()) {
+        if (curIndex >= end) {
             ErrorLog("Data length error");
             throw AccessControlError("Parsing data error");
         }
@@ -96,22 +186,25 @@ std::shared_ptr<BerTlv> BerTlv::StrToBerTlv(std::string& data)
         tag = temp;
     }
 
-    if (curIndex >= (int)data.length()) {
+    if (curIndex >= end) {
         ErrorLog("Data length error");
         throw AccessControlError("Parsing data error");
     }
     temp = data[curIndex++] & 0xff;
-    int length = 0;
     if (temp < 0x80) {
         length = temp;
     } else if (temp == 0x81) {
+        if (curIndex >= end) {
+            ErrorLog("Data length error");
+            throw AccessControlError("Parsing data error");
+        }
         length = data[curIndex++] & 0xff;
         if (length < 0x80) {
             ErrorLog("Length error");
             throw AccessControlError("Parsing data error");
         }
     } else if (temp == 0x82) {
-        if (curIndex + 1 >= (int)data.length()) {
+        if (curIndex + 1 >= end) {
             ErrorLog("Data length error");
             throw AccessControlError("Parsing data error");
         }
@@ -122,7 +215,7 @@ std::shared_ptr<BerTlv> BerTlv::StrToBerTlv(std::string& data)
             throw AccessControlError("Parsing data error");
         }
     } else if (temp == 0x83) {
-        if (curIndex + 2 >= (int)data.length()) {
+        if (curIndex + 2 >= end) {
             ErrorLog("Data length error");
             throw AccessControlError("Parsing data error");
         }
@@ -136,26 +229,6 @@ std::shared_ptr<BerTlv> BerTlv::StrToBerTlv(std::string& data)
         ErrorLog("Unsupported length");
         throw AccessControlError("Parsing data error");
     }
-
-    std::string value;
-    if (length == 0) {
-        value = "";
-    } else if (curIndex + length > (int)data.length()) {
-        value = data.substr(curIndex);
-    } else {
-        value = data.substr(curIndex, length);
-    }
-    return std::make_shared<BerTlv>(tag, length, value, data.substr(0, curIndex + length));
-}
-
-void BerTlv::Print()
-{
-    printf("BerTlv::Tag : %d\n", tag_);
-    printf("BerTlv::Length : %d\n", length_);
-    printf("BerTlv::Value : ");
-    for (size_t i = 0; i < value_.length(); i++) {
-        printf("0x%02X ", value_[i]);
-    }
-    printf("\n");
+    return curIndex;
 }
 }  // namespace OHOS::se::security
\ No newline at end of file
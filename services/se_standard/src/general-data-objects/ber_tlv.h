@@ -15,6 +15,7 @@
 #ifndef BER_TLV_H
 #define BER_TLV_H
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -40,5 +41,41 @@ private:
     std::string value_;
     std::string data_;
 };
+
+/*
+ * Walks the BER-TLVs of one buffer in place. A TLV is read as its tag,
+ * length and position in the buffer, the value is only copied when asked
+ * for, and the children of a constructed TLV are read by a reader over its
+ * value. The buffer must outlive the reader.
+ */
+class BerTlvReader {
+public:
+    class Tlv final {
+    public:
+        int tag_;
+        int length_;
+        // position of the tag and of the value in the buffer
+        size_t offset_;
+        size_t valueOffset_;
+    };
+
+    explicit BerTlvReader(const std::string& data);
+    BerTlvReader(const std::string& data, size_t begin, size_t end);
+    ~BerTlvReader();
+    bool IsEnd() const;
+    // the next TLV, its value must be complete
+    Tlv Next();
+    BerTlvReader GetChildren(const Tlv& tlv) const;
+    std::string GetValue(const Tlv& tlv) const;
+    std::string GetData(const Tlv& tlv) const;
+    std::shared_ptr<BerTlv> ToBerTlv(const Tlv& tlv) const;
+    // parses the tag and the length at offset, returns the offset of the value
+    static size_t ReadHeader(const std::string& data, size_t offset, size_t end, int& tag, int& length);
+
+private:
+    const std::string& data_;
+    size_t index_;
+    size_t end_;
+};
 }  // namespace OHOS::se::security
 #endif /* BER_TLV_H */
@@ -51,12 +51,9 @@ std::shared_ptr<RefArDo> RefArDo::BerTlvToRefArDo(std::shared_ptr<BerTlv> berTlv
         throw AccessControlError("Parsing data error");
     }
 
-    std::shared_ptr<BerTlv> refTlv = BerTlv::StrToBerTlv(value);
-    std::shared_ptr<RefDo> refDo = RefDo::BerTlvToRefDo(refTlv);
-
-    std::string arTlv = value.substr((refDo->GetData()).length());
-    std::shared_ptr<BerTlv> arData = BerTlv::StrToBerTlv(arTlv);
-    std::shared_ptr<ArDo> arDo = ArDo::BerTlvToArDo(arData);
+    BerTlvReader reader(value, 0, length);
+    std::shared_ptr<RefDo> refDo = RefDo::BerTlvToRefDo(reader.ToBerTlv(reader.Next()));
+    std::shared_ptr<ArDo> arDo = ArDo::BerTlvToArDo(reader.ToBerTlv(reader.Next()));
 
     return std::make_shared<RefArDo>(berTlv, refDo, arDo);
 }
@@ -83,20 +83,15 @@ std::shared_ptr<RefDo> RefDo::BerTlvToRefDo(std::shared_ptr<BerTlv> berTlv)
         throw AccessControlError("Parsing data error");
     }
 
-    std::shared_ptr<BerTlv> aidTlv = BerTlv::StrToBerTlv(value);
-    std::shared_ptr<AidRefDo> aidRefDo = AidRefDo::BerTlvToAidRefDo(aidTlv);
+    BerTlvReader reader(value, 0, length);
+    std::shared_ptr<AidRefDo> aidRefDo = AidRefDo::BerTlvToAidRefDo(reader.ToBerTlv(reader.Next()));
+    std::shared_ptr<HashRefDo> hashRefDo = HashRefDo::BerTlvToHashRefDo(reader.ToBerTlv(reader.Next()));
 
-    std::string hashTlv = value.substr((aidRefDo->GetData()).length());
-    std::shared_ptr<BerTlv> hashRefData = BerTlv::StrToBerTlv(hashTlv);
-    std::shared_ptr<HashRefDo> hashRefDo = HashRefDo::BerTlvToHashRefDo(hashRefData);
-
-    if (hashTlv.length() == (hashRefDo->GetData()).length()) {
+    if (reader.IsEnd()) {
         return std::make_shared<RefDo>(aidRefDo, hashRefDo);
     } else {
         DebugLog("Has PKG-REF-DO");
-        std::string remainData = hashTlv.substr((hashRefDo->GetData()).length());
-        std::shared_ptr<BerTlv> pkgRefData = BerTlv::StrToBerTlv(remainData);
-        std::shared_ptr<PkgRefDo> pkgRefDo = PkgRefDo::BerTlvToPkgRefDo(pkgRefData);
+        std::shared_ptr<PkgRefDo> pkgRefDo = PkgRefDo::BerTlvToPkgRefDo(reader.ToBerTlv(reader.Next()));
         return std::make_shared<RefDo>(aidRefDo, hashRefDo, pkgRefDo);
     }
 }
@@ -19,6 +19,9 @@
 #include "se_common_exception.h"
 
 namespace OHOS::se::security {
+// two bytes of tag, 0x83 and three bytes of length
+static const size_t MAX_TLV_HEADER_LENGTH = 6;
+
 ResponseAllArDo::ResponseAllArDo(std::shared_ptr<BerTlv> berTlv, std::vector<RefArDo> refArDoArray)
     : BerTlv(berTlv->GetTag(), berTlv->GetLength(), berTlv->GetValue()), refArDoArray_(refArDoArray)
 {
@@ -46,17 +49,82 @@ std::shared_ptr<ResponseAllArDo> ResponseAllArDo::BerTlvToResponseAllArDo(std::s
     }
 
     std::vector<RefArDo> refArDoArray;
-    int remainLength = length;
-    std::string remainValue = value;
-    while (remainLength > 0) {
-        std::shared_ptr<BerTlv> bt = BerTlv::StrToBerTlv(remainValue);
-        std::shared_ptr<RefArDo> rad = RefArDo::BerTlvToRefArDo(bt);
+    BerTlvReader reader(value, 0, length);
+    while (!reader.IsEnd()) {
+        std::shared_ptr<RefArDo> rad = RefArDo::BerTlvToRefArDo(reader.ToBerTlv(reader.Next()));
         if (rad) {
             refArDoArray.push_back(*rad);
         }
-        remainValue = remainValue.substr((bt->GetData()).length());
-        remainLength -= (bt->GetData()).length();
     }
     return std::make_shared<ResponseAllArDo>(berTlv, refArDoArray);
 }
+
+ResponseAllArDoAssembler::ResponseAllArDoAssembler()
+    : data_(""), started_(false), end_(0), parsed_(0), refArDoArray_()
+{
+}
+
+ResponseAllArDoAssembler::~ResponseAllArDoAssembler() {}
+
+void ResponseAllArDoAssembler::Append(const std::string& response)
+{
+    if (response.empty()) {
+        ErrorLog("No data in the response");
+        throw AccessControlError("Parsing data error");
+    }
+    if (!started_) {
+        int tag = 0;
+        int length = 0;
+        size_t valueOffset = BerTlvReader::ReadHeader(response, 0, response.length(), tag, length);
+        if (tag != ResponseAllArDo::RESPONSE_ALL_AR_DO_TAG) {
+            ErrorLog("Invalid tag in ResponseAllArDo");
+            throw AccessControlError("Parsing data error");
+        }
+        started_ = true;
+        end_ = valueOffset + length;
+        parsed_ = valueOffset;
+        data_.reserve(end_);
+    }
+    // the bytes after the Response-ALL-AR-DO are ignored
+    size_t remain = end_ - data_.length();
+    data_.append(response, 0, (response.length() < remain) ? response.length() : remain);
+    ParseRefArDos();
+}
+
+bool ResponseAllArDoAssembler::IsComplete() const
+{
+    return started_ && data_.length() == end_;
+}
+
+std::vector<RefArDo> ResponseAllArDoAssembler::GetRefArDoArray()
+{
+    if (!IsComplete()) {
+        ErrorLog("Value length not enough in ResponseAllArDo");
+        throw AccessControlError("Parsing data error");
+    }
+    return refArDoArray_;
+}
+
+void ResponseAllArDoAssembler::ParseRefArDos()
+{
+    bool complete = IsComplete();
+    while (parsed_ < data_.length()) {
+        // wait for the next response when the REF-AR-DO is not complete yet
+        if (!complete && data_.length() - parsed_ < MAX_TLV_HEADER_LENGTH) {
+            return;
+        }
+        int tag = 0;
+        int length = 0;
+        size_t valueOffset = BerTlvReader::ReadHeader(data_, parsed_, data_.length(), tag, length);
+        if (!complete && valueOffset + length > data_.length()) {
+            return;
+        }
+        BerTlvReader reader(data_, parsed_, data_.length());
+        std::shared_ptr<RefArDo> rad = RefArDo::BerTlvToRefArDo(reader.ToBerTlv(reader.Next()));
+        if (rad) {
+            refArDoArray_.push_back(*rad);
+        }
+        parsed_ = valueOffset + length;
+    }
+}
 }  // namespace OHOS::se::security
\ No newline at end of file
@@ -15,6 +15,8 @@
 #ifndef RESPONSE_ALL_AR_DO_H
 #define RESPONSE_ALL_AR_DO_H
 
+#include <cstddef>
+#include <string>
 #include <vector>
 
 #include "ber_tlv.h"
@@ -37,5 +39,32 @@ public:
 private:
     std::vector<RefArDo> refArDoArray_;
 };
+
+/*
+ * Assembles the Response-ALL-AR-DO from the responses of GET DATA [All] and GET DATA [Next].
+ * The tag and the length are parsed from the first response and the buffer takes the full size at once.
+ * Each REF-AR-DO is parsed as soon as it is complete, while the next responses are still to come.
+ */
+class ResponseAllArDoAssembler {
+public:
+    ResponseAllArDoAssembler();
+    ~ResponseAllArDoAssembler();
+    // the first response starts with the tag and the length of the Response-ALL-AR-DO
+    void Append(const std::string& response);
+    bool IsComplete() const;
+    std::vector<RefArDo> GetRefArDoArray();
+
+private:
+    void ParseRefArDos();
+
+private:
+    std::string data_;
+    bool started_;
+    // end of the Response-ALL-AR-DO in data_
+    size_t end_;
+    // offset of the first REF-AR-DO not parsed yet
+    size_t parsed_;
+    std::vector<RefArDo> refArDoArray_;
+};
 }  // namespace OHOS::se::security
 #endif /* RESPONSE_ALL_AR_DO_H */
@@ -14,17 +14,19 @@
  */
 #include "der_parser.h"
 
+#include <utility>
+
 #include "loghelper.h"
 #include "se_common_exception.h"
 
 namespace OHOS::se::security {
 DerParser::DerParser(std::string data) : derData_(""), derSize_(0), derIndex_(0), tlvDataSize_(0)
 {
-    derData_ = data;
+    derData_ = std::move(data);
     derIndex_ = 0;
     derSize_ = 0;
-    if (!data.empty()) {
-        derSize_ = data.length();
+    if (!derData_.empty()) {
+        derSize_ = derData_.length();
         tlvDataSize_ = derSize_;
         if (derData_[derIndex_] == ASN1_PADDING) {
             tlvDataSize_ = 0;
@@ -88,10 +90,8 @@ std::string DerParser::GetTlvData()
 
 std::vector<int> DerParser::TakeSnapshot()
 {
-    std::vector<int> snapshot;
-    snapshot.push_back(derIndex_);
-    snapshot.push_back(tlvDataSize_);
-    return snapshot;
+    Position position = GetPosition();
+    return std::vector<int>{position.index_, position.tlvDataSize_};
 }
 
 void DerParser::RestoreSnapshot(std::vector<int> snapshot)
@@ -100,12 +100,22 @@ void DerParser::RestoreSnapshot(std::vector<int> snapshot)
         DebugLog("Invalid snapshot");
         throw AccessControlError("Invalid snapshot");
     }
-    if (snapshot[0] < 0 || snapshot[0] > derSize_) {
+    SetPosition(Position{snapshot[0], snapshot[1]});
+}
+
+DerParser::Position DerParser::GetPosition() const
+{
+    return Position{derIndex_, tlvDataSize_};
+}
+
+void DerParser::SetPosition(const Position& position)
+{
+    if (position.index_ < 0 || position.index_ > derSize_) {
         DebugLog("Out of index");
         throw AccessControlError("Out of index");
     }
-    derIndex_ = snapshot[0];
-    tlvDataSize_ = snapshot[1];
+    derIndex_ = position.index_;
+    tlvDataSize_ = position.tlvDataSize_;
 }
 
 std::string DerParser::ParseOid()
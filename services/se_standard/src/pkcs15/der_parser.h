@@ -34,6 +34,12 @@ public:
     static const auto ASN1_APPL_TEMPLATE = 0x61;
     static const auto ASN1_FCP = 0x62;
     static const auto ASN1_PADDING = 0xFF;
+    // where the parser is in the data, to come back to
+    class Position final {
+    public:
+        int index_;
+        int tlvDataSize_;
+    };
     DerParser(std::string data);
     ~DerParser();
     bool IsEnd();
@@ -43,6 +49,8 @@ public:
     std::string GetTlvData();
     std::vector<int> TakeSnapshot();
     void RestoreSnapshot(std::vector<int> snapshot);
+    Position GetPosition() const;
+    void SetPosition(const Position& position);
     std::string ParseOid();
     std::string ParsePath();
     int GetTlvType();
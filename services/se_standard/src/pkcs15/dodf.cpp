@@ -14,6 +14,8 @@
  */
 #include "dodf.h"
 
+#include <utility>
+
 #include "access_rule_files_channel.h"
 #include "der_parser.h"
 #include "ef.h"
@@ -41,7 +43,7 @@ std::string DODF::ReadDataFromPath(std::string path)
 std::string DODF::AnalyzeData(std::string data)
 {
     DebugLog("DODF analyze data");
-    DerParser der = DerParser(data);
+    DerParser der = DerParser(std::move(data));
     while (!der.IsEnd()) {
         if (der.ParseTlv() == 0xA1) {
             der.ParseTlv(DerParser::ASN1_SEQUENCE);
@@ -56,11 +58,11 @@ std::string DODF::AnalyzeData(std::string data)
             }
             if (tag == 0xA1) {
                 der.ParseTlv(DerParser::ASN1_SEQUENCE);
-                std::vector<int> snapshot = der.TakeSnapshot();
+                DerParser::Position position = der.GetPosition();
                 if (der.ParseOid() == AC_OID) {
                     return der.ParsePath();
                 } else {
-                    der.RestoreSnapshot(snapshot);
+                    der.SetPosition(position);
                     der.SkipTlvData();
                 }
             } else {
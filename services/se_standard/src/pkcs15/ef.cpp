@@ -95,21 +95,32 @@ std::string EF::ReadData(int offset, int len)
 
     std::string result = "";
     int length = 0;
-    std::string cmd = {0x00, (char)0xB0, 0x00, 0x00, 0x00};
     std::shared_ptr<AccessRuleFilesChannel> arfChannel = arfChannel_.lock();
     if (!arfChannel) {
         DebugLog("ArfChannel has expired");
         throw SecureElementError("ArfChannel has expired");
     }
-    while (len != 0) {
-        if (len < 253) {
-            length = len;
-        } else {
-            length = 253;
+    while (len > 0) {
+        if (len > MAX_SHORT_READ_LENGTH && arfChannel->IsExtendedLengthSupported()) {
+            length = (len < MAX_EXTENDED_READ_LENGTH) ? len : MAX_EXTENDED_READ_LENGTH;
+            std::string cmd = {0x00, (char)0xB0, (char)((offset >> 8) & 0xFF), (char)(offset & 0xFF), 0x00,
+                               (char)((length >> 8) & 0xFF), (char)(length & 0xFF)};
+            std::string res = arfChannel->Transmit(cmd);
+            int received = (res.length() > 2) ? static_cast<int>(res.length() - 2) : 0;
+            if (received == 0) {
+                DebugLog("Extended length read refused, read in short chunks");
+                arfChannel->SetExtendedLengthSupported(false);
+                continue;
+            }
+            received = (received < length) ? received : length;
+            result += res.substr(0, received);
+            len -= received;
+            offset += received;
+            continue;
         }
-        cmd[2] = (char)((offset >> 8) & 0xFF);
-        cmd[3] = (char)(offset & 0xFF);
-        cmd[4] = (char)(length & 0xFF);
+        length = (len < MAX_SHORT_READ_LENGTH) ? len : MAX_SHORT_READ_LENGTH;
+        std::string cmd = {0x00, (char)0xB0, (char)((offset >> 8) & 0xFF), (char)(offset & 0xFF),
+                           (char)(length & 0xFF)};
         std::string res = arfChannel->Transmit(cmd);
         result += res.substr(0, length);
         len -= length;
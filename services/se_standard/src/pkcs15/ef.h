@@ -31,6 +31,9 @@ public:
     static const auto FILE_STRUCTURE_LINEAR_FIXED = 0x01;
     static const auto FILE_UNKNOWN = 0xFF;
     static const auto APDU_SUCCESS = 0x9000;
+    static const int MAX_SHORT_READ_LENGTH = 253;
+    // READ BINARY with an extended Le, bounded for the buffers of the cards
+    static const int MAX_EXTENDED_READ_LENGTH = 4096;
     explicit EF(std::weak_ptr<AccessRuleFilesChannel> arfChannel);
     ~EF();
     int SelectFilePath(std::string path);
@@ -108,6 +108,13 @@ std::weak_ptr<SESChannelAccess> SeChannel::GetChannelAccess()
 void SeChannel::SetChannelAccess(std::weak_ptr<SESChannelAccess> channelAccess)
 {
     mChannelAccess_ = channelAccess.lock();
+    mApduFilterSet_ = mChannelAccess_ ? mChannelAccess_->GetApduFilterSet()
+                                      : std::shared_ptr<const security::ApduFilterSet>();
+}
+
+std::shared_ptr<const security::ApduFilterSet> SeChannel::GetApduFilterSet()
+{
+    return mApduFilterSet_;
 }
 
 bool SeChannel::HasSelectedAid()
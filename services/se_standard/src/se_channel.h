@@ -23,6 +23,7 @@
 #include "secure_element_session.h"
 
 namespace OHOS::se::security {
+class ApduFilterSet;
 class ChannelAccessRule;
 }
 
@@ -39,6 +40,8 @@ public:
     std::string Transmit(std::string command);
     std::weak_ptr<SESChannelAccess> GetChannelAccess();
     void SetChannelAccess(std::weak_ptr<SESChannelAccess> channelAccess);
+    // the compiled APDU filters of the channel access, null without filters
+    std::shared_ptr<const security::ApduFilterSet> GetApduFilterSet();
     bool HasSelectedAid();
     int GetChannelNumber();
     std::string GetSelectResponse();
@@ -64,6 +67,7 @@ private:
     std::weak_ptr<Terminal> mTerminal_{};
     std::string mSelectResponse_{};
     std::shared_ptr<SESChannelAccess> mChannelAccess_{};
+    std::shared_ptr<const security::ApduFilterSet> mApduFilterSet_{};
     sptr<ISEChannel> iChannel_{};
     wptr<SecureElementSession> seSession_{};
     int mCallingPid{0};
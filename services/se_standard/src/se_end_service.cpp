@@ -17,18 +17,59 @@
 #include <string>
 
 #include "bundle_manager.h"
+#include "common_event_manager.h"
 #include "context.h"
 #include "loghelper.h"
 #include "se_common_exception.h"
 #include "secure_element_service.h"
 #include "terminal.h"
+#include "want.h"
 
 using osal::Context;
 namespace OHOS {
+using EventFwk::CommonEventData;
+using EventFwk::CommonEventManager;
+using EventFwk::CommonEventSubscribeInfo;
+using EventFwk::CommonEventSubscriber;
+using EventFwk::MatchingSkills;
+// Package Common Event
+const std::string ACTION_PACKAGE_REMOVED = "ohos.intent.action.PACKAGE_REMOVED";
+const std::string ACTION_PACKAGE_ADDED = "ohos.intent.action.PACKAGE_ADDED";
+const std::string ACTION_PACKAGE_CHANGED = "ohos.intent.action.PACKAGE_CHANGED";
+// Package Common Event Permission
+const std::string ACTION_PACKAGE_PERMISSION = "package";
+
 namespace se {
+class SeEndService::PackageChangeReceive : public CommonEventSubscriber {
+public:
+    explicit PackageChangeReceive(std::weak_ptr<SeEndService> service, const CommonEventSubscribeInfo& subscribeInfo)
+        : CommonEventSubscriber(subscribeInfo), mSEService_(service)
+    {
+    }
+    ~PackageChangeReceive() {}
+    void OnReceiveEvent(const CommonEventData& data) override
+    {
+        std::string action = data.GetWant().GetAction();
+        if (action.compare(ACTION_PACKAGE_REMOVED) != 0 && action.compare(ACTION_PACKAGE_ADDED) != 0 &&
+            action.compare(ACTION_PACKAGE_CHANGED) != 0) {
+            return;
+        }
+        std::shared_ptr<SeEndService> service = mSEService_.lock();
+        if (service) {
+            service->OnBundleChanged(data.GetWant().GetElement().GetBundleName());
+        }
+    }
+
+private:
+    std::weak_ptr<SeEndService> mSEService_;
+};
+
 SeEndService::~SeEndService()
 {
     DebugLog("SeEndService::OnDestroy");
+    if (mPkgReceiver_) {
+        CommonEventManager::UnSubscribeCommonEvent(mPkgReceiver_);
+    }
     DestructionTerminals();
     if (mSecureElementService_) {
         mSecureElementService_ = nullptr;
@@ -45,6 +86,17 @@ bool SeEndService::Init(std::shared_ptr<Context> context)
         // Create Secure Element Service
         mSecureElementService_ = new SecureElementService(shared_from_this(), mTerminals_);
     }
+    // Subscribe Package Change Receive
+    if (!mPkgReceiver_) {
+        MatchingSkills pkMatchingSkills;
+        pkMatchingSkills.AddEvent(ACTION_PACKAGE_ADDED);
+        pkMatchingSkills.AddEvent(ACTION_PACKAGE_REMOVED);
+        pkMatchingSkills.AddEvent(ACTION_PACKAGE_CHANGED);
+        CommonEventSubscribeInfo pkSubscribeInfo(pkMatchingSkills);
+        pkSubscribeInfo.SetPermission(ACTION_PACKAGE_PERMISSION);
+        mPkgReceiver_ = std::make_shared<PackageChangeReceive>(shared_from_this(), pkSubscribeInfo);
+        CommonEventManager::SubscribeCommonEvent(mPkgReceiver_);
+    }
     InfoLog("SeEndService::Init success.");
     return true;
 }
@@ -66,6 +118,14 @@ std::string SeEndService::GetBundleNameFromCallingUid(int uid)
     throw AccessControlError("BundleName can not be determined");
 }
 
+void SeEndService::OnBundleChanged(const std::string& bundleName)
+{
+    DebugLog("SeEndService::OnBundleChanged %s", bundleName.c_str());
+    for (IdTerminalPair& terminal : mTerminals_) {
+        terminal.second->OnBundleChanged(bundleName);
+    }
+}
+
 /**
  * @brief Destruction All Terminals
  */
@@ -26,6 +26,9 @@ class BundleManager;
 }  // namespace osal
 
 namespace OHOS {
+namespace EventFwk {
+class CommonEventSubscriber;
+}  // namespace EventFwk
 namespace se {
 class Terminal;
 class SecureElementService;
@@ -33,6 +36,9 @@ using IdTerminalPair = std::pair<std::string, std::shared_ptr<Terminal>>;
 using TerminalTable = std::vector<IdTerminalPair>;
 
 class SeEndService final : public std::enable_shared_from_this<SeEndService> {
+    // the Receiver of the package changes, the access decisions of the changed bundle are dropped
+    class PackageChangeReceive;
+
 public:
     ~SeEndService();
     std::weak_ptr<osal::BundleManager> GetBundleManager();
@@ -53,6 +59,11 @@ private:
      * @param terminalName the se name
      */
     void AddTerminal(const std::string& terminalName);
+    /**
+     * @brief Drops the access decisions made for the bundle by all terminals
+     * @param bundleName the changed bundle, empty if it is unknown
+     */
+    void OnBundleChanged(const std::string& bundleName);
 
 public:
     static constexpr const auto UICC_TERMINAL{"SIM"};
@@ -63,6 +74,7 @@ private:
     std::shared_ptr<osal::Context> context_{};
     // The vector will maintain SE Hal Terminals
     TerminalTable mTerminals_{};
+    std::shared_ptr<EventFwk::CommonEventSubscriber> mPkgReceiver_{};
 
     friend class SecureElementService;
     friend class SecureElementReader;
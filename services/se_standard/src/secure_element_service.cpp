@@ -71,6 +71,19 @@ std::vector<std::string> SecureElementService::GetReaders()
     }
     return readers;
 }
+/**
+ * @brief Dumps the state of the terminals, the hit rate of the channel access decisions among others.
+ * @param fd the file the dump is written to
+ * @param args the arguments of the dump, unused
+ * @return ERR_NONE
+ */
+int SecureElementService::Dump(int fd, const std::vector<std::u16string>& args)
+{
+    for (IdTerminalPair terminalPair : mTerminals_) {
+        terminalPair.second->Dump(fd);
+    }
+    return ERR_NONE;
+}
 /**
  * @brief Get the reader that provides this session.
  * @param readerName the reader name
@@ -60,6 +60,13 @@ public:
     std::vector<bool> IsNfcEventAllowed(const std::string& readerName,
                                         const std::string& cAid,
                                         std::vector<std::string> packageNames) override;
+    /**
+     * @brief Dumps the state of the terminals, the hit rate of the channel access decisions among others.
+     * @param fd the file the dump is written to
+     * @param args the arguments of the dump, unused
+     * @return ERR_NONE
+     */
+    int Dump(int fd, const std::vector<std::u16string>& args) override;
 
 private:
     explicit SecureElementService(std::weak_ptr<SeEndService> service, std::vector<IdTerminalPair>& table);
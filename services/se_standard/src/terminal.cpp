@@ -16,12 +16,15 @@
 
 #include <sys/time.h>
 
+#include <chrono>
+#include <cstdio>
 #include <sstream>
 #include <stdexcept>
 
 #include "access_control_enforcer.h"
 #include "bundle_manager.h"
 #include "channel_access_rule.h"
+#include "common_event_manager.h"
 #include "context.h"
 #include "event_handler.h"
 #include "isecure_element.h"
@@ -33,6 +36,7 @@
 #include "secure_element_channel_stub.h"
 #include "secure_element_service.h"
 #include "utils/common_utils.h"
+#include "want.h"
 
 using namespace osal;
 using ChannelAccessRule = OHOS::se::security::ChannelAccessRule;
@@ -44,6 +48,10 @@ namespace OHOS {
 using AppExecFwk::EventHandler;
 using AppExecFwk::EventRunner;
 namespace se {
+// subscribed by the NFC service
+static const std::string ACTION_SE_ACCESS_RULES_CHANGED = "ohos.nfc.action.SE_ACCESS_RULES_CHANGED";
+static const std::string KEY_SE_NAME = "seName";
+
 static uint64_t GetExpireTimeMicros(uint64_t delay)
 {
     struct timeval tv = {0, 0};
@@ -51,7 +59,8 @@ static uint64_t GetExpireTimeMicros(uint64_t delay)
     return (tv.tv_sec * 1000 + tv.tv_usec / 1000 + delay);
 }
 /**
- * @brief To Get HAL service terminated abnormally regularly.
+ * @brief To Get HAL service terminated abnormally regularly, and to check the refresh tag of the access rules off
+ * the channel opening path.
  *
  */
 class Terminal::GetHalHandler : public AppExecFwk::EventHandler {
@@ -75,6 +84,20 @@ public:
                 }
                 break;
             }
+            case EVENT_INITIALIZE_AC: {
+                std::shared_ptr<Terminal> terminal = mTerminal_.lock();
+                if (terminal) {
+                    terminal->InitializeACInBackground();
+                }
+                break;
+            }
+            case EVENT_CHECK_REFRESH_TAG: {
+                std::shared_ptr<Terminal> terminal = mTerminal_.lock();
+                if (terminal) {
+                    terminal->CheckRefreshTag();
+                }
+                break;
+            }
             default:
                 break;
         }
@@ -94,12 +117,14 @@ public:
     {
         std::shared_ptr<Terminal> terminal = mTerminal_.lock();
         DebugLog("%s died.", terminal->mName_.c_str());
+        std::shared_ptr<AccessControlEnforcer> accessControlEnforcer;
         {
             std::lock_guard<std::recursive_mutex> lock(terminal->mLock_);
             terminal->mIsConnected_ = false;
-            if (terminal->mAccessControlEnforcer_) {
-                terminal->mAccessControlEnforcer_->Reset();
-            }
+            accessControlEnforcer = terminal->mAccessControlEnforcer_;
+        }
+        if (accessControlEnforcer) {
+            accessControlEnforcer->Reset();
         }
 
         terminal->mHandler_->SendTimingEvent(EVENT_GET_HAL, GetExpireTimeMicros(GET_SERVICE_DELAY_MILLIS));
@@ -133,24 +158,109 @@ private:
 
 void Terminal::StateChange(bool state, std::string reason)
 {
-    std::lock_guard<std::recursive_mutex> lock(mLock_);
-
-    InfoLog("OnStateChange: %d reason: %s", state, reason.c_str());
-    mIsConnected_ = state;
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mLock_);
+        InfoLog("OnStateChange: %d reason: %s", state, reason.c_str());
+        mIsConnected_ = state;
+        if (state) {
+            CloseChannels();
+            mDefaultAppOnBasicChannel_ = true;
+        }
+        accessControlEnforcer = mAccessControlEnforcer_;
+    }
     if (!state) {
-        if (mAccessControlEnforcer_) {
-            mAccessControlEnforcer_->Reset();
+        if (accessControlEnforcer) {
+            accessControlEnforcer->Reset();
         }
         return;
     }
+    ScheduleInitializeAC();
+}
 
-    CloseChannels();
+/**
+ * @brief Initializes the Access Control on the handler, off the callback of the HAL and the first channel opening.
+ * Without the handler it is initialized at once.
+ */
+void Terminal::ScheduleInitializeAC()
+{
+    if (mHandler_) {
+        std::lock_guard<std::mutex> lock(mAcInitLock_);
+        if (mAcInitPending_) {
+            return;
+        }
+        mAcInitPending_ = true;
+        mHandler_->SendEvent(EVENT_INITIALIZE_AC);
+        return;
+    }
     try {
         InitializeAC();
     } catch (const std::exception& e) {
         DebugLog("StateChange: InitializeAC Is Failed. %s", e.what());
     }
-    mDefaultAppOnBasicChannel_ = true;
+}
+
+void Terminal::InitializeACInBackground()
+{
+    {
+        std::lock_guard<std::mutex> lock(mAcInitLock_);
+        if (!mAcInitPending_) {
+            // initialized already by a waiter on the handler
+            return;
+        }
+    }
+    try {
+        InitializeAC();
+    } catch (const std::exception& e) {
+        DebugLog("StateChange: InitializeAC Is Failed. %s", e.what());
+    }
+    std::lock_guard<std::mutex> lock(mAcInitLock_);
+    mAcInitPending_ = false;
+    mAcInitCond_.notify_all();
+}
+
+/**
+ * @brief Waits for the Access Control initialized in the background, it is not called with mLock_ held as the
+ * initialization takes it. On the handler the pending initialization is run at once, it is queued behind the
+ * current event.
+ * @return false if it is not initialized within AC_INIT_TIMEOUT_MILLIS
+ */
+bool Terminal::WaitForAccessControl()
+{
+    if (mHandler_ && mHandler_->GetEventRunner() == AppExecFwk::EventRunner::Current()) {
+        InitializeACInBackground();
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(mAcInitLock_);
+    return mAcInitCond_.wait_for(lock, std::chrono::milliseconds(AC_INIT_TIMEOUT_MILLIS),
+                                 [this]() { return !mAcInitPending_; });
+}
+
+/**
+ * @brief The Access Control enforcer is replaced by InitializeAC on the handler, it is copied under mLock_
+ * @return the current enforcer, nullptr if it is not initialized
+ */
+std::shared_ptr<AccessControlEnforcer> Terminal::CurrentAccessControlEnforcer()
+{
+    std::lock_guard<std::recursive_mutex> lock(mLock_);
+    return mAccessControlEnforcer_;
+}
+
+/**
+ * @brief Tells the NFC service the access rules of the SE were re-read, it drops the packages it allowed to receive
+ * the NFC events of the SE.
+ * @param seName the name of the SE
+ */
+static void PublishAccessRulesChanged(const std::string& seName)
+{
+    AAFwk::Want want;
+    want.SetAction(ACTION_SE_ACCESS_RULES_CHANGED);
+    want.SetParam(KEY_SE_NAME, seName);
+    EventFwk::CommonEventData data;
+    data.SetWant(want);
+    if (!EventFwk::CommonEventManager::PublishCommonEvent(data)) {
+        ErrorLog("Publish access rules changed of %s failed", seName.c_str());
+    }
 }
 
 /**
@@ -158,17 +268,30 @@ void Terminal::StateChange(bool state, std::string reason)
  */
 void Terminal::InitializeAC()
 {
-    std::lock_guard<std::recursive_mutex> lock(mLock_);
-    if (!mAccessControlEnforcer_) {
-        mAccessControlEnforcer_ = std::make_shared<AccessControlEnforcer>(shared_from_this());
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mLock_);
+        if (!mAccessControlEnforcer_) {
+            mAccessControlEnforcer_ = std::make_shared<AccessControlEnforcer>(shared_from_this());
+            std::string seName = mName_;
+            mAccessControlEnforcer_->SetRulesChangedListener([seName]() { PublishAccessRulesChanged(seName); });
+        }
+        accessControlEnforcer = mAccessControlEnforcer_;
     }
+    // dropped unless it was replaced meanwhile
+    auto dropAccessControlEnforcer = [this, &accessControlEnforcer]() {
+        std::lock_guard<std::recursive_mutex> lock(mLock_);
+        if (mAccessControlEnforcer_ == accessControlEnforcer) {
+            mAccessControlEnforcer_ = std::shared_ptr<AccessControlEnforcer>();
+        }
+    };
     try {
-        mAccessControlEnforcer_->Initialize();
+        accessControlEnforcer->Initialize();
     } catch (const IOError& e) {
-        mAccessControlEnforcer_ = std::shared_ptr<AccessControlEnforcer>();
+        dropAccessControlEnforcer();
         throw e;
     } catch (const MissingResourceError& e) {
-        mAccessControlEnforcer_ = std::shared_ptr<AccessControlEnforcer>();
+        dropAccessControlEnforcer();
         throw e;
     }
 }
@@ -183,25 +306,34 @@ void Terminal::InitializeAC()
  */
 std::shared_ptr<ChannelAccessRule> Terminal::EstablishChannelAccess(std::string aid, std::string bundleName, int pid)
 {
-    bool isRefreshTag = true;
     if (HasPrivilegedPermission(bundleName)) {
         return ChannelAccessRule::GetPrivilegeAccessRule(bundleName, pid);
     }
-    if (!mAccessControlEnforcer_ || mAccessControlEnforcer_->IsNoRuleFound()) {
+    if (!WaitForAccessControl()) {
+        throw SecurityError("Access control of " + mName_ + " is not initialized within " +
+                            std::to_string(AC_INIT_TIMEOUT_MILLIS) + " ms");
+    }
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = CurrentAccessControlEnforcer();
+    if (!accessControlEnforcer || accessControlEnforcer->IsNoRuleFound()) {
         InitializeAC();
-        isRefreshTag = false;
+        accessControlEnforcer = CurrentAccessControlEnforcer();
+        if (!accessControlEnforcer) {
+            throw SecurityError("Access control of " + mName_ + " is not initialized");
+        }
+    } else {
+        // the channel is opened with the current rules, the refresh tag is checked in the background
+        ScheduleRefreshTagCheck();
     }
-    mAccessControlEnforcer_->SetBundleManager(mContext_.lock()->GetBundleManager());
+    accessControlEnforcer->SetBundleManager(mContext_.lock()->GetBundleManager());
 
     if (0 == GetName().compare(0, std::string(SeEndService::UICC_TERMINAL).length(), SeEndService::UICC_TERMINAL) &&
         HasCarrierPrivilegedPermission(bundleName)) {
         return ChannelAccessRule::GetCarrierPrivilegeAccessRule(bundleName, pid);
     }
 
-    std::lock_guard<std::recursive_mutex> lock(mLock_);
     try {
         std::shared_ptr<ChannelAccessRule> channelAccessRule =
-            mAccessControlEnforcer_->EstablishChannelAccessRuleForBundle(aid, bundleName, isRefreshTag);
+            accessControlEnforcer->EstablishChannelAccessRuleForBundle(aid, bundleName, false);
         channelAccessRule->SetCallingPid(pid);
         return channelAccessRule;
     } catch (const IOError& e) {
@@ -391,11 +523,12 @@ void Terminal::SelectDefaultApplication()
     try {
         SelectApplet("");
     } catch (const NoSuchElementError& e) {
-        if (!mAccessControlEnforcer_) {
+        std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = CurrentAccessControlEnforcer();
+        if (!accessControlEnforcer) {
             return;
         }
         try {
-            SelectApplet(mAccessControlEnforcer_->GetDefaultAccessControlAid());
+            SelectApplet(accessControlEnforcer->GetDefaultAccessControlAid());
         } catch (const std::exception& ignore) {
             DebugLog("ignore exception: %s", ignore.what());
         }
@@ -667,7 +800,12 @@ std::vector<bool> Terminal::IsNfcEventAllowed(std::weak_ptr<osal::BundleManager>
                                               std::string aid,
                                               std::vector<std::string> bundleNames)
 {
-    if (!mAccessControlEnforcer_ || mAccessControlEnforcer_->IsNoRuleFound()) {
+    if (!WaitForAccessControl()) {
+        InfoLog("isNfcEventAllowed: access control is not initialized");
+        return std::vector<bool>();
+    }
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = CurrentAccessControlEnforcer();
+    if (!accessControlEnforcer || accessControlEnforcer->IsNoRuleFound()) {
         /**
          * If it failed due to a kind of temporary failure or no rule was found in the previous attempt. Attempt to
          * initialize the access control enforcer.
@@ -678,18 +816,20 @@ std::vector<bool> Terminal::IsNfcEventAllowed(std::weak_ptr<osal::BundleManager>
             InfoLog("isNfcEventAllowed Exception: %s", e.what());
             return std::vector<bool>();
         }
-    }
-    mAccessControlEnforcer_->SetBundleManager(bundleManager);
-
-    {
-        std::lock_guard<std::recursive_mutex> lock(mLock_);
-        try {
-            return mAccessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames);
-        } catch (const std::exception& e) {
-            InfoLog("isNfcEventAllowed Exception: %s", e.what());
+        accessControlEnforcer = CurrentAccessControlEnforcer();
+        if (!accessControlEnforcer) {
+            InfoLog("isNfcEventAllowed: access control is not initialized");
             return std::vector<bool>();
         }
     }
+    accessControlEnforcer->SetBundleManager(bundleManager);
+
+    try {
+        return accessControlEnforcer->IsNfcEventAllowed(aid, bundleNames);
+    } catch (const std::exception& e) {
+        InfoLog("isNfcEventAllowed Exception: %s", e.what());
+        return std::vector<bool>();
+    }
 }
 
 /**
@@ -713,19 +853,28 @@ bool Terminal::IsSecureElementPresent()
  */
 bool Terminal::CheckCarrierPrivilegeRules(std::weak_ptr<BundleInfo> bundleInfo)
 {
-    bool isRefreshTag = true;
-    if (!mAccessControlEnforcer_ || mAccessControlEnforcer_->IsNoRuleFound()) {
+    if (!WaitForAccessControl()) {
+        InfoLog("Check Carrier Privilege: access control is not initialized");
+        return false;
+    }
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = CurrentAccessControlEnforcer();
+    if (!accessControlEnforcer || accessControlEnforcer->IsNoRuleFound()) {
         try {
             InitializeAC();
         } catch (const IOError& e) {
             return false;
         }
-        isRefreshTag = false;
+        accessControlEnforcer = CurrentAccessControlEnforcer();
+        if (!accessControlEnforcer) {
+            return false;
+        }
+    } else {
+        ScheduleRefreshTagCheck();
     }
-    mAccessControlEnforcer_->SetBundleManager(mContext_.lock()->GetBundleManager());
+    accessControlEnforcer->SetBundleManager(mContext_.lock()->GetBundleManager());
 
     try {
-        return mAccessControlEnforcer_->CheckCarrierPrivilege(bundleInfo, isRefreshTag);
+        return accessControlEnforcer->CheckCarrierPrivilege(bundleInfo, false);
     } catch (const std::exception& e) {
         InfoLog("Check Carrier Privilege Exception: %s", e.what());
         return false;
@@ -736,7 +885,12 @@ bool Terminal::Reset()
 {
     try {
         SecureElementStatus status = mSEHal_->Reset();
-        return (SecureElementStatus::SUCCESS == status);
+        if (SecureElementStatus::SUCCESS != status) {
+            return false;
+        }
+        // the applets of the SE may be updated while it is reset
+        RequestAccessRulesRefresh();
+        return true;
     } catch (const RemoteError& e) {
         ErrorLog("Error in isSecureElementPresent() %s", e.what());
         return false;
@@ -749,9 +903,84 @@ void Terminal::ResetDefaultAppState()
     mDefaultAppOnBasicChannel_ = true;
 }
 
+void Terminal::RequestAccessRulesRefresh()
+{
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = CurrentAccessControlEnforcer();
+    if (!accessControlEnforcer) {
+        // the rules are read when the enforcer is initialized
+        return;
+    }
+    accessControlEnforcer->RequestRefreshTagCheck();
+    ScheduleRefreshTagCheck();
+}
+
+void Terminal::OnBundleChanged(const std::string& bundleName)
+{
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = CurrentAccessControlEnforcer();
+    if (accessControlEnforcer) {
+        accessControlEnforcer->OnBundleChanged(bundleName);
+    }
+}
+
+void Terminal::Dump(int fd)
+{
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = CurrentAccessControlEnforcer();
+    if (!accessControlEnforcer) {
+        dprintf(fd, "terminal: %s, access control is not initialized\n", mName_.c_str());
+        return;
+    }
+    security::ChannelAccessDecisionStats stats = accessControlEnforcer->GetChannelAccessDecisionStats();
+    dprintf(fd,
+            "terminal: %s, channel access decisions, hits: %llu, misses: %llu, hit rate: %.1f%%, saved: %llu us\n",
+            mName_.c_str(),
+            static_cast<unsigned long long>(stats.hits_),
+            static_cast<unsigned long long>(stats.misses_),
+            stats.GetHitRate() * 100,
+            static_cast<unsigned long long>(stats.savedUs_));
+}
+
+/**
+ * @brief Sends the refresh tag check to the handler when the check interval passed or a check is requested, one
+ * check is pending at most.
+ */
+void Terminal::ScheduleRefreshTagCheck()
+{
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = CurrentAccessControlEnforcer();
+    if (!mHandler_ || !accessControlEnforcer || !accessControlEnforcer->IsRefreshTagCheckDue()) {
+        return;
+    }
+    if (mRefreshTagCheckScheduled_.exchange(true)) {
+        return;
+    }
+    mHandler_->SendEvent(EVENT_CHECK_REFRESH_TAG);
+}
+
+void Terminal::CheckRefreshTag()
+{
+    mRefreshTagCheckScheduled_ = false;
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mLock_);
+        if (!mIsConnected_) {
+            return;
+        }
+        accessControlEnforcer = mAccessControlEnforcer_;
+    }
+    if (!accessControlEnforcer) {
+        return;
+    }
+    // the ARA-M or the ARF is read without mLock_ but under the lock of the enforcer: the open channels transmit
+    // meanwhile, the channels to open wait for the check to finish
+    try {
+        accessControlEnforcer->CheckRefreshTagIfDue();
+    } catch (const std::exception& e) {
+        InfoLog("Check refresh tag Exception: %s", e.what());
+    }
+}
+
 std::weak_ptr<AccessControlEnforcer> Terminal::GetAccessControlEnforcer()
 {
-    return mAccessControlEnforcer_;
+    return CurrentAccessControlEnforcer();
 }
 
 std::weak_ptr<osal::Context> Terminal::GetContext()
@@ -15,6 +15,8 @@
 #ifndef TERMINAL_H
 #define TERMINAL_H
 
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -82,6 +84,15 @@ public:
                                         std::vector<std::string> bundleNames);
     bool IsSecureElementPresent();
     bool CheckCarrierPrivilegeRules(std::weak_ptr<osal::BundleInfo> pInfo);
+    /**
+     * @brief Checks the refresh tag of the access rules in the background, regardless of the check interval. The
+     * rules are re-read when the tag changed.
+     */
+    void RequestAccessRulesRefresh();
+    // the bundle is installed, updated or removed, the decisions made for it are dropped
+    void OnBundleChanged(const std::string& bundleName);
+    // writes the state of the access control, the counters of the channel access decisions among others
+    void Dump(int fd);
 
 private:
     void Initialize(const sptr<ISecureElement>& seHalService);
@@ -96,6 +107,12 @@ private:
     std::string TransmitInternal(const std::string& cmd);
     bool Reset();
     void ResetDefaultAppState();
+    void ScheduleInitializeAC();
+    void InitializeACInBackground();
+    bool WaitForAccessControl();
+    void ScheduleRefreshTagCheck();
+    void CheckRefreshTag();
+    std::shared_ptr<AccessControlEnforcer> CurrentAccessControlEnforcer();
 
 private:
     bool mIsConnected_{false};
@@ -107,6 +124,10 @@ private:
      * @brief All Channels About the terminal
      */
     std::map<int, std::shared_ptr<SeChannel>> mChannels_{};
+    /**
+     * @brief Guards the channels and the HAL. The enforcer reads the rules through the channels while holding its
+     * own lock, so the enforcer is never called with mLock_ held.
+     */
     std::recursive_mutex mLock_{};
     std::weak_ptr<osal::Context> mContext_{};
     bool mDefaultAppOnBasicChannel_{true};
@@ -124,9 +145,19 @@ private:
     std::shared_ptr<AccessControlEnforcer> mAccessControlEnforcer_{};
     sptr<IRemoteObject::DeathRecipient> mDeathRecipient_{};
     std::shared_ptr<GetHalHandler> mHandler_{};
+    std::atomic<bool> mRefreshTagCheckScheduled_{false};
+    /**
+     * @brief The access control is initialized on the handler when the SE connects, the first users wait for it
+     */
+    std::mutex mAcInitLock_{};
+    std::condition_variable mAcInitCond_{};
+    bool mAcInitPending_{false};
 
     static const uint64_t GET_SERVICE_DELAY_MILLIS{4 * 1000};
     static const uint32_t EVENT_GET_HAL{1};
+    static const uint32_t EVENT_CHECK_REFRESH_TAG{2};
+    static const uint32_t EVENT_INITIALIZE_AC{3};
+    static const uint64_t AC_INIT_TIMEOUT_MILLIS{5 * 1000};
     const std::string SECURE_ELEMENT_PRIVILEGED_OPERATION_PERMISSION{
         "ohos.permission.SECURE_ELEMENT_PRIVILEGED_OPERATION"};
 
@@ -23,6 +23,8 @@
 
 #define private public
 #include "access_rule_application_controller.h"
+#include "access_rule_cache.h"
+#include "access_rule_cache_store.h"
 #include "access_rule_data_common.h"
 #include "base_test.h"
 #include "bundle_manager.h"
@@ -31,6 +33,7 @@
 #include "isecure_element_mock.h"
 #include "osal_bundle_info.h"
 #include "se_channel.h"
+#include "se_common_exception.h"
 #include "secure_element_session.h"
 #include "terminal.h"
 #undef private
@@ -647,4 +650,279 @@ TEST_F(AccessControlEnforcerTest, CheckCarrierPrivilege_NoBundleName_Test)
         EXPECT_TRUE(true);
     }
 }
-}  // namespace OHOS::se::test
\ No newline at end of file
+
+/**
+ * @tc.number    : ACCESS_CONTROL_ENFORCER_TEST_026
+ * @tc.name      : IsNfcEventAllowed_Cached_Test
+ * @tc.desc      : The nfc event decisions are kept until the signatures of the bundle or the access rules change
+ */
+TEST_F(AccessControlEnforcerTest, IsNfcEventAllowed_Cached_Test)
+{
+    try {
+        std::string apduSuccess = {(char)0x90, 0x00};
+        std::unique_ptr<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData> resData(
+            std::make_unique<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData>());
+        resData->status = SEStatus::SUCCESS;
+        resData->channelNumber = 1;
+        resData->resp = apduSuccess;
+        EXPECT_CALL(*secureElementMock_, OpenLogicalChannel(_, _)).WillOnce(Return(ByMove(std::move(resData))));
+        EXPECT_CALL(*secureElementMock_, Transmit(_))
+            .WillOnce(Return(RESPONSE_REFERESH_TAG_D0))
+            .WillOnce(Return(RESPONSE_ALL2));
+        accessControlEnforcer_->Initialize();
+
+        std::string bundleName = "IsNfcEventAllowed_Cached_Test";
+        std::shared_ptr<osal::BundleManager> bundleManager = std::make_shared<osal::BundleManager>();
+        std::shared_ptr<osal::BundleInfo> bundleInfo = std::make_shared<osal::BundleInfo>();
+        bundleInfo->mBundleName_ = bundleName;
+        bundleInfo->signatures_.push_back("1234567890");
+        bundleManager->SetBundleInfo(bundleName, bundleInfo);
+        accessControlEnforcer_->SetBundleManager(bundleManager);
+        std::string aid = {
+            (char)0xA0, 0x00, 0x00, 0x03, 0x33, 0x01, 0x01, 0x02, 0x00, 0x63, 0x48, 0x57, 0x50, 0x41, 0x59, 0x05};
+        std::vector<std::string> bundleNames;
+        bundleNames.push_back(bundleName);
+        EXPECT_TRUE(accessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames)[0]);
+
+        EXPECT_TRUE(accessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames)[0]);
+
+        // the bundle reinstalled with another signature is decided again
+        std::shared_ptr<osal::BundleInfo> otherBundleInfo = std::make_shared<osal::BundleInfo>();
+        otherBundleInfo->mBundleName_ = bundleName;
+        otherBundleInfo->signatures_.push_back("0987654321");
+        bundleManager->SetBundleInfo(bundleName, otherBundleInfo);
+        EXPECT_FALSE(accessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames)[0]);
+
+        // the removed bundle is denied
+        bundleManager->SetBundleInfo(bundleName, nullptr);
+        EXPECT_THROW(accessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames), AccessControlError);
+
+        bundleManager->SetBundleInfo(bundleName, bundleInfo);
+        EXPECT_TRUE(accessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames)[0]);
+        accessControlEnforcer_->GetAccessRuleCache().lock()->ClearAccessRules();
+        EXPECT_FALSE(accessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames)[0]);
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+/**
+ * @tc.number    : ACCESS_CONTROL_ENFORCER_TEST_027
+ * @tc.name      : EstablishChannelAccessRuleForBundle_Cached_Test
+ * @tc.desc      : The channel access decisions are kept until the signatures, the bundle or the rules change
+ */
+TEST_F(AccessControlEnforcerTest, EstablishChannelAccessRuleForBundle_Cached_Test)
+{
+    try {
+        std::string apduSuccess = {(char)0x90, 0x00};
+        std::unique_ptr<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData> resData(
+            std::make_unique<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData>());
+        resData->status = SEStatus::SUCCESS;
+        resData->channelNumber = 1;
+        resData->resp = apduSuccess;
+        EXPECT_CALL(*secureElementMock_, OpenLogicalChannel(_, _)).WillOnce(Return(ByMove(std::move(resData))));
+        EXPECT_CALL(*secureElementMock_, Transmit(_))
+            .WillOnce(Return(RESPONSE_REFERESH_TAG_D0))
+            .WillOnce(Return(RESPONSE_ALL2));
+        accessControlEnforcer_->Initialize();
+
+        std::string bundleName = "EstablishChannelAccessRuleForBundle_Cached_Test";
+        std::shared_ptr<osal::BundleManager> bundleManager = std::make_shared<osal::BundleManager>();
+        std::shared_ptr<osal::BundleInfo> bundleInfo = std::make_shared<osal::BundleInfo>();
+        bundleInfo->mBundleName_ = bundleName;
+        bundleInfo->signatures_.push_back("1234567890");
+        bundleManager->SetBundleInfo(bundleName, bundleInfo);
+        accessControlEnforcer_->SetBundleManager(bundleManager);
+        std::string aid = {
+            (char)0xA0, 0x00, 0x00, 0x03, 0x33, 0x01, 0x01, 0x02, 0x00, 0x63, 0x48, 0x57, 0x50, 0x41, 0x59, 0x05};
+        std::shared_ptr<ChannelAccessRule> ca =
+            accessControlEnforcer_->EstablishChannelAccessRuleForBundle(aid, bundleName, false);
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::ALWAYS, ca->GetAccessRule());
+        ca->SetAccessRule(ChannelAccessRule::ACCESSRULE::NEVER, "");
+        ca = accessControlEnforcer_->EstablishChannelAccessRuleForBundle(aid, bundleName, false);
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::ALWAYS, ca->GetAccessRule());
+        EXPECT_EQ(bundleName, ca->GetBundleName());
+        ChannelAccessDecisionStats stats = accessControlEnforcer_->GetChannelAccessDecisionStats();
+        EXPECT_EQ(1u, stats.hits_);
+        EXPECT_EQ(1u, stats.misses_);
+        EXPECT_DOUBLE_EQ(0.5, stats.GetHitRate());
+
+        // the bundle is signed again
+        bundleInfo->signatures_[0] = "0987654321";
+        accessControlEnforcer_->EstablishChannelAccessRuleForBundle(aid, bundleName, false);
+        accessControlEnforcer_->OnBundleChanged(bundleName);
+        accessControlEnforcer_->EstablishChannelAccessRuleForBundle(aid, bundleName, false);
+        EXPECT_EQ(3u, accessControlEnforcer_->GetChannelAccessDecisionStats().misses_);
+
+        accessControlEnforcer_->GetAccessRuleCache().lock()->ClearAccessRules();
+        ca = accessControlEnforcer_->EstablishChannelAccessRuleForBundle(aid, bundleName, false);
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::NEVER, ca->GetAccessRule());
+        EXPECT_EQ(1u, accessControlEnforcer_->GetChannelAccessDecisionStats().hits_);
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+/**
+ * @tc.number    : ACCESS_CONTROL_ENFORCER_TEST_028
+ * @tc.name      : IsNfcEventAllowed_Batch_Test
+ * @tc.desc      : The signatures of the bundles are hashed in one batch
+ */
+TEST_F(AccessControlEnforcerTest, IsNfcEventAllowed_Batch_Test)
+{
+    try {
+        std::string apduSuccess = {(char)0x90, 0x00};
+        std::unique_ptr<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData> resData(
+            std::make_unique<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData>());
+        resData->status = SEStatus::SUCCESS;
+        resData->channelNumber = 1;
+        resData->resp = apduSuccess;
+        EXPECT_CALL(*secureElementMock_, OpenLogicalChannel(_, _)).WillOnce(Return(ByMove(std::move(resData))));
+        EXPECT_CALL(*secureElementMock_, Transmit(_))
+            .WillOnce(Return(RESPONSE_REFERESH_TAG_D0))
+            .WillOnce(Return(RESPONSE_ALL2));
+        accessControlEnforcer_->Initialize();
+
+        const size_t bundleCount = 8;
+        const size_t signatureSize = 8 * 1024;
+        std::shared_ptr<osal::BundleManager> bundleManager = std::make_shared<osal::BundleManager>();
+        std::vector<std::string> bundleNames;
+        for (size_t i = 0; i < bundleCount; i++) {
+            std::string bundleName = "IsNfcEventAllowed_Batch_Test" + std::to_string(i);
+            std::shared_ptr<osal::BundleInfo> bundleInfo = std::make_shared<osal::BundleInfo>();
+            bundleInfo->mBundleName_ = bundleName;
+            bundleInfo->signatures_.push_back(std::string(signatureSize, static_cast<char>(i)));
+            bundleInfo->signatures_.push_back(std::string(signatureSize, static_cast<char>(i + bundleCount)));
+            bundleManager->SetBundleInfo(bundleName, bundleInfo);
+            bundleNames.push_back(bundleName);
+        }
+        accessControlEnforcer_->SetBundleManager(bundleManager);
+        std::string aid = {
+            (char)0xA0, 0x00, 0x00, 0x03, 0x33, 0x01, 0x01, 0x02, 0x00, 0x63, 0x48, 0x57, 0x50, 0x41, 0x59, 0x05};
+        std::vector<bool> nfcAlloweds = accessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames);
+        EXPECT_EQ(bundleCount, nfcAlloweds.size());
+        for (bool nfcAllowed : nfcAlloweds) {
+            EXPECT_TRUE(nfcAllowed);
+        }
+
+        // the removed bundle is looked up again
+        bundleManager->SetBundleInfo(bundleNames[0], nullptr);
+        accessControlEnforcer_->OnBundleChanged(bundleNames[0]);
+        EXPECT_THROW(accessControlEnforcer_->IsNfcEventAllowed(aid, bundleNames), AccessControlError);
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+/**
+ * @tc.number    : ACCESS_CONTROL_ENFORCER_TEST_029
+ * @tc.name      : RefreshTagCheck_Interval_Test
+ * @tc.desc      : The refresh tag is checked once per interval unless a check is requested
+ */
+TEST_F(AccessControlEnforcerTest, RefreshTagCheck_Interval_Test)
+{
+    try {
+        std::string apduSuccess = {(char)0x90, 0x00};
+        std::unique_ptr<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData> resData(
+            std::make_unique<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData>());
+        resData->status = SEStatus::SUCCESS;
+        resData->channelNumber = 1;
+        resData->resp = apduSuccess;
+        EXPECT_CALL(*secureElementMock_, OpenLogicalChannel(_, _)).WillOnce(Return(ByMove(std::move(resData))));
+        EXPECT_CALL(*secureElementMock_, Transmit(_))
+            .WillOnce(Return(RESPONSE_REFERESH_TAG_D0))
+            .WillOnce(Return(RESPONSE_ALL2));
+        EXPECT_TRUE(accessControlEnforcer_->IsRefreshTagCheckDue());
+        accessControlEnforcer_->Initialize();
+        // the refresh tag is read by the initialization
+        EXPECT_FALSE(accessControlEnforcer_->IsRefreshTagCheckDue());
+        accessControlEnforcer_->CheckRefreshTagIfDue();
+
+        accessControlEnforcer_->RequestRefreshTagCheck();
+        EXPECT_TRUE(accessControlEnforcer_->IsRefreshTagCheckDue());
+        accessControlEnforcer_->SetRefreshTagCheckInterval(0);
+        EXPECT_TRUE(accessControlEnforcer_->IsRefreshTagCheckDue());
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+class CountingAccessRuleCacheStore : public AccessRuleCacheStore {
+public:
+    CountingAccessRuleCacheStore() : AccessRuleCacheStore("") {}
+    std::string content_;
+    int writeCount_ = 0;
+
+protected:
+    bool ReadFile(std::string& content) override
+    {
+        content = content_;
+        return !content.empty();
+    }
+    bool WriteFile(const std::string& content) override
+    {
+        content_ = content;
+        ++writeCount_;
+        return true;
+    }
+};
+
+/**
+ * @tc.number    : ACCESS_CONTROL_ENFORCER_TEST_030
+ * @tc.name      : RefreshTagCheck_Store_Test
+ * @tc.desc      : The snapshot is written and the listener is notified when a refresh tag check re-reads the rules
+ */
+TEST_F(AccessControlEnforcerTest, RefreshTagCheck_Store_Test)
+{
+    try {
+        std::string apduSuccess = {(char)0x90, 0x00};
+        std::string responseRefreshTag = {
+            (char)0xDF, 0x20, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x09, (char)0x90, 0x00};
+        std::shared_ptr<CountingAccessRuleCacheStore> store = std::make_shared<CountingAccessRuleCacheStore>();
+        accessControlEnforcer_->SetAccessRuleCacheStore(store);
+        int rulesChangedCount = 0;
+        accessControlEnforcer_->SetRulesChangedListener([&rulesChangedCount]() { ++rulesChangedCount; });
+        EXPECT_CALL(*secureElementMock_, OpenLogicalChannel(_, _))
+            .Times(3)
+            .WillRepeatedly(Invoke([&apduSuccess](const std::string&, char) {
+                std::unique_ptr<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData> resData(
+                    std::make_unique<OHOS::hardware::se::v1_0::ISecureElement::LogicalRespData>());
+                resData->status = SEStatus::SUCCESS;
+                resData->channelNumber = 1;
+                resData->resp = apduSuccess;
+                return resData;
+            }));
+        EXPECT_CALL(*secureElementMock_, Transmit(_))
+            .WillOnce(Return(RESPONSE_REFERESH_TAG_D0))
+            .WillOnce(Return(RESPONSE_ALL2))
+            .WillOnce(Return(responseRefreshTag))
+            .WillOnce(Return(RESPONSE_ALL2))
+            .WillOnce(Return(responseRefreshTag));
+        accessControlEnforcer_->Initialize();
+        EXPECT_EQ(1, store->writeCount_);
+        EXPECT_EQ(1, rulesChangedCount);
+
+        // the rules on the SE changed
+        accessControlEnforcer_->RequestRefreshTagCheck();
+        accessControlEnforcer_->CheckRefreshTagIfDue();
+        EXPECT_EQ(2, store->writeCount_);
+        EXPECT_EQ(2, rulesChangedCount);
+        std::shared_ptr<AccessRuleCache> restored = std::make_shared<AccessRuleCache>();
+        EXPECT_TRUE(store->Load(*restored));
+        EXPECT_TRUE(restored->CompareRefreshTag(responseRefreshTag.substr(3, 8)));
+
+        // unchanged, nothing is written
+        accessControlEnforcer_->RequestRefreshTagCheck();
+        accessControlEnforcer_->CheckRefreshTagIfDue();
+        EXPECT_EQ(2, store->writeCount_);
+        EXPECT_EQ(2, rulesChangedCount);
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+}  // namespace OHOS::se::test
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "access_rule_cache_store.h"
 #include "access_rule_data_common.h"
 #include "channel_access_rule.h"
 #include "general-data-objects/ar_do.h"
@@ -551,4 +552,130 @@ TEST_F(AccessRuleCacheTest, ClearAccessRules_Test)
         EXPECT_TRUE(false);
     }
 }
-}  // namespace OHOS::se::test
\ No newline at end of file
+
+class AccessRuleCacheStoreMock : public AccessRuleCacheStore {
+public:
+    AccessRuleCacheStoreMock() : AccessRuleCacheStore("") {}
+    std::string content_;
+
+protected:
+    bool ReadFile(std::string& content) override
+    {
+        content = content_;
+        return !content.empty();
+    }
+    bool WriteFile(const std::string& content) override
+    {
+        content_ = content;
+        return true;
+    }
+};
+
+static void AddAccessRule(std::shared_ptr<AccessRuleCache> accessRuleCache, std::string refData, std::string arData)
+{
+    std::shared_ptr<RefDo> refDo = RefDo::BerTlvToRefDo(BerTlv::StrToBerTlv(refData));
+    std::shared_ptr<ArDo> arDo = ArDo::BerTlvToArDo(BerTlv::StrToBerTlv(arData));
+    accessRuleCache->AddAccessRule(refDo, arDo);
+}
+
+/**
+ * @tc.number    : ACCESS_RULE_CACHE_TEST_018
+ * @tc.name      : Serialize_Test
+ * @tc.desc      : The merged rules and the refresh tag are restored from the snapshot
+ */
+TEST_F(AccessRuleCacheTest, Serialize_Test)
+{
+    try {
+        std::shared_ptr<AccessRuleCache> accessRuleCache = std::make_shared<AccessRuleCache>();
+        AddAccessRule(accessRuleCache, REF_DO_A1_H1, AR_DO_DATA_APDU_FILTER);
+        AddAccessRule(accessRuleCache, REF_DO_A1_H1, AR_DO_DATA_APDU_FILTER_2);
+        AddAccessRule(accessRuleCache, REF_DO_AID_ALL_HASH_ALL, AR_DO_DATA_11);
+        accessRuleCache->SetRefreshTag(RESPONSE_REFRESH_TAG);
+        std::string snapshot = accessRuleCache->Serialize();
+
+        std::shared_ptr<AccessRuleCache> restored = std::make_shared<AccessRuleCache>();
+        uint64_t generation = restored->GetGeneration();
+        EXPECT_TRUE(restored->Deserialize(snapshot));
+        EXPECT_NE(generation, restored->GetGeneration());
+        EXPECT_TRUE(restored->CompareRefreshTag(RESPONSE_REFRESH_TAG));
+        EXPECT_EQ(snapshot, restored->Serialize());
+
+        std::vector<std::string> hashes;
+        hashes.push_back(HASH_1);
+        ChannelAccessRule channelAccessRule = restored->GetAccessRule(AID_1, hashes);
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::ALWAYS, channelAccessRule.GetAccessRule());
+        EXPECT_TRUE(channelAccessRule.HasApduFilter());
+        EXPECT_EQ(2U, channelAccessRule.GetApduFilters().size());
+        ChannelAccessRule other = restored->GetAccessRule(AID_3, {HASH_3});
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::ALWAYS, other.GetApduAccessRule());
+
+        // nothing of a malformed snapshot is kept
+        snapshot.resize(snapshot.size() - 1);
+        EXPECT_FALSE(restored->Deserialize(snapshot));
+        EXPECT_FALSE(restored->CompareRefreshTag(RESPONSE_REFRESH_TAG));
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::NEVER, restored->GetAccessRule(AID_1, hashes).GetAccessRule());
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+/**
+ * @tc.number    : ACCESS_RULE_CACHE_TEST_019
+ * @tc.name      : AccessRuleCacheStore_Test
+ * @tc.desc      : Store and load the snapshot of the access rules
+ */
+TEST_F(AccessRuleCacheTest, AccessRuleCacheStore_Test)
+{
+    try {
+        AccessRuleCacheStoreMock store;
+        std::shared_ptr<AccessRuleCache> accessRuleCache = std::make_shared<AccessRuleCache>();
+        EXPECT_FALSE(store.Load(*accessRuleCache));
+
+        AddAccessRule(accessRuleCache, REF_DO_A1_H1, AR_DO_DATA_11);
+        accessRuleCache->SetRefreshTag(RESPONSE_REFRESH_TAG);
+        EXPECT_TRUE(store.Store(*accessRuleCache));
+
+        std::shared_ptr<AccessRuleCache> restored = std::make_shared<AccessRuleCache>();
+        EXPECT_TRUE(store.Load(*restored));
+        EXPECT_TRUE(restored->CompareRefreshTag(RESPONSE_REFRESH_TAG));
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::ALWAYS, restored->GetAccessRule(AID_1, {HASH_1}).GetAccessRule());
+
+        store.content_ = "garbage";
+        EXPECT_FALSE(store.Load(*restored));
+        EXPECT_TRUE(restored->GetRefreshTag().empty());
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+/**
+ * @tc.number    : ACCESS_RULE_CACHE_TEST_020
+ * @tc.name      : GetAccessRule_Index_Test
+ * @tc.desc      : The rules added after a lookup are found and the specific rules keep priority
+ */
+TEST_F(AccessRuleCacheTest, GetAccessRule_Index_Test)
+{
+    try {
+        std::shared_ptr<AccessRuleCache> accessRuleCache = std::make_shared<AccessRuleCache>();
+        AddAccessRule(accessRuleCache, REF_DO_A1_H1, AR_DO_DATA_11);
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::ALWAYS,
+                  accessRuleCache->GetAccessRule(AID_1, {HASH_3, HASH_1}).GetAccessRule());
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::NEVER, accessRuleCache->GetAccessRule(AID_1, {HASH_3}).GetAccessRule());
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::NEVER, accessRuleCache->GetAccessRule(AID_3, {HASH_3}).GetAccessRule());
+
+        AddAccessRule(accessRuleCache, REF_DO_AID_ALL_HASH_ALL, AR_DO_DATA_11);
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::ALWAYS, accessRuleCache->GetAccessRule(AID_3, {HASH_3}).GetAccessRule());
+        ChannelAccessRule channelAccessRule = accessRuleCache->GetAccessRule(AID_1, {HASH_3});
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::NEVER, channelAccessRule.GetAccessRule());
+        EXPECT_EQ("Specific rules have priority.", channelAccessRule.GetReason());
+
+        accessRuleCache->ClearAccessRules();
+        EXPECT_EQ(ChannelAccessRule::ACCESSRULE::NEVER, accessRuleCache->GetAccessRule(AID_3, {HASH_3}).GetAccessRule());
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+}  // namespace OHOS::se::test
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "apdu_filter_set.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace OHOS::se::security;
+
+namespace OHOS::se::test {
+class ApduFilterSetBenchmarkTest : public ::testing::Test {
+public:
+    virtual void SetUp() override
+    {
+        std::cout << " ApduFilterSetBenchmarkTest set up." << std::endl;
+    }
+
+    virtual void TearDown() override
+    {
+        std::cout << " ApduFilterSetBenchmarkTest tear down." << std::endl;
+    }
+
+    // CLA 0x80, INS and P1 of the index, any P2
+    static std::vector<std::string> MakeFilters(size_t count)
+    {
+        std::vector<std::string> apduFilters;
+        for (size_t i = 0; i < count; i++) {
+            apduFilters.push_back({(char)0x80, (char)(i & 0xFF), (char)((i >> 8) & 0xFF), 0x00,
+                                   (char)0xFF, (char)0xFF, (char)0xFF, 0x00});
+        }
+        return apduFilters;
+    }
+
+    // the byte by byte matching of the filters before they were compiled
+    static bool MatchesFilterStrings(const std::vector<std::string>& apduFilters, const std::string& command)
+    {
+        for (std::string apduFilter : apduFilters) {
+            if ((((command[0] & 0xFF) & (apduFilter[4] & 0xFF)) == (apduFilter[0] & 0xFF)) &&
+                (((command[1] & 0xFF) & (apduFilter[5] & 0xFF)) == (apduFilter[1] & 0xFF)) &&
+                (((command[2] & 0xFF) & (apduFilter[6] & 0xFF)) == (apduFilter[2] & 0xFF)) &&
+                (((command[3] & 0xFF) & (apduFilter[7] & 0xFF)) == (apduFilter[3] & 0xFF))) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @tc.number    : APDU_FILTER_SET_BENCHMARK_TEST_001
+ * @tc.name      : Match_Test
+ * @tc.desc      : Match commands against 1 to 256 filters, compiled and as filter strings
+ */
+TEST_F(ApduFilterSetBenchmarkTest, Match_Test)
+{
+    try {
+        const size_t rounds = 20000;
+        for (size_t count = 1; count <= 256; count *= 4) {
+            std::vector<std::string> apduFilters = MakeFilters(count);
+            ApduFilterSet apduFilterSet(apduFilters);
+            // the last filter matches, the other command matches none
+            std::string lastCommand = {(char)0x80, (char)((count - 1) & 0xFF), (char)(((count - 1) >> 8) & 0xFF),
+                                       0x00, 0x00};
+            std::string missCommand = {(char)0x84, 0x00, 0x00, 0x00, 0x00};
+            size_t matched = 0;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < rounds; i++) {
+                matched += MatchesFilterStrings(apduFilters, lastCommand) ? 1 : 0;
+                matched += MatchesFilterStrings(apduFilters, missCommand) ? 1 : 0;
+            }
+            long long stringsNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < rounds; i++) {
+                matched += apduFilterSet.Matches(lastCommand) ? 1 : 0;
+                matched += apduFilterSet.Matches(missCommand) ? 1 : 0;
+            }
+            long long compiledNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            EXPECT_EQ(2 * rounds, matched);
+            printf("filters: %zu, strings: %lld ns/apdu, compiled: %lld ns/apdu\n", count,
+                   stringsNs / static_cast<long long>(2 * rounds), compiledNs / static_cast<long long>(2 * rounds));
+        }
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+}  // namespace OHOS::se::test
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "apdu_filter_set.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace OHOS::se::security;
+
+namespace OHOS::se::test {
+class ApduFilterSetTest : public ::testing::Test {
+public:
+    virtual void SetUp() override
+    {
+        std::cout << " ApduFilterSetTest set up." << std::endl;
+    }
+
+    virtual void TearDown() override
+    {
+        std::cout << " ApduFilterSetTest tear down." << std::endl;
+    }
+};
+
+/**
+ * @tc.number    : APDU_FILTER_SET_TEST_001
+ * @tc.name      : Matches_Test
+ * @tc.desc      : Match the command header with the masked filters
+ */
+TEST_F(ApduFilterSetTest, Matches_Test)
+{
+    try {
+        std::vector<std::string> apduFilters;
+        apduFilters.push_back({(char)0x80, (char)0xCA, 0x00, 0x00, (char)0xFF, (char)0xFF, 0x00, 0x00});
+        apduFilters.push_back({0x00, (char)0xA4, 0x04, 0x00, (char)0xFF, (char)0xFF, (char)0xFF, (char)0xFF});
+        ApduFilterSet apduFilterSet(apduFilters);
+        EXPECT_EQ(2u, apduFilterSet.GetSize());
+        EXPECT_TRUE(apduFilterSet.Matches({(char)0x80, (char)0xCA, (char)0x9F, 0x7F, 0x00}));
+        EXPECT_TRUE(apduFilterSet.Matches({0x00, (char)0xA4, 0x04, 0x00, 0x02, 0x11, 0x22}));
+        EXPECT_FALSE(apduFilterSet.Matches({0x00, (char)0xA4, 0x04, 0x0C, 0x00}));
+        EXPECT_FALSE(apduFilterSet.Matches({(char)0x80, (char)0xCA, 0x00}));
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+/**
+ * @tc.number    : APDU_FILTER_SET_TEST_002
+ * @tc.name      : Invalid_Filter_Test
+ * @tc.desc      : Filters of a wrong length or with bits outside of the mask never match
+ */
+TEST_F(ApduFilterSetTest, Invalid_Filter_Test)
+{
+    try {
+        std::vector<std::string> apduFilters;
+        apduFilters.push_back({(char)0x80, (char)0xCA, 0x00, 0x00, (char)0xFF, (char)0xFF, 0x00});
+        apduFilters.push_back({(char)0x80, (char)0xCA, 0x01, 0x00, (char)0xFF, (char)0xFF, 0x00, 0x00});
+        apduFilters.push_back({(char)0x80, (char)0xCA, 0x00, 0x00, (char)0xFF, (char)0xFF, 0x00, 0x00});
+        apduFilters.push_back({(char)0x80, (char)0xCA, 0x00, 0x00, (char)0xFF, (char)0xFF, 0x00, 0x00});
+        ApduFilterSet apduFilterSet(apduFilters);
+        EXPECT_EQ(1u, apduFilterSet.GetSize());
+        EXPECT_FALSE(ApduFilterSet(std::vector<std::string>()).Matches({(char)0x80, (char)0xCA, 0x00, 0x00}));
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+}  // namespace OHOS::se::test
@@ -319,4 +319,33 @@ TEST_F(AraTest, GetRefreshTag_NextErrorResponse_Test)
         EXPECT_TRUE(true);
     }
 }
+
+/**
+ * @tc.number    : ARA_TEST_012
+ * @tc.name      : GetAllAccessRules_NextEmptyResponse_Test
+ * @tc.desc      : Get all access rules with no data when GET DATA [Next]
+ */
+TEST_F(AraTest, GetAllAccessRules_NextEmptyResponse_Test)
+{
+    try {
+        EXPECT_CALL(*secureElementMock_, Transmit(_))
+            .Times(AnyNumber())
+            .WillOnce(Return(RESPONSE_ALL_FOR_NEXT))
+            .WillRepeatedly(Return(std::string({(char)0x90, 0x00})));
+
+        std::shared_ptr<OHOS::se::SeChannel> channel = std::make_shared<OHOS::se::SeChannel>(terminal_, 1, "", "");
+        std::shared_ptr<ChannelAccessRule> channelAccess = std::make_shared<ChannelAccessRule>();
+        channelAccess->SetAccessRule(ChannelAccessRule::ACCESSRULE::ALWAYS, "");
+        channelAccess->SetApduAccessRule(ChannelAccessRule::ACCESSRULE::ALWAYS);
+        channelAccess->SetNFCEventAccessRule(ChannelAccessRule::ACCESSRULE::ALWAYS);
+        channelAccess->SetPrivilegeAccessRule(ChannelAccessRule::ACCESSRULE::ALWAYS);
+        channel->SetChannelAccess(channelAccess);
+
+        std::vector<RefArDo> radList = accessRuleApplicationController_->GetAllAccessRules(channel);
+        EXPECT_TRUE(false);
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(true);
+    }
+}
 }  // namespace OHOS::se::test
\ No newline at end of file
@@ -18,6 +18,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <unistd.h>
+
 #include <memory>
 
 #include "context.h"
@@ -194,6 +196,18 @@ TEST_F(SecureElementServiceTest, IsNfcEventAllowed_Test)
         EXPECT_TRUE(false);
     }
 }
+TEST_F(SecureElementServiceTest, Dump_Test)
+{
+    int fds[2] = {-1, -1};
+    ASSERT_EQ(pipe(fds), 0);
+    EXPECT_EQ(seService_->Dump(fds[1], {}), ERR_NONE);
+    close(fds[1]);
+    char buf[512] = {0};
+    ssize_t len = read(fds[0], buf, sizeof(buf) - 1);
+    close(fds[0]);
+    ASSERT_GT(len, 0);
+    EXPECT_NE(std::string(buf).find(ESE_READER), std::string::npos);
+}
 }  // namespace test
 }  // namespace se
 }  // namespace OHOS
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -128,6 +129,7 @@ TEST(TerminalTest1, Initialize_Test_2)
     BaseTest::SetSeInitializeCall(false, seMock);
     terminal->Initialize(seMock);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(terminal->WaitForAccessControl());
     EXPECT_FALSE(terminal->GetAccessControlEnforcer().expired());
 
     terminal->CloseChannels();
@@ -591,6 +593,8 @@ TEST(TerminalTest1, Transmit_Test)
     // add eSE1==
     terminal->Initialize(seMock);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // the access control is initialized in the background
+    EXPECT_TRUE(terminal->WaitForAccessControl());
 
     std::string response{};
     EXPECT_CALL(*seMock, Transmit(_)).WillRepeatedly(Return(response));
@@ -694,6 +698,8 @@ TEST(TerminalTest1, GetAtr_Test)
     // add eSE1==
     terminal->Initialize(seMock);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // the access control is initialized in the background
+    EXPECT_TRUE(terminal->WaitForAccessControl());
 
     std::string response{0x00, 0x00, (char)0x90, 0x00};
     EXPECT_CALL(*seMock, GetAtr()).WillRepeatedly(Return(response));
@@ -751,6 +757,8 @@ TEST(TerminalTest1, IsAidSelectable_Test)
     // add eSE1==
     terminal->Initialize(seMock);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // the access control is initialized in the background
+    EXPECT_TRUE(terminal->WaitForAccessControl());
 
     try {
         EXPECT_TRUE(terminal->IsAidSelectable(aid));
@@ -796,6 +804,8 @@ TEST(TerminalTest1, SelectDefaultApplication_Test)
     // add eSE1==
     terminal->Initialize(seMock);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // the access control is initialized in the background
+    EXPECT_TRUE(terminal->WaitForAccessControl());
 
     std::string response{};
     EXPECT_CALL(*seMock, Transmit(_)).WillRepeatedly(Return(response));
@@ -871,6 +881,8 @@ TEST(TerminalTest1, CheckCarrierPrivilegeRules_Test)
     // add eSE1==
     terminal->Initialize(seMock);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // the access control is initialized in the background
+    EXPECT_TRUE(terminal->WaitForAccessControl());
 
     respData = std::make_unique<SELogicalRespData>();
     respData->status = SEStatus::SUCCESS;
@@ -949,6 +961,8 @@ TEST(TerminalTest1, IsNfcEventAllowed_Test)
     // add eSE1==
     terminal->Initialize(seMock);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    // the access control is initialized in the background
+    EXPECT_TRUE(terminal->WaitForAccessControl());
 
     std::string response{};
     // // response data status is error (0x9000)
@@ -1112,6 +1126,46 @@ TEST(TerminalTest1, CloseChannels_Test)
         EXPECT_TRUE(false);
     }
 }
+TEST(TerminalTest1, CheckRefreshTag_Test)
+{
+    std::shared_ptr<Context> context = std::make_shared<Context>();
+    sptr<ISecureElementMock> seMock = BaseTest::LoadSecureElement(true);
+    EXPECT_CALL(*seMock, OpenLogicalChannel(_, _)).WillRepeatedly(Invoke([](const std::string&, char) {
+        std::unique_ptr<SELogicalRespData> respData = std::make_unique<SELogicalRespData>();
+        respData->status = SEStatus::SUCCESS;
+        respData->channelNumber = 1;
+        respData->resp = {0x09, 0x00};
+        return respData;
+    }));
+    std::shared_ptr<Terminal> terminal = std::make_shared<Terminal>(SIM_READER, context);
+    terminal->Initialize(seMock);
+    EXPECT_TRUE(terminal->WaitForAccessControl());
+    std::shared_ptr<AccessControlEnforcer> accessControlEnforcer = terminal->GetAccessControlEnforcer().lock();
+    ASSERT_TRUE(accessControlEnforcer != nullptr);
+
+    // the channels of the applications are opened while the ARA-M is read
+    Terminal* rawTerminal = terminal.get();
+    std::atomic<int> lockedExchanges{0};
+    EXPECT_CALL(*seMock, Transmit(_)).WillRepeatedly(Invoke([rawTerminal, &lockedExchanges](const std::string&) {
+        std::thread([rawTerminal, &lockedExchanges]() {
+            if (rawTerminal->mLock_.try_lock()) {
+                rawTerminal->mLock_.unlock();
+            } else {
+                lockedExchanges++;
+            }
+        }).join();
+        return RESPONSE_REFERESH_TAG_D0;
+    }));
+    try {
+        accessControlEnforcer->RequestRefreshTagCheck();
+        terminal->CheckRefreshTag();
+        EXPECT_EQ(lockedExchanges, 0);
+    } catch (const std::exception& e) {
+        InfoLog("exception: %s", e.what());
+        EXPECT_TRUE(false);
+    }
+    Mock::VerifyAndClearExpectations(seMock.GetRefPtr());
+}
 }  // namespace test
 }  // namespace se
 }  // namespace OHOS
\ No newline at end of file
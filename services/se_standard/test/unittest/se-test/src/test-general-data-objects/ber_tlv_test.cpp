@@ -215,4 +215,56 @@ TEST_F(BerTlvTest, Data_Length_Over_flow_Test)
         EXPECT_TRUE(true);
     }
 }
+
+/**
+ * @tc.number    : BER_TLV_TEST_010
+ * @tc.name      : Reader_Test
+ * @tc.desc      : Walk nested ber-tlvs in place
+ */
+TEST_F(BerTlvTest, Reader_Test)
+{
+    try {
+        // E2 { E1 { 4F 00 }, E3 { D1 01 01 } }, 5F 01 01 00
+        std::string data = {(char)0xE2, 0x09, (char)0xE1, 0x02, 0x4F, 0x00, (char)0xE3, 0x03, (char)0xD1, 0x01, 0x01,
+                            0x5F, 0x01, 0x01, 0x00};
+        BerTlvReader reader(data);
+        BerTlvReader::Tlv tlv = reader.Next();
+        EXPECT_EQ(0xE2, tlv.tag_);
+        EXPECT_EQ(9, tlv.length_);
+        EXPECT_EQ(data.substr(0, 11), reader.GetData(tlv));
+
+        BerTlvReader children = reader.GetChildren(tlv);
+        EXPECT_EQ(0xE1, children.Next().tag_);
+        BerTlvReader::Tlv child = children.Next();
+        EXPECT_EQ(0xE3, child.tag_);
+        EXPECT_EQ(std::string({(char)0xD1, 0x01, 0x01}), children.GetValue(child));
+        EXPECT_TRUE(children.IsEnd());
+
+        std::shared_ptr<BerTlv> berTlv = reader.ToBerTlv(reader.Next());
+        EXPECT_EQ(0x5F01, berTlv->GetTag());
+        EXPECT_EQ(std::string(1, 0x00), berTlv->GetValue());
+        EXPECT_TRUE(reader.IsEnd());
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+/**
+ * @tc.number    : BER_TLV_TEST_011
+ * @tc.name      : Reader_Value_Not_Enough_Test
+ * @tc.desc      : Walk a ber-tlv whose value is not complete
+ */
+TEST_F(BerTlvTest, Reader_Value_Not_Enough_Test)
+{
+    try {
+        std::string data = {(char)0xE2, 0x04, (char)0xE1, 0x02, 0x4F};
+        BerTlvReader reader(data);
+        BerTlvReader::Tlv tlv = reader.Next();
+        EXPECT_TRUE(false);
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(true);
+    }
+}
 }  // namespace OHOS::se::test
\ No newline at end of file
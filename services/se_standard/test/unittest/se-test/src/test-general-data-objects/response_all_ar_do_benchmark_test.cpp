@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "general-data-objects/response_all_ar_do.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "../access_rule_data_common.h"
+#include "general-data-objects/aid_ref_do.h"
+#include "general-data-objects/ber_tlv.h"
+#include "general-data-objects/hash_ref_do.h"
+#include "general-data-objects/ref_ar_do.h"
+#include "general-data-objects/ref_do.h"
+
+using namespace OHOS::se::security;
+
+namespace OHOS::se::test {
+class ResponseAllArDoBenchmarkTest : public ::testing::Test {
+public:
+    virtual void SetUp() override
+    {
+        std::cout << " ResponseAllArDoBenchmarkTest set up." << std::endl;
+    }
+
+    virtual void TearDown() override
+    {
+        std::cout << " ResponseAllArDoBenchmarkTest tear down." << std::endl;
+    }
+
+public:
+};
+
+/**
+ * @tc.number    : RESPONSE_ALL_AR_DO_BENCHMARK_TEST_001
+ * @tc.name      : Parse_Test
+ * @tc.desc      : Parse response-all-ar-do with 1k to 4k ref-ar-dos
+ */
+TEST_F(ResponseAllArDoBenchmarkTest, Parse_Test)
+{
+    try {
+        for (int count = 1024; count <= 4096; count *= 2) {
+            std::string refArDos;
+            for (int i = 0; i < count; i++) {
+                std::string aid = {(char)0xA0, 0x00, 0x00, 0x01, (char)((i >> 8) & 0xFF), (char)(i & 0xFF)};
+                std::string hash(20, (char)(i & 0xFF));
+                std::string refDo = BerTlv(RefDo::REF_DO_TAG, 30,
+                                           BerTlv(AidRefDo::AID_REF_DO_TAG, aid.length(), aid).GetData() +
+                                               BerTlv(HashRefDo::HASH_REF_DO_TAG, hash.length(), hash).GetData())
+                                        .GetData();
+                refArDos += BerTlv(RefArDo::REF_AR_DO_TAG, refDo.length() + AR_DO_DATA_11.length(),
+                                   refDo + AR_DO_DATA_11).GetData();
+            }
+            std::string data = BerTlv(ResponseAllArDo::RESPONSE_ALL_AR_DO_TAG, refArDos.length(), refArDos).GetData();
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            std::shared_ptr<BerTlv> bt = BerTlv::StrToBerTlv(data);
+            std::shared_ptr<ResponseAllArDo> raad = ResponseAllArDo::BerTlvToResponseAllArDo(bt);
+            long long parseUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            EXPECT_EQ((size_t)count, raad->GetRefArDoArray().size());
+            printf("ref-ar-dos: %d, bytes: %zu, parse: %lld us, %lld ns/ref-ar-do\n", count, data.length(), parseUs,
+                   parseUs * 1000 / count);
+        }
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+}  // namespace OHOS::se::test
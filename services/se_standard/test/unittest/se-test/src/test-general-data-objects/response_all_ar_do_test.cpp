@@ -586,4 +586,50 @@ TEST_F(ResponseAllArDoTest, Data_Not_Enough_Test)
         EXPECT_TRUE(true);
     }
 }
+
+/**
+ * @tc.number    : RESPONSE_ALL_AR_DO_TEST_014
+ * @tc.name      : Assembler_Test
+ * @tc.desc      : Assemble response-all-ar-do from responses of any size
+ */
+TEST_F(ResponseAllArDoTest, Assembler_Test)
+{
+    try {
+        // without the status words
+        std::string data = RESPONSE_ALL_FOR_NEXT.substr(0, RESPONSE_ALL_FOR_NEXT.length() - 2) +
+                           RESPONSE_NEXT.substr(0, RESPONSE_NEXT.length() - 2);
+        std::vector<size_t> sizes = {4, 5, 13, 64, data.length()};
+        for (size_t size : sizes) {
+            ResponseAllArDoAssembler assembler;
+            for (size_t offset = 0; offset < data.length(); offset += size) {
+                EXPECT_FALSE(assembler.IsComplete());
+                assembler.Append(data.substr(offset, size));
+            }
+            EXPECT_TRUE(assembler.IsComplete());
+            EXPECT_EQ(6U, assembler.GetRefArDoArray().size());
+        }
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
+
+/**
+ * @tc.number    : RESPONSE_ALL_AR_DO_TEST_015
+ * @tc.name      : Assembler_Not_Complete_Test
+ * @tc.desc      : Get the ref-ar-dos of a response-all-ar-do not complete
+ */
+TEST_F(ResponseAllArDoTest, Assembler_Not_Complete_Test)
+{
+    try {
+        ResponseAllArDoAssembler assembler;
+        assembler.Append(RESPONSE_ALL_FOR_NEXT.substr(0, RESPONSE_ALL_FOR_NEXT.length() - 2));
+        EXPECT_FALSE(assembler.IsComplete());
+        assembler.GetRefArDoArray();
+        EXPECT_TRUE(false);
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(true);
+    }
+}
 }  // namespace OHOS::se::test
\ No newline at end of file
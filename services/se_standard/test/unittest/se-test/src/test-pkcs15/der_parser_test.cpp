@@ -192,4 +192,33 @@ TEST_F(DerParserTest, Get_Tlv_Size_Is_End_Test)
         EXPECT_TRUE(true);
     }
 }
+
+/**
+ * @tc.number    : DER_PARSER_TEST_009
+ * @tc.name      : Position_Test
+ * @tc.desc      : Come back to a position of the parser
+ */
+TEST_F(DerParserTest, Position_Test)
+{
+    try {
+        std::string data = {0x30, 0x03, 0x04, 0x01, 0x01, 0x04, 0x00};
+        DerParser der(data);
+        der.ParseTlv(DerParser::ASN1_SEQUENCE);
+        DerParser::Position position = der.GetPosition();
+        der.ParseTlv(DerParser::ASN1_OCTET_STRING);
+        EXPECT_EQ(std::string(1, 0x01), der.GetTlvData());
+        der.SetPosition(position);
+        der.SkipTlvData();
+        EXPECT_EQ(0, der.ParseTlv(DerParser::ASN1_OCTET_STRING));
+        EXPECT_TRUE(der.IsEnd());
+
+        position.index_ = data.length() + 1;
+        der.SetPosition(position);
+        EXPECT_TRUE(false);
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        // out of index
+        EXPECT_TRUE(true);
+    }
+}
 }  // namespace OHOS::se::test
\ No newline at end of file
@@ -352,4 +352,25 @@ TEST_F(EfTest, Read_Data_Illegal_File_Structure_Test)
         EXPECT_TRUE(true);
     }
 }
+
+/**
+ * @tc.number    : EF_TEST_018
+ * @tc.name      : Extended_Length_Atr_Test
+ * @tc.desc      : Find the extended length capability in the historical bytes of the ATR
+ */
+TEST_F(EfTest, Extended_Length_Atr_Test)
+{
+    try {
+        // T=0 and T=1 announced, card capabilities 00 00 40 and the TCK
+        std::string atr = {0x3B, (char)0x85, (char)0x80, 0x01, (char)0x80, 0x73, 0x00, 0x00, 0x40, 0x00};
+        EXPECT_TRUE(AccessRuleFilesChannel::IsExtendedLengthSupportedByAtr(atr));
+        atr[8] = 0x00;
+        EXPECT_FALSE(AccessRuleFilesChannel::IsExtendedLengthSupportedByAtr(atr));
+        EXPECT_FALSE(AccessRuleFilesChannel::IsExtendedLengthSupportedByAtr({0x3B, (char)0x85, (char)0x80}));
+        EXPECT_FALSE(AccessRuleFilesChannel::IsExtendedLengthSupportedByAtr(""));
+    } catch (std::exception& e) {
+        printf("Error: %s\n", e.what());
+        EXPECT_TRUE(false);
+    }
+}
 }  // namespace OHOS::se::test
\ No newline at end of file